@@ -212,6 +212,42 @@ namespace CPS {
 			this->appendDependencies(&deps);
 			return deps;
 		}
+
+		/**
+		 * Pointer to the value of this attribute viewed as consecutive Reals: one Real for Real, real and imaginary part for Complex
+		 * and all coefficients in column-major order for Matrix and MatrixComp. Evaluates the attribute like `get`.
+		 * The pointer stays valid until the storage of the attribute is replaced or resized.
+		 * @param size Set to the number of Reals behind the returned pointer
+		 * @return nullptr if the value cannot be viewed as Reals
+		 * */
+		virtual const Real* realData(Int &size) = 0;
+
+		/**
+		 * Position of the coefficient (row, column) in `realData`. Real and Complex values only have the coefficient (0, 0).
+		 * */
+		virtual Int realOffset(Int row, Int column) = 0;
+
+		/**
+		 * Find the attribute whose storage holds the value of this attribute, so that the value can be read without running update tasks.
+		 * Attributes derived as a coefficient, real part or imaginary part resolve to the storage of the attribute they were derived from.
+		 * The result is only valid as long as `structureVersion` does not change.
+		 * @return null if the value is computed by a getter and cannot be read directly
+		 * */
+		virtual AttributePointer<AttributeBase> resolveStorage() = 0;
+
+		/**
+		 * Position of the value of this attribute in `realData` of the attribute returned by `resolveStorage`.
+		 * */
+		virtual Int storageOffset() = 0;
+
+		/**
+		 * Counter that changes whenever update tasks of any dynamic attribute are added or removed, e.g. by `setReference`.
+		 * */
+		static UInt structureVersion();
+
+	protected:
+		/// Invalidate all resolutions obtained by `resolveStorage`
+		static void structureChanged();
 	};
 
 	/**
@@ -310,6 +346,37 @@ namespace CPS {
 		 * */
 		virtual std::shared_ptr<T> asRawPointer() = 0;
 
+		const Real* realData(Int &size) override {
+			if constexpr (std::is_same_v<T, Real>) {
+				size = 1;
+				return &this->get();
+			} else if constexpr (std::is_same_v<T, Complex>) {
+				size = 2;
+				return reinterpret_cast<const Real*>(&this->get());
+			} else if constexpr (std::is_same_v<T, Matrix>) {
+				const Matrix &value = this->get();
+				size = static_cast<Int>(value.size());
+				return value.data();
+			} else if constexpr (std::is_same_v<T, MatrixComp>) {
+				const MatrixComp &value = this->get();
+				size = 2 * static_cast<Int>(value.size());
+				return reinterpret_cast<const Real*>(value.data());
+			} else {
+				size = 0;
+				return nullptr;
+			}
+		}
+
+		Int realOffset(Int row, Int column) override {
+			if constexpr (std::is_same_v<T, Matrix>) {
+				return column * static_cast<Int>(this->get().rows()) + row;
+			} else if constexpr (std::is_same_v<T, MatrixComp>) {
+				return 2 * (column * static_cast<Int>(this->get().rows()) + row);
+			} else {
+				return 0;
+			}
+		}
+
 		/// Fallback method for all attribute types not covered by the specifications in Attribute.cpp
 		String toString() override {
 			std::stringstream ss;
@@ -390,6 +457,23 @@ namespace CPS {
 			return derivedAttribute;
 		}
 
+		/**
+		 * Derive an attribute that selects part of the value of `this` and record the selection, so that the derived attribute
+		 * can be resolved to the storage of `this` by `resolveStorage`.
+		 * @param row, column The selected coefficient of a matrix, (0, 0) otherwise
+		 * @param part 0 to select a whole coefficient or the real part of a complex coefficient, 1 to select the imaginary part
+		 * */
+		template <class U>
+		typename Attribute<U>::Ptr deriveSelection(
+			typename AttributeUpdateTask<U, T>::Actor getter,
+			typename AttributeUpdateTask<U, T>::Actor setter,
+			Int row, Int column, Int part)
+		{
+			auto derivedAttribute = std::static_pointer_cast<AttributeDynamic<U>>(derive<U>(getter, setter).getPtr());
+			derivedAttribute->setSelection(this->shared_from_this(), row, column, part);
+			return derivedAttribute;
+		}
+
 		/**
 		 * Convenience method for deriving the real part of a complex attribute
 		 * @return a new attribute whose value will always equal the real part of `this`
@@ -406,7 +490,7 @@ namespace CPS {
 				currentValue.real(*dependent);
 				dependency->set(currentValue);
 			};
-			return derive<CPS::Real>(getter, setter);
+			return deriveSelection<CPS::Real>(getter, setter, 0, 0, 0);
 		}
 
 		/**
@@ -425,7 +509,7 @@ namespace CPS {
 				currentValue.imag(*dependent);
 				dependency->set(currentValue);
 			};
-			return derive<CPS::Real>(getter, setter);
+			return deriveSelection<CPS::Real>(getter, setter, 0, 0, 1);
 		}
 
 
@@ -503,7 +587,7 @@ namespace CPS {
 				currentValue(row, column) = *dependent;
 				dependency->set(currentValue);
 			};
-			return derive<U>(getter, setter);
+			return deriveSelection<U>(getter, setter, static_cast<Int>(row), static_cast<Int>(column), 0);
 		}
 
 	};
@@ -545,6 +629,14 @@ namespace CPS {
 		virtual void appendDependencies(AttributeBase::Set *deps) override {
 			deps->insert(this->shared_from_this());
 		}
+
+		virtual AttributeBase::Ptr resolveStorage() override {
+			return this->shared_from_this();
+		}
+
+		virtual Int storageOffset() override {
+			return 0;
+		}
 	};
 
 	/**
@@ -561,6 +653,12 @@ namespace CPS {
 		std::vector<typename AttributeUpdateTaskBase<T>::Ptr> updateTasksOnGet;
 		std::vector<typename AttributeUpdateTaskBase<T>::Ptr> updateTasksOnSet;
 
+		/// Attribute this attribute selects a part of, set by `deriveSelection`
+		AttributeBase::Ptr mSelectionParent;
+		Int mSelectionRow = 0;
+		Int mSelectionColumn = 0;
+		Int mSelectionPart = 0;
+
 	public:
 		AttributeDynamic(T initialValue = T()) :
 			Attribute<T>(initialValue) { }
@@ -579,6 +677,7 @@ namespace CPS {
 					break;
 				case UpdateTaskKind::UPDATE_ON_GET:
 					updateTasksOnGet.push_back(task);
+					AttributeBase::structureChanged();
 					break;
 				case UpdateTaskKind::UPDATE_ON_SET:
 					updateTasksOnSet.push_back(task);
@@ -599,6 +698,8 @@ namespace CPS {
 					break;
 				case UpdateTaskKind::UPDATE_ON_GET:
 					updateTasksOnGet.clear();
+					mSelectionParent = nullptr;
+					AttributeBase::structureChanged();
 					break;
 				case UpdateTaskKind::UPDATE_ON_SET:
 					updateTasksOnSet.clear();
@@ -615,6 +716,34 @@ namespace CPS {
 			updateTasksOnce.clear();
 			updateTasksOnGet.clear();
 			updateTasksOnSet.clear();
+			mSelectionParent = nullptr;
+			AttributeBase::structureChanged();
+		}
+
+		/**
+		 * Record that the value of this attribute is a part of the value of `parent`. Only used for attributes whose getter copies
+		 * exactly this part, see `Attribute::deriveSelection`.
+		 * */
+		void setSelection(AttributeBase::Ptr parent, Int row, Int column, Int part) {
+			mSelectionParent = parent;
+			mSelectionRow = row;
+			mSelectionColumn = column;
+			mSelectionPart = part;
+			AttributeBase::structureChanged();
+		}
+
+		virtual AttributeBase::Ptr resolveStorage() override {
+			if (!mSelectionParent.isNull())
+				return mSelectionParent->resolveStorage();
+			if (updateTasksOnGet.empty())
+				return this->shared_from_this();
+			return nullptr;
+		}
+
+		virtual Int storageOffset() override {
+			if (!mSelectionParent.isNull())
+				return mSelectionParent->storageOffset() + mSelectionParent->realOffset(mSelectionRow, mSelectionColumn) + mSelectionPart;
+			return 0;
 		}
 
 		virtual void setReference(typename Attribute<T>::Ptr reference) override {
@@ -0,0 +1,72 @@
+/* Copyright 2017-2022 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <dpsim-models/Attribute.h>
+
+namespace CPS {
+
+	/**
+	 * Reads the values of a list of real attributes without going through the update tasks of derived attributes.
+	 * When the plan is compiled, every attribute is resolved to the attribute holding its storage and the position of
+	 * the value in that storage (see `AttributeBase::resolveStorage`). Consecutive columns that read from the same storage
+	 * with a constant stride are merged into runs. Gathering then evaluates each storage attribute once and copies the
+	 * values with a strided loop. Attributes that cannot be resolved, e.g. because their value is computed by a getter,
+	 * are read with `get`.
+	 * */
+	class AttributeAccessPlan {
+	public:
+		/// Append an attribute as the next column. Attributes that are not real are gathered as NaN
+		void add(AttributeBase::Ptr attr);
+		/// Remove all columns
+		void clear();
+		/// Resolve all columns to the storage they are read from. Called by `gather` if the plan is not compiled yet
+		/// or the update tasks of any attribute have changed since it was compiled
+		void compile();
+		/// Write the current values of all columns to `values`, which must hold `size()` elements
+		void gather(Real* values);
+
+		/// Number of columns
+		UInt size() const { return static_cast<UInt>(mAttributes.size()); }
+		/// Number of columns read directly from the storage of an attribute
+		UInt numDirect() const { return mNumDirect; }
+		/// Number of strided runs the direct columns have been merged into
+		UInt numRuns() const { return static_cast<UInt>(mRuns.size()); }
+
+	private:
+		/// Attribute whose storage is read, together with the size the offsets were computed for
+		struct Source {
+			AttributeBase::Ptr attribute;
+			Int size;
+		};
+
+		/// Columns `column` to `column + count - 1` are read from `source` at `offset`, `offset + stride`, ...
+		struct Run {
+			UInt source;
+			UInt column;
+			UInt count;
+			Int offset;
+			Int stride;
+		};
+
+		std::vector<AttributeBase::Ptr> mAttributes;
+		std::vector<Source> mSources;
+		std::vector<Run> mRuns;
+		/// Columns read with `get`, null if the attribute is not real
+		std::vector<std::pair<UInt, Attribute<Real>::Ptr>> mIndirect;
+		/// Data pointers of the sources, refreshed on every gather
+		std::vector<const Real*> mSourceData;
+		UInt mNumDirect = 0;
+		bool mCompiled = false;
+		/// Value of `AttributeBase::structureVersion` when the plan was compiled
+		UInt mStructureVersion = 0;
+	};
+}
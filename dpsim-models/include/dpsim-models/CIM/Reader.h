@@ -10,6 +10,7 @@
 
 #include <map>
 #include <list>
+#include <vector>
 
 #include <dpsim-models/Filesystem.h>
 #include <dpsim-models/Definitions.h>
@@ -88,8 +89,14 @@ namespace CIM {
 		std::map<String, TopologicalPowerComp::Ptr> mPowerflowEquipment;
 		/// Maps the RID of a Terminal to a PowerflowTerminal
 		std::map<String, TopologicalTerminal::Ptr> mPowerflowTerminals;
+		/// Base voltage of each ConductingEquipment by name, collected once before the mapping
+		std::map<String, Real> mEquipmentBaseVoltages;
 		///
 		Bool mUseProtectionSwitches = false;
+		/// Number of threads used for the mapping of the CIM objects
+		UInt mNumThreads = 1;
+		/// Directory of the topology snapshots, no snapshots are used if empty
+		fs::path mSnapshotDirectory;
 
 		// #### shunt component settings ####
 		/// activates global shunt capacitor setting
@@ -108,9 +115,12 @@ namespace CIM {
 		void processSvVoltage(CIMPP::SvVoltage* volt);
 		///
 		void processSvPowerFlow(CIMPP::SvPowerFlow* flow);
-		///
+		/// Creates the simulation node and the terminals of a topological node
 		template<typename VarType>
 		void processTopologicalNode(CIMPP::TopologicalNode* topNode);
+		/// Connects the terminals of a topological node to the mapped equipment
+		template<typename VarType>
+		void connectTopologicalNode(CIMPP::TopologicalNode* topNode);
 		///
 		void addFiles(const fs::path &filename);
 		/// Adds CIM files to list of files to be parsed.
@@ -127,6 +137,9 @@ namespace CIM {
 		Matrix::Index mapTopologicalNode(String mrid);
 		/// Maps CIM components to CPowerSystem components.
 		TopologicalPowerComp::Ptr mapComponent(BaseClass* obj);
+		/// Maps the given CIM objects on mNumThreads threads.
+		/// The mapping functions only read the CIM model and the collected base voltages.
+		void mapComponents(const std::vector<BaseClass*>& objects, std::vector<TopologicalPowerComp::Ptr>& comps);
 		/// Returns an RX-Line.
 		/// The voltage should be given in kV and the angle in degree.
 		/// TODO: Introduce different models such as PI and wave model.
@@ -148,6 +161,8 @@ namespace CIM {
 		TopologicalPowerComp::Ptr mapEquivalentShunt(CIMPP::EquivalentShunt *shunt);
 
 		// #### Helper Functions ####
+		/// Collect the base voltages of all equipment from the BaseVoltage objects and the topological nodes
+		void collectBaseVoltages();
 		/// Determine base voltage associated with object
 		Real determineBaseVoltageAssociatedWithEquipment(CIMPP::ConductingEquipment* equipment);
 
@@ -177,6 +192,13 @@ namespace CIM {
 		void setShuntConductance(Real v);
 		/// If set, some components like loads include protection switches
 		void useProtectionSwitches(Bool value = true);
+		/// Number of threads for the mapping of the CIM objects to components
+		void setNumThreads(UInt numThreads);
+		/// Store the loaded topologies as binary snapshots in the given directory.
+		/// A later call of loadCIM with the same file contents and settings reads
+		/// the snapshot instead of parsing the files. Only single phase SP
+		/// topologies are stored, other domains always parse the files.
+		void setSnapshotDirectory(const fs::path &directory);
 	};
 }
 }
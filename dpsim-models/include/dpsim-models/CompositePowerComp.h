@@ -23,6 +23,7 @@ namespace CPS {
 		MNAInterface::List mSubcomponentsAfterPostStep;
 
 		std::vector<CPS::Attribute<Matrix>::Ptr> mRightVectorStamps;
+		MNAInterface::List mRightVectorSubcomponents;
 
 	public:
 		using Type = VarType;
@@ -49,6 +50,8 @@ namespace CPS {
 		// #### MNA Interface Functions ####
 		/// Initializes variables of components
 		void mnaCompInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) override;
+		/// Updates the time step of the subcomponents and the parent
+		Bool mnaCompUpdateTimeStep(Real omega, Real timeStep) override;
 		/// Stamps system matrix
 		void mnaCompApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) override;
 		/// Stamps right side (source) vector
@@ -66,6 +69,10 @@ namespace CPS {
 		virtual void mnaParentInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) {
 			// By default, the parent has no custom initialization beyond what is done in CompositePowerComp::mnaCompInitialize
 		};
+		virtual Bool mnaParentUpdateTimeStep(Real omega, Real timeStep) {
+			// By default, the parent has no time step dependent coefficients, only the subcomponents are updated
+			return true;
+		};
 		virtual void mnaParentApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 			// By default, the parent has no custom stamp on the system matrix, only the subcomponents are stamped
 		};
@@ -9,6 +9,7 @@
 #pragma once
 
 #include <dpsim-models/MNASimPowerComp.h>
+#include <dpsim-models/Solver/MNALinearElementInterface.h>
 #include <dpsim-models/Base/Base_Ph1_Capacitor.h>
 
 namespace CPS {
@@ -24,6 +25,7 @@ namespace Ph1 {
 	class Capacitor :
 		public MNASimPowerComp<Complex>,
 		public Base::Ph1::Capacitor,
+		public MNALinearElementInterface<Complex>,
 		public SharedFactory<Capacitor> {
 	protected:
 		/// DC equivalent current source for harmonics [A]
@@ -50,6 +52,7 @@ namespace Ph1 {
 		// #### MNA section ####
 		/// Initializes internal variables of the component
 		void mnaCompInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) override;
+		Bool mnaCompUpdateTimeStep(Real omega, Real timeStep) override;
 		void mnaCompInitializeHarm(Real omega, Real timeStep, std::vector<Attribute<Matrix>::Ptr> leftVector) override;
 		/// Stamps system matrix
 		void mnaCompApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
@@ -72,6 +75,8 @@ namespace Ph1 {
 		void mnaCompAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) override;
 		/// Add MNA post step dependencies
 		void mnaCompAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) override;
+		/// Describe the element as conductance and history current source for bulk updates by the solver
+		Bool mnaLinearPhases(std::vector<LinearPhase>& phases) override;
 
 		class MnaPreStepHarm : public CPS::Task {
 		public:
@@ -46,6 +46,7 @@ namespace Ph1 {
 		// #### MNA section ####
 		///
 		void mnaCompInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
+		Bool mnaCompUpdateTimeStep(Real omega, Real timeStep) override { return true; }
 		/// Stamps system matrix
 		void mnaCompApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) { }
 		/// Stamps right side (source) vector
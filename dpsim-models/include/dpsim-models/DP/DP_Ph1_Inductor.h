@@ -9,6 +9,7 @@
 #pragma once
 
 #include <dpsim-models/MNASimPowerComp.h>
+#include <dpsim-models/Solver/MNALinearElementInterface.h>
 #include <dpsim-models/Solver/MNATearInterface.h>
 #include <dpsim-models/Base/Base_Ph1_Inductor.h>
 
@@ -26,6 +27,7 @@ namespace Ph1 {
 		public MNASimPowerComp<Complex>,
 		public Base::Ph1::Inductor,
 		public MNATearInterface,
+		public MNALinearElementInterface<Complex>,
 		public SharedFactory<Inductor> {
 	protected:
 		/// DC equivalent current source for harmonics [A]
@@ -35,7 +37,7 @@ namespace Ph1 {
 		/// Coefficient in front of previous current value for harmonics
 		MatrixComp mPrevCurrFac;
 		///
-		void initVars(Real timeStep);
+		void initVars(Real omega, Real timeStep);
 	public:
 		/// Defines UID, name and log level
 		Inductor(String uid, String name, Logger::Level logLevel = Logger::Level::off);
@@ -54,6 +56,7 @@ namespace Ph1 {
 		// #### MNA section ####
 		/// Initializes MNA specific variables
 		void mnaCompInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) override;
+		Bool mnaCompUpdateTimeStep(Real omega, Real timeStep) override;
 		void mnaCompInitializeHarm(Real omega, Real timeStep, std::vector<Attribute<Matrix>::Ptr> leftVectors) override;
 		/// Stamps system matrix
 		void mnaCompApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
@@ -75,6 +78,8 @@ namespace Ph1 {
 		void mnaCompAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) override;
 		/// Add MNA post step dependencies
 		void mnaCompAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) override;
+		/// Describe the element as conductance and history current source for bulk updates by the solver
+		Bool mnaLinearPhases(std::vector<LinearPhase>& phases) override;
 
 		// #### Tearing methods ####
 		void mnaTearInitialize(Real omega, Real timestep);
@@ -54,6 +54,8 @@ namespace Ph1 {
 			Logger::Level logLevel = Logger::Level::off);
 
 		// #### General ####
+		///
+		SimPowerComp<Complex>::Ptr clone(String name);
 		/// Initialize component from power flow data
 		void initializeFromNodesAndTerminals(Real frequency);
 		/// Set model specific parameters
@@ -38,6 +38,7 @@ namespace Ph1 {
 
 		// #### MNA section ####
 		void mnaCompInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
+		Bool mnaCompUpdateTimeStep(Real omega, Real timeStep) override { return true; }
 		void mnaCompInitializeHarm(Real omega, Real timeStep, std::vector<Attribute<Matrix>::Ptr> leftVector);
 		/// Stamps system matrix
 		void mnaCompApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
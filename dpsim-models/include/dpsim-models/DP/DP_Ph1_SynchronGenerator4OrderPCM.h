@@ -40,6 +40,8 @@ namespace Ph1 {
 		void stepInPerUnit() override;
 		//
 		void correctorStep() override;
+		/// The corrector step stamps the right vector after the pre-step
+		Bool mnaCompSupportsCompactRightVector() override { return false; }
 		///
 		void updateVoltage(const Matrix& leftVector) override;
 		///
@@ -79,6 +79,7 @@ namespace Ph1 {
 		// #### MNA Section ####
 		/// Initializes internal variables of the component
 		void mnaCompInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) override;
+		Bool mnaCompUpdateTimeStep(Real omega, Real timeStep) override { return true; }
 		void mnaCompInitializeHarm(Real omega, Real timeStep, std::vector<Attribute<Matrix>::Ptr> leftVectors) override;
 		/// Stamps system matrix
 		void mnaCompApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) override;
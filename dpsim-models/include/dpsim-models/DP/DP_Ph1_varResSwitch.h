@@ -66,6 +66,7 @@ namespace Ph1 {
 		// #### MNA section ####
 		/// Initializes MNA specific variables
 		void mnaCompInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
+		Bool mnaCompUpdateTimeStep(Real omega, Real timeStep) override { return true; }
 		//void mnaCompInitializeHarm(Real omega, Real timeStep, std::vector<Attribute<Matrix>::Ptr> leftVectors);
 		/// Stamps system matrix
 		void mnaCompApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
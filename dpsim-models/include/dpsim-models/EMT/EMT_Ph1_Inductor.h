@@ -9,6 +9,7 @@
 #pragma once
 
 #include <dpsim-models/MNASimPowerComp.h>
+#include <dpsim-models/Solver/MNALinearElementInterface.h>
 #include <dpsim-models/Solver/MNAInterface.h>
 #include <dpsim-models/Base/Base_Ph1_Inductor.h>
 
@@ -25,6 +26,7 @@ namespace Ph1 {
 	class Inductor :
 		public MNASimPowerComp<Real>,
 		public Base::Ph1::Inductor,
+		public MNALinearElementInterface<Real>,
 		public SharedFactory<Inductor> {
 	protected:
 		/// DC equivalent current source [A]
@@ -47,6 +49,7 @@ namespace Ph1 {
 		// #### MNA section ####
 		/// Initializes internal variables of the component
 		void mnaCompInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
+		Bool mnaCompUpdateTimeStep(Real omega, Real timeStep) override;
 		/// Stamps system matrix
 		void mnaCompApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
 		/// Stamps right side (source) vector
@@ -64,6 +67,8 @@ namespace Ph1 {
 
 		/// Add MNA post step dependencies
 		void mnaCompAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) override;
+		/// Describe the element as conductance and history current source for bulk updates by the solver
+		Bool mnaLinearPhases(std::vector<LinearPhase>& phases) override;
 	};
 }
 }
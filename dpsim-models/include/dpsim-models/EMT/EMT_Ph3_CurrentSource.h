@@ -55,6 +55,7 @@ namespace CPS {
 				// #### MNA section ####
 				/// Initializes internal variables of the component
 				void mnaCompInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) override;
+				Bool mnaCompUpdateTimeStep(Real omega, Real timeStep) override { return true; }
 				/// Stamps right side (source) vector
 				void mnaCompApplyRightSideVectorStamp(Matrix& rightVector) override;
 				/// Returns voltage through the component
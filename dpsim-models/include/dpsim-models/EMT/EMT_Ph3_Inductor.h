@@ -9,6 +9,7 @@
 #pragma once
 
 #include <dpsim-models/MNASimPowerComp.h>
+#include <dpsim-models/Solver/MNALinearElementInterface.h>
 #include <dpsim-models/Solver/MNAInterface.h>
 #include <dpsim-models/Base/Base_Ph3_Inductor.h>
 
@@ -25,6 +26,7 @@ namespace CPS {
 			class Inductor :
 				public MNASimPowerComp<Real>,
 				public Base::Ph3::Inductor,
+				public MNALinearElementInterface<Real>,
 				public SharedFactory<Inductor> {
 			protected:
 				/// DC equivalent current source [A]
@@ -47,6 +49,7 @@ namespace CPS {
 				// #### MNA section ####
 				/// Initializes internal variables of the component
 				void mnaCompInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) override;
+				Bool mnaCompUpdateTimeStep(Real omega, Real timeStep) override;
 				/// Stamps system matrix
 				void mnaCompApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) override;
 				/// Stamps right side (source) vector
@@ -63,6 +66,8 @@ namespace CPS {
 				void mnaCompAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) override;
 				/// Add MNA post step dependencies
 				void mnaCompAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) override;
+				/// Describe the element as conductance and history current source for bulk updates by the solver
+				Bool mnaLinearPhases(std::vector<LinearPhase>& phases) override;
 			};
 		}
 	}
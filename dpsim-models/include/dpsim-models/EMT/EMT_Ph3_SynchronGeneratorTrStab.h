@@ -92,6 +92,11 @@ namespace Ph3 {
 		// #### MNA Functions ####
 		/// Initializes variables of component
 		void mnaParentInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) override;
+		/// The swing equation of the rotor speed and the load angle is integrated with the time
+		/// step stored in mnaParentInitialize, so a new time step needs a new initialization
+		Bool mnaParentUpdateTimeStep(Real omega, Real timeStep) override { return false; }
+		/// The AddBStep stamps the right vector after the pre-step
+		Bool mnaCompSupportsCompactRightVector() override { return false; }
 		/// Performs with the model of a synchronous generator
 		/// to calculate the flux and current from the voltage vector.
 		void mnaParentPreStep(Real time, Int timeStepCount) override;
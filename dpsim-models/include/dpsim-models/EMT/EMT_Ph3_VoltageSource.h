@@ -58,6 +58,7 @@ namespace CPS {
 				// #### MNA section ####
 				/// Initializes internal variables of the component
 				void mnaCompInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) override;
+				Bool mnaCompUpdateTimeStep(Real omega, Real timeStep) override { return true; }
 				/// Stamps system matrix
 				void mnaCompApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) override;
 				/// Stamps right side (source) vector
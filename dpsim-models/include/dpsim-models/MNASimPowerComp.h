@@ -15,14 +15,30 @@ namespace CPS {
 		Bool mHasPreStep;
 		Bool mHasPostStep;
 
+		/// The compact right vector is updated after every pre-step
+		Bool mHasCompactRightVector = false;
+
+		/// Matrix node indices of all terminals, virtual nodes and subcomponents
+		std::vector<UInt> rightVectorNodeIndices();
+		/// Expands the node indices of rightVectorNodeIndices into right vector indices
+		void updateRightVectorIndices(Matrix::Index rows, UInt numFreqs);
+		/// Copies the entries of the right vector at mRightVectorIndices into the compact right vector.
+		/// Debug builds throw if the right vector has a value at any other index.
+		void updateCompactRightVector();
+
 	public:
 		using Type = VarType;
 		using Ptr = std::shared_ptr<MNASimPowerComp<VarType>>;
 		using List = std::vector<Ptr>;
 
 		/// This component's contribution ("stamp") to the right-side vector.
-		/// TODO performance improvements from a sparse representation, at least during copying / summation?
 		Attribute<Matrix>::Ptr mRightVector;
+		/// Entries of the right vector at mRightVectorIndices, which the solver sums
+		/// with sparse right vector stamping. Empty otherwise.
+		Attribute<Matrix>::Ptr mCompactRightVector;
+		/// Indices of the right-side vector entries this component stamps into.
+		/// Determined once during MNA initialization.
+		std::vector<UInt> mRightVectorIndices;
 
 		/// List of tasks that relate to using MNA for this component (usually pre-step and/or post-step)
 		Task::List mMnaTasks;
@@ -32,7 +48,8 @@ namespace CPS {
 			: 	SimPowerComp<VarType>(uid, name, logLevel),
 				mHasPreStep(hasPreStep),
 				mHasPostStep(hasPostStep),
-				mRightVector(IdentifiedObject::mAttributes->createDynamic<Matrix>("right_vector")) { };
+				mRightVector(IdentifiedObject::mAttributes->createDynamic<Matrix>("right_vector")),
+				mCompactRightVector(IdentifiedObject::mAttributes->createDynamic<Matrix>("right_vector_compact")) { };
 
 		/// Basic constructor that takes name and log level and sets the UID to name as well
 		explicit MNASimPowerComp(String name, Bool hasPreStep = true, Bool hasPostStep = true, Logger::Level logLevel = Logger::Level::off)
@@ -44,6 +61,7 @@ namespace CPS {
 		// Implementation of MNAInterface methods
 		void mnaInitialize(Real omega, Real timeStep) final;
 		void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) final;
+		Bool mnaUpdateTimeStep(Real omega, Real timeStep) final;
 		void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) final;
 		void mnaApplyRightSideVectorStamp(Matrix& rightVector) final;
 		void mnaUpdateVoltage(const Matrix& leftVector) final;
@@ -59,6 +77,13 @@ namespace CPS {
 
 		// MNA Interface methods that can be overridden by components
 		virtual void mnaCompInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
+		/// Not supported by default. Components whose stamps do not depend on the time step
+		/// override this to only return true, components with companion models recompute
+		/// their time step dependent coefficients and stamps.
+		virtual Bool mnaCompUpdateTimeStep(Real omega, Real timeStep);
+		/// Supported by default, components override this if they stamp their right vector outside
+		/// of their pre-step, as the compact right vector is only updated after it
+		virtual Bool mnaCompSupportsCompactRightVector();
 		virtual void mnaCompApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
 		virtual void mnaCompApplyRightSideVectorStamp(Matrix& rightVector);
 		virtual void mnaCompUpdateVoltage(const Matrix& leftVector);
@@ -74,6 +99,10 @@ namespace CPS {
 
 		const Task::List& mnaTasks() const final;
 		Attribute<Matrix>::Ptr getRightVector() const final;
+		Attribute<Matrix>::Ptr getCompactRightVector() const final;
+		const std::vector<UInt>& getRightVectorIndices() const final;
+		void mnaSetSparseRightVectorStamping(Bool value) final;
+		Bool hasCompactRightVector() const final;
 
 		class MnaPreStep : public CPS::Task {
 		public:
@@ -125,6 +125,9 @@ namespace Ph1 {
 		// #### MNA section ####
 		/// Initializes internal variables of the component
 		void mnaParentInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) override;
+		/// The PLL and the state space model of the power controller are discretized with the
+		/// time step in mnaParentInitialize, so a new time step needs a new initialization
+		Bool mnaParentUpdateTimeStep(Real omega, Real timeStep) override { return false; }
 		/// Updates current through the component
 		void mnaCompUpdateCurrent(const Matrix& leftVector) override;
 		/// Updates voltage across component
@@ -73,6 +73,8 @@ namespace Ph1 {
 		void setParameters(Real vSetPointPerUnit);
 		/// Set base voltage
 		void setBaseVoltage(Real baseVoltage);
+		/// Returns base voltage
+		Real baseVoltage() const { return mBaseVoltage; }
 		/// Calculates component's parameters in specified per-unit system
 		void calculatePerUnitParameters(Real baseApparentPower, Real baseOmega);
         /// Modify powerflow bus type
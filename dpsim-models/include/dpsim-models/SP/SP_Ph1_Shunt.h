@@ -44,6 +44,8 @@ namespace SP {namespace Ph1 {
 		// #### Powerflow section ####
 		/// Set base voltage
 		void setBaseVoltage(Real baseVoltage);
+		/// Returns base voltage
+		Real baseVoltage() const { return mBaseVoltage; }
 		/// Initializes component from power flow data
 		void calculatePerUnitParameters(Real baseApparentPower, Real baseOmega);
 		/// Stamps admittance matrix
@@ -90,6 +90,11 @@ namespace Ph1 {
 		// #### MNA Functions ####
 		/// Initializes variables of component
 		void mnaParentInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) override;
+		/// The swing equation of the rotor speed and the load angle is integrated with the time
+		/// step stored in mnaParentInitialize, so a new time step needs a new initialization
+		Bool mnaParentUpdateTimeStep(Real omega, Real timeStep) override { return false; }
+		/// The AddBStep stamps the right vector after the pre-step
+		Bool mnaCompSupportsCompactRightVector() override { return false; }
 
 		/// MNA pre and post step operations
 		void mnaParentPreStep(Real time, Int timeStepCount) override;
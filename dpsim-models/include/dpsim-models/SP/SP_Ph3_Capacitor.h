@@ -45,6 +45,8 @@ namespace CPS {
 				// #### MNA section ####
 				/// Initializes internal variables of the component
 				void mnaCompInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
+				/// The phasor admittance does not depend on the time step
+				Bool mnaCompUpdateTimeStep(Real omega, Real timeStep) override { return true; }
 				/// Stamps system matrix
 				void mnaCompApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
 				/// Update interface voltage from MNA system result
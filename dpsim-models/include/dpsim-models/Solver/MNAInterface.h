@@ -24,6 +24,9 @@ namespace CPS {
 		/// Initializes variables of components
 		virtual void mnaInitialize(Real omega, Real timeStep) = 0;
 		virtual void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) = 0;
+		/// Updates the coefficients that depend on the time step and keeps the state.
+		/// Returns false if the component does not support a change of the time step.
+		virtual Bool mnaUpdateTimeStep(Real omega, Real timeStep) = 0;
 		/// Stamps system matrix
 		virtual void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) = 0;
 		/// Stamps right side (source) vector
@@ -53,5 +56,13 @@ namespace CPS {
 		virtual const Task::List& mnaTasks() const = 0;
 		// Return right vector attribute
 		virtual Attribute<Matrix>::Ptr getRightVector() const = 0;
+		/// Return the fixed set of right vector indices the component stamps into
+		virtual const std::vector<UInt>& getRightVectorIndices() const = 0;
+		/// Return the entries of the right vector at the right vector indices
+		virtual Attribute<Matrix>::Ptr getCompactRightVector() const = 0;
+		/// Also store the right vector contribution compactly at the declared indices if supported
+		virtual void mnaSetSparseRightVectorStamping(Bool value) = 0;
+		/// True if the compact right vector is kept up to date
+		virtual Bool hasCompactRightVector() const = 0;
 	};
 }
@@ -0,0 +1,54 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <dpsim-models/Config.h>
+#include <dpsim-models/Definitions.h>
+
+namespace CPS {
+	/// \brief MNA interface for linear elements that the solver can update in bulk.
+	///
+	/// Every phase of such an element is a conductance G in parallel with a
+	/// history current source J between two matrix nodes. Before each step the
+	/// history current is computed from the previous interface voltage v and
+	/// current i as J = a v + b i and stamped as +J at node 0 and -J at node 1.
+	/// After the solution x is known, v = x(node 1) - x(node 0) and i = G v + J.
+	template <typename VarType>
+	class MNALinearElementInterface {
+	public:
+		typedef std::shared_ptr<MNALinearElementInterface<VarType>> Ptr;
+
+		/// Coefficients and state storage of one phase
+		struct LinearPhase {
+			/// Equivalent conductance G
+			VarType conductance;
+			/// Coefficient a of the previous voltage in the history current
+			VarType voltageFactor;
+			/// Coefficient b of the previous current in the history current
+			VarType currentFactor;
+			/// Coefficient of the interface voltage attribute holding v
+			VarType* voltage;
+			/// Coefficient of the interface current attribute holding i
+			VarType* current;
+			/// Matrix node index of terminal 0, -1 if grounded
+			Int node0;
+			/// Matrix node index of terminal 1, -1 if grounded
+			Int node1;
+		};
+
+		virtual ~MNALinearElementInterface() = default;
+
+		/// Append the phases of this element after the MNA initialization.
+		/// Returns false without appending anything if the element can not be
+		/// described this way, e.g. because of coupled phases or several frequencies.
+		virtual Bool mnaLinearPhases(std::vector<LinearPhase>& phases) = 0;
+	};
+}
@@ -62,6 +62,8 @@ namespace CPS {
 		virtual TopologicalNode::List topologicalNodes() = 0;
 		/// Returns terminal that are part of the component
 		virtual TopologicalTerminal::List topologicalTerminals() = 0;
+		/// Returns true if the parameters have been set via setParameters()
+		Bool parametersSet() const { return mParametersSet; }
 		/// Set behavior of component, e.g. initialization
 		void setBehaviour(Behaviour behaviour) { 
 			mBehaviour = behaviour; 
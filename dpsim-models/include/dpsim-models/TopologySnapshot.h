@@ -0,0 +1,54 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <list>
+
+#include <dpsim-models/Filesystem.h>
+#include <dpsim-models/Logger.h>
+#include <dpsim-models/SystemTopology.h>
+
+namespace CPS {
+	/// \brief Binary snapshot of a system topology.
+	///
+	/// Stores the nodes with their initial voltages, the components with
+	/// their parameters and the terminals with their initial power flow, so
+	/// that a topology loaded from CIM files can be restored without parsing
+	/// them again. A snapshot is identified by a key, usually the content hash
+	/// of the source files, and is only read if key and format version match.
+	/// Components are restored through their setParameters() functions.
+	/// Currently, the power flow components of the SP domain are supported.
+	class TopologySnapshot {
+	public:
+		/// Version of the binary format, snapshots of other versions are ignored
+		static const UInt FORMAT_VERSION = 1;
+
+		TopologySnapshot(String name = "TopologySnapshot", Logger::Level logLevel = Logger::Level::info);
+
+		/// Hash of the content of the given files and of additional settings
+		/// that influence the resulting topology, as hexadecimal string
+		static String contentKey(const std::list<fs::path> &filenames, const String &settings = String());
+
+		/// Returns true if all nodes and components of the topology can be stored
+		Bool isSupported(const SystemTopology &system);
+		/// Writes the topology to the file. The file is replaced atomically, so
+		/// that concurrent runs never read a partially written snapshot.
+		/// Returns false if the topology is not supported or the file cannot
+		/// be written, filesystem errors are logged and not thrown.
+		Bool write(const SystemTopology &system, const fs::path &filename, const String &key);
+		/// Reads the topology from the file. Returns false if the file does not
+		/// exist, is damaged or was written for another key or format version.
+		Bool read(const fs::path &filename, const String &key, SystemTopology &system,
+			Logger::Level componentLogLevel = Logger::Level::off);
+
+	private:
+		///
+		Logger::Log mSLog;
+	};
+}
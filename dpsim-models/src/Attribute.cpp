@@ -6,6 +6,7 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  *********************************************************************************/
 
+#include <atomic>
 #include <iostream>
 
 #include <dpsim-models/Config.h>
@@ -13,6 +14,16 @@
 
 using namespace CPS;
 
+static std::atomic<UInt> sStructureVersion { 0 };
+
+UInt AttributeBase::structureVersion() {
+	return sStructureVersion.load(std::memory_order_relaxed);
+}
+
+void AttributeBase::structureChanged() {
+	sStructureVersion.fetch_add(1, std::memory_order_relaxed);
+}
+
 std::ostream &operator<<(std::ostream &output, AttributeBase &attr) {
 	output << attr.toString();
 	return output;
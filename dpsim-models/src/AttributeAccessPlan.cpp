@@ -0,0 +1,108 @@
+/* Copyright 2017-2022 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <limits>
+
+#include <dpsim-models/AttributeAccessPlan.h>
+
+using namespace CPS;
+
+void AttributeAccessPlan::add(AttributeBase::Ptr attr) {
+	mAttributes.push_back(attr);
+	mCompiled = false;
+}
+
+void AttributeAccessPlan::clear() {
+	mAttributes.clear();
+	mSources.clear();
+	mRuns.clear();
+	mIndirect.clear();
+	mSourceData.clear();
+	mNumDirect = 0;
+	mCompiled = false;
+}
+
+void AttributeAccessPlan::compile() {
+	mSources.clear();
+	mRuns.clear();
+	mIndirect.clear();
+	mNumDirect = 0;
+	mStructureVersion = AttributeBase::structureVersion();
+
+	for (UInt column = 0; column < mAttributes.size(); column++) {
+		auto& attr = mAttributes[column];
+
+		// Only single real values can be read from the storage of another attribute
+		Int offset = 0;
+		Int size = 0;
+		AttributeBase::Ptr storage;
+		if (attr->getType() == typeid(Real)) {
+			storage = attr->resolveStorage();
+			offset = attr->storageOffset();
+		}
+		if (!storage.isNull() && (!storage->realData(size) || offset < 0 || offset >= size))
+			storage = nullptr;
+
+		if (storage.isNull()) {
+			mIndirect.emplace_back(column, std::dynamic_pointer_cast<Attribute<Real>>(attr.getPtr()));
+			continue;
+		}
+
+		UInt source = 0;
+		while (source < mSources.size() && mSources[source].attribute.getPtr() != storage.getPtr())
+			source++;
+		if (source == mSources.size())
+			mSources.push_back({ storage, size });
+
+		// Extend the previous run if this column continues its stride
+		if (!mRuns.empty()) {
+			Run& run = mRuns.back();
+			if (run.source == source && run.column + run.count == column) {
+				if (run.count == 1)
+					run.stride = offset - run.offset;
+				if (offset == run.offset + static_cast<Int>(run.count) * run.stride) {
+					run.count++;
+					mNumDirect++;
+					continue;
+				}
+			}
+		}
+		mRuns.push_back({ source, column, 1, offset, 0 });
+		mNumDirect++;
+	}
+
+	mSourceData.assign(mSources.size(), nullptr);
+	mCompiled = true;
+}
+
+void AttributeAccessPlan::gather(Real* values) {
+	// Changed update tasks, e.g. after `setReference`, can move the value to another storage
+	if (!mCompiled || mStructureVersion != AttributeBase::structureVersion())
+		compile();
+
+	// Evaluate every storage attribute once. Offsets are only valid as long as the storage keeps its size
+	for (UInt source = 0; source < mSources.size(); source++) {
+		Int size = 0;
+		mSourceData[source] = mSources[source].attribute->realData(size);
+		if (size != mSources[source].size) {
+			compile();
+			gather(values);
+			return;
+		}
+	}
+
+	for (const Run& run : mRuns) {
+		const Real* data = mSourceData[run.source] + run.offset;
+		Real* out = values + run.column;
+		for (UInt k = 0; k < run.count; k++)
+			out[k] = data[static_cast<Int>(k) * run.stride];
+	}
+
+	for (auto& [column, attr] : mIndirect)
+		values[column] = attr.isNull() ? std::numeric_limits<Real>::quiet_NaN() : attr->get();
+}
@@ -9,10 +9,20 @@
 #include <CIMModel.hpp>
 #include <IEC61970.hpp>
 #include <CIMExceptions.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <iomanip>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <thread>
 
 #define READER_CPP
 #include <dpsim-models/CIM/Reader.h>
+#include <dpsim-models/TopologySnapshot.h>
 
 using namespace CPS;
 using namespace CPS::CIM;
@@ -54,6 +64,14 @@ void Reader::setShuntConductance(Real v) {
 /// If set, some components like loads include protection switches
 void Reader::useProtectionSwitches(Bool value) { mUseProtectionSwitches = value; }
 
+void Reader::setSnapshotDirectory(const fs::path &directory) { mSnapshotDirectory = directory; }
+
+void Reader::setNumThreads(UInt numThreads) {
+	if (numThreads < 1)
+		throw std::invalid_argument("CIM::Reader>>setNumThreads: at least one thread is required");
+	mNumThreads = numThreads;
+}
+
 Real Reader::unitValue(Real value, CIMPP::UnitMultiplier mult) {
 	switch (mult) {
 	case UnitMultiplier::p:
@@ -119,7 +137,60 @@ void Reader::addFiles(const std::list<fs::path> &filenames) {
 		addFiles(filename);
 }
 
+void Reader::mapComponents(const std::vector<BaseClass*>& objects, std::vector<TopologicalPowerComp::Ptr>& comps) {
+	comps.assign(objects.size(), nullptr);
+
+	UInt numThreads = std::min<UInt>(mNumThreads, static_cast<UInt>(objects.size()));
+	if (numThreads <= 1) {
+		for (std::size_t i = 0; i < objects.size(); ++i)
+			comps[i] = mapComponent(objects[i]);
+		return;
+	}
+
+	// The objects are handed out in small chunks as the cost of the mapping
+	// differs a lot between the component types
+	const std::size_t chunkSize = 16;
+	std::atomic<std::size_t> next { 0 };
+	std::exception_ptr error;
+	std::mutex errorMutex;
+
+	auto worker = [&]() {
+		while (true) {
+			std::size_t begin = next.fetch_add(chunkSize);
+			if (begin >= objects.size())
+				return;
+			std::size_t end = std::min(begin + chunkSize, objects.size());
+			try {
+				for (std::size_t i = begin; i < end; ++i)
+					comps[i] = mapComponent(objects[i]);
+			} catch (...) {
+				std::lock_guard<std::mutex> lock(errorMutex);
+				if (!error)
+					error = std::current_exception();
+				next = objects.size();
+				return;
+			}
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (UInt i = 1; i < numThreads; ++i)
+		threads.emplace_back(worker);
+	worker();
+	for (auto& thread : threads)
+		thread.join();
+
+	if (error)
+		std::rethrow_exception(error);
+}
+
 void Reader::parseFiles() {
+	using Clock = std::chrono::steady_clock;
+	auto seconds = [](Clock::time_point start) {
+		return std::chrono::duration<Real>(Clock::now() - start).count();
+	};
+
+	auto start = Clock::now();
 	try {
 		mModel->parseFiles();
 	}
@@ -127,15 +198,52 @@ void Reader::parseFiles() {
 		SPDLOG_LOGGER_ERROR(mSLog, "Failed to parse CIM files");
 		return;
 	}
+	SPDLOG_LOGGER_INFO(mSLog, "Parsed {} CIM objects in {:.3f} s", mModel->Objects.size(), seconds(start));
 
-	SPDLOG_LOGGER_INFO(mSLog, "#### List of TopologicalNodes, associated Terminals and Equipment");
+	start = Clock::now();
+	SPDLOG_LOGGER_INFO(mSLog, "#### List of TopologicalNodes and associated Terminals");
+	std::vector<CIMPP::TopologicalNode*> topNodes;
+	std::vector<BaseClass*> equipment;
+	std::set<String> equipmentIds;
 	for (auto obj : mModel->Objects) {
 		if (CIMPP::TopologicalNode* topNode = dynamic_cast<CIMPP::TopologicalNode*>(obj)) {
+			topNodes.push_back(topNode);
 			if (mDomain == Domain::EMT)
 				processTopologicalNode<Real>(topNode);
 			else
 				processTopologicalNode<Complex>(topNode);
 		}
+		// Check if object is not TopologicalNode, SvVoltage or SvPowerFlow
+		else if (!dynamic_cast<CIMPP::SvVoltage*>(obj) && !dynamic_cast<CIMPP::SvPowerFlow*>(obj)) {
+			CIMPP::IdentifiedObject* idObj = dynamic_cast<CIMPP::IdentifiedObject*>(obj);
+			if (idObj && equipmentIds.insert(idObj->mRID).second)
+				equipment.push_back(obj);
+		}
+	}
+	collectBaseVoltages();
+	SPDLOG_LOGGER_INFO(mSLog, "Created {} nodes and {} terminals in {:.3f} s",
+		mPowerflowNodes.size(), mPowerflowTerminals.size(), seconds(start));
+
+	// Only the conversion of the individual objects runs in parallel,
+	// everything that modifies the shared maps is done sequentially
+	start = Clock::now();
+	SPDLOG_LOGGER_INFO(mSLog, "#### Map equipment");
+	std::vector<TopologicalPowerComp::Ptr> comps;
+	mapComponents(equipment, comps);
+	for (auto comp : comps) {
+		if (comp)
+			mPowerflowEquipment.insert(std::make_pair(comp->uid(), comp));
+	}
+	SPDLOG_LOGGER_INFO(mSLog, "Mapped {} of {} objects to components in {:.3f} s on {} threads",
+		mPowerflowEquipment.size(), equipment.size(), seconds(start), mNumThreads);
+
+	start = Clock::now();
+	SPDLOG_LOGGER_INFO(mSLog, "#### Connect Terminals to Equipment");
+	for (auto topNode : topNodes) {
+		if (mDomain == Domain::EMT)
+			connectTopologicalNode<Real>(topNode);
+		else
+			connectTopologicalNode<Complex>(topNode);
 	}
 
 	// Collect voltage state variables associated to nodes that are used
@@ -152,26 +260,6 @@ void Reader::parseFiles() {
 		}
 	}
 
-	SPDLOG_LOGGER_INFO(mSLog, "#### Create other components");
-	for (auto obj : mModel->Objects) {
-
-		// Check if object is not TopologicalNode, SvVoltage or SvPowerFlow
-		if (!dynamic_cast<CIMPP::TopologicalNode*>(obj)
-			&& !dynamic_cast<CIMPP::SvVoltage*>(obj)
-			&& !dynamic_cast<CIMPP::SvPowerFlow*>(obj)) {
-
-			if (CIMPP::IdentifiedObject* idObj = dynamic_cast<CIMPP::IdentifiedObject*>(obj)) {
-
-				// Check if object is already in equipment list
-				if (mPowerflowEquipment.find(idObj->mRID) == mPowerflowEquipment.end()) {
-					TopologicalPowerComp::Ptr comp = mapComponent(obj);
-					if (comp)
-						mPowerflowEquipment.insert(std::make_pair(comp->uid(), comp));
-				}
-			}
-		}
-	}
-
 	SPDLOG_LOGGER_INFO(mSLog, "#### Check topology for unconnected components");
 	for (auto pfe : mPowerflowEquipment) {
 		auto c = pfe.second;
@@ -189,17 +277,11 @@ void Reader::parseFiles() {
 			}
 		}
 	}
+	SPDLOG_LOGGER_INFO(mSLog, "Connected the topology in {:.3f} s", seconds(start));
 }
 
 SystemTopology Reader::loadCIM(Real systemFrequency, const fs::path &filename, Domain domain, PhaseType phase, GeneratorType genType) {
-	mFrequency = systemFrequency;
-	mOmega = 2 * PI*mFrequency;
-	mDomain = domain;
-	mPhase = phase;
-	mGeneratorType = genType;
-	addFiles(filename);
-	parseFiles();
-	return systemTopology();
+	return loadCIM(systemFrequency, std::list<fs::path>{ filename }, domain, phase, genType);
 }
 
 SystemTopology Reader::loadCIM(Real systemFrequency, const std::list<fs::path> &filenames, Domain domain, PhaseType phase, GeneratorType genType) {
@@ -208,9 +290,47 @@ SystemTopology Reader::loadCIM(Real systemFrequency, const std::list<fs::path> &
 	mDomain = domain;
 	mPhase = phase;
 	mGeneratorType = genType;
+
+	if (mSnapshotDirectory.empty()) {
+		addFiles(filenames);
+		parseFiles();
+		return systemTopology();
+	}
+
+	// Snapshots only store the power flow components of the SP domain
+	if (mDomain != Domain::SP || mPhase != PhaseType::Single) {
+		SPDLOG_LOGGER_INFO(mSLog, "Not using topology snapshots: only single phase SP topologies are supported");
+		addFiles(filenames);
+		parseFiles();
+		return systemTopology();
+	}
+
+	// All settings that change the mapping are part of the key
+	std::ostringstream settings;
+	settings << std::setprecision(17) << mFrequency << ' ' << static_cast<int>(mDomain) << ' '
+		<< static_cast<int>(mPhase) << ' ' << static_cast<int>(mGeneratorType) << ' '
+		<< mSetShuntCapacitor << ' ' << mShuntCapacitorValue << ' '
+		<< mSetShuntConductance << ' ' << mShuntConductanceValue << ' ' << mUseProtectionSwitches;
+
+	String key;
+	try {
+		key = TopologySnapshot::contentKey(filenames, settings.str());
+	} catch (SystemError &e) {
+		SPDLOG_LOGGER_WARN(mSLog, "Cannot determine snapshot key: {}", e.descr());
+	}
+
+	TopologySnapshot snapshot(mSLog->name() + "_snapshot", mSLog->level());
+	fs::path snapshotFile = mSnapshotDirectory / (key + ".snapshot");
+	SystemTopology system;
+	if (!key.empty() && snapshot.read(snapshotFile, key, system, mComponentLogLevel))
+		return system;
+
 	addFiles(filenames);
 	parseFiles();
-	return systemTopology();
+	system = systemTopology();
+	if (!key.empty() && !snapshot.write(system, snapshotFile, key))
+		SPDLOG_LOGGER_INFO(mSLog, "Topology cannot be stored as snapshot");
+	return system;
 }
 
 void Reader::processSvVoltage(CIMPP::SvVoltage* volt) {
@@ -947,36 +1067,36 @@ TopologicalPowerComp::Ptr Reader::mapEquivalentShunt(CIMPP::EquivalentShunt* shu
 	return cpsShunt;
 }
 
-Real Reader::determineBaseVoltageAssociatedWithEquipment(CIMPP::ConductingEquipment* equipment){
-	Real baseVoltage = 0;
-
-    // first look for baseVolt object to determine baseVoltage
-    for (auto obj : mModel->Objects) {
-        if (CIMPP::BaseVoltage* baseVolt = dynamic_cast<CIMPP::BaseVoltage*>(obj)) {
-            for (auto comp : baseVolt->ConductingEquipment) {
-                if (comp->name == equipment->name) {
-                    baseVoltage = unitValue(baseVolt->nominalVoltage.value,UnitMultiplier::k);
-                }
-            }
-        }
-    }
-    // as second option take baseVoltage of topologicalNode where equipment is connected to
-    if(baseVoltage == 0){
-        for (auto obj : mModel->Objects) {
-			if (CIMPP::TopologicalNode* topNode = dynamic_cast<CIMPP::TopologicalNode*>(obj)) {
-                for (auto term : topNode->Terminal) {
-					if (term->ConductingEquipment->name == equipment->name) {
-                        baseVoltage = unitValue(topNode->BaseVoltage->nominalVoltage.value,UnitMultiplier::k);
-					}
-				}
+void Reader::collectBaseVoltages() {
+	// Later objects take precedence, as in a search over all objects
+	std::map<String, Real> fromBaseVoltage, fromNode;
+	for (auto obj : mModel->Objects) {
+		if (CIMPP::BaseVoltage* baseVolt = dynamic_cast<CIMPP::BaseVoltage*>(obj)) {
+			for (auto comp : baseVolt->ConductingEquipment)
+				fromBaseVoltage[comp->name] = unitValue(baseVolt->nominalVoltage.value, UnitMultiplier::k);
+		}
+		else if (CIMPP::TopologicalNode* topNode = dynamic_cast<CIMPP::TopologicalNode*>(obj)) {
+			if (!topNode->BaseVoltage)
+				continue;
+			for (auto term : topNode->Terminal) {
+				if (term->ConductingEquipment)
+					fromNode[term->ConductingEquipment->name] = unitValue(topNode->BaseVoltage->nominalVoltage.value, UnitMultiplier::k);
 			}
 		}
-    }
+	}
 
-	return baseVoltage;
+	// The base voltage of the topological node is only used if there is no BaseVoltage object
+	mEquipmentBaseVoltages = fromNode;
+	for (auto& entry : fromBaseVoltage) {
+		if (entry.second != 0)
+			mEquipmentBaseVoltages[entry.first] = entry.second;
+	}
 }
 
-
+Real Reader::determineBaseVoltageAssociatedWithEquipment(CIMPP::ConductingEquipment* equipment) {
+	auto search = mEquipmentBaseVoltages.find(equipment->name);
+	return search != mEquipmentBaseVoltages.end() ? search->second : 0;
+}
 
 template<typename VarType>
 void Reader::processTopologicalNode(CIMPP::TopologicalNode* topNode) {
@@ -994,7 +1114,6 @@ void Reader::processTopologicalNode(CIMPP::TopologicalNode* topNode) {
 
 	for (auto term : topNode->Terminal) {
 		// Insert Terminal if it does not exist in the map and add reference to node.
-		// This could be optimized because the Terminal is searched twice.
 		auto cpsTerm = SimTerminal<VarType>::make(term->mRID);
 		mPowerflowTerminals.insert(std::make_pair(term->mRID, cpsTerm));
 		cpsTerm->setNode(std::dynamic_pointer_cast<SimNode<VarType>>(mPowerflowNodes[topNode->mRID]));
@@ -1003,33 +1122,32 @@ void Reader::processTopologicalNode(CIMPP::TopologicalNode* topNode) {
 			term->sequenceNumber = 1;
 
 		SPDLOG_LOGGER_INFO(mSLog, "    Terminal {}, sequenceNumber {}", term->mRID, (int) term->sequenceNumber);
+	}
+}
 
-		// Try to process Equipment connected to Terminal.
+template<typename VarType>
+void Reader::connectTopologicalNode(CIMPP::TopologicalNode* topNode) {
+	for (auto term : topNode->Terminal) {
 		CIMPP::ConductingEquipment *equipment = term->ConductingEquipment;
 		if (!equipment) {
 			SPDLOG_LOGGER_WARN(mSLog, "Terminal {} has no Equipment, ignoring!", term->mRID);
+			continue;
 		}
-		else {
-			// Insert Equipment if it does not exist in the map and add reference to Terminal.
-			// This could be optimized because the Equipment is searched twice.
-			if (mPowerflowEquipment.find(equipment->mRID) == mPowerflowEquipment.end()) {
-				TopologicalPowerComp::Ptr comp = mapComponent(equipment);
-				if (comp) {
-					mPowerflowEquipment.insert(std::make_pair(equipment->mRID, comp));
-				} else {
-					SPDLOG_LOGGER_WARN(mSLog, "Could not map equipment {}", equipment->mRID);
-					continue;
-				}
-			}
-
-			auto pfEquipment = mPowerflowEquipment.at(equipment->mRID);
-			std::dynamic_pointer_cast<SimPowerComp<VarType>>(pfEquipment)->setTerminalAt(
-				std::dynamic_pointer_cast<SimTerminal<VarType>>(mPowerflowTerminals[term->mRID]), term->sequenceNumber-1);
 
-			SPDLOG_LOGGER_INFO(mSLog, "        Added Terminal {} to Equipment {}", term->mRID, equipment->mRID);
+		auto search = mPowerflowEquipment.find(equipment->mRID);
+		if (search == mPowerflowEquipment.end()) {
+			SPDLOG_LOGGER_WARN(mSLog, "Could not map equipment {}", equipment->mRID);
+			continue;
 		}
+
+		std::dynamic_pointer_cast<SimPowerComp<VarType>>(search->second)->setTerminalAt(
+			std::dynamic_pointer_cast<SimTerminal<VarType>>(mPowerflowTerminals[term->mRID]), term->sequenceNumber-1);
+
+		SPDLOG_LOGGER_INFO(mSLog, "        Added Terminal {} to Equipment {}", term->mRID, equipment->mRID);
 	}
 }
 
 template void Reader::processTopologicalNode<Real>(CIMPP::TopologicalNode* topNode);
 template void Reader::processTopologicalNode<Complex>(CIMPP::TopologicalNode* topNode);
+template void Reader::connectTopologicalNode<Real>(CIMPP::TopologicalNode* topNode);
+template void Reader::connectTopologicalNode<Complex>(CIMPP::TopologicalNode* topNode);
@@ -12,6 +12,7 @@ void CompositePowerComp<VarType>::addMNASubComponent(typename SimPowerComp<VarTy
 
 		if (contributeToRightVector) {
 			this->mRightVectorStamps.push_back(mnasubcomp->mRightVector);
+			this->mRightVectorSubcomponents.push_back(mnasubcomp);
 		}
 
 		switch (preStepOrder) {
@@ -52,6 +53,16 @@ void CompositePowerComp<VarType>::mnaCompInitialize(Real omega, Real timeStep, A
 	mnaParentInitialize(omega, timeStep, leftVector);
 }
 
+template <typename VarType>
+Bool CompositePowerComp<VarType>::mnaCompUpdateTimeStep(Real omega, Real timeStep) {
+	Bool supported = true;
+	for (auto subComp : mSubcomponentsMNA) {
+		if (!subComp->mnaUpdateTimeStep(omega, timeStep))
+			supported = false;
+	}
+	return mnaParentUpdateTimeStep(omega, timeStep) && supported;
+}
+
 template <typename VarType>
 void CompositePowerComp<VarType>::mnaCompApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	for (auto subComp : mSubcomponentsMNA) {
@@ -62,10 +73,23 @@ void CompositePowerComp<VarType>::mnaCompApplySystemMatrixStamp(SparseMatrixRow&
 
 template <typename VarType>
 void CompositePowerComp<VarType>::mnaCompApplyRightSideVectorStamp(Matrix& rightVector) {
-	rightVector.setZero();
-	for (auto stamp : mRightVectorStamps) {
-		if ((**stamp).size() != 0) {
-			rightVector += **stamp;
+	if (this->hasCompactRightVector()) {
+		// Only touch the entries the subcomponents stamp into
+		for (auto idx : this->mRightVectorIndices)
+			rightVector(idx, 0) = 0;
+		for (std::size_t i = 0; i < mRightVectorStamps.size(); ++i) {
+			const Matrix& stamp = **mRightVectorStamps[i];
+			if (stamp.size() == 0)
+				continue;
+			for (auto idx : mRightVectorSubcomponents[i]->getRightVectorIndices())
+				rightVector(idx, 0) += stamp(idx, 0);
+		}
+	} else {
+		rightVector.setZero();
+		for (auto stamp : mRightVectorStamps) {
+			if ((**stamp).size() != 0) {
+				rightVector += **stamp;
+			}
 		}
 	}
 	mnaParentApplyRightSideVectorStamp(rightVector);
@@ -57,9 +57,7 @@ void DP::Ph1::Capacitor::initializeFromNodesAndTerminals(Real frequency) {
 		Logger::phasorToString(initialSingleVoltage(1)));
 }
 
-void DP::Ph1::Capacitor::mnaCompInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) {
-		updateMatrixNodeIndices();
-
+Bool DP::Ph1::Capacitor::mnaCompUpdateTimeStep(Real omega, Real timeStep) {
 	Real equivCondReal = 2.0 * **mCapacitance / timeStep;
 	Real prevVoltCoeffReal = 2.0 * **mCapacitance / timeStep;
 
@@ -68,7 +66,15 @@ void DP::Ph1::Capacitor::mnaCompInitialize(Real omega, Real timeStep, Attribute<
 		mEquivCond(freq,0) = { equivCondReal, equivCondImag };
 		Real prevVoltCoeffImag = - 2.*PI * mFrequencies(freq,0) * **mCapacitance;
 		mPrevVoltCoeff(freq,0) = { prevVoltCoeffReal, prevVoltCoeffImag };
+	}
+	return true;
+}
 
+void DP::Ph1::Capacitor::mnaCompInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) {
+		updateMatrixNodeIndices();
+
+	mnaCompUpdateTimeStep(omega, timeStep);
+	for (UInt freq = 0; freq < mNumFreqs; freq++) {
 		mEquivCurrent(freq,0) = -(**mIntfCurrent)(0,freq) + -mPrevVoltCoeff(freq,0) * (**mIntfVoltage)(0,freq);
 		(**mIntfCurrent)(0, freq) = mEquivCond(freq,0) * (**mIntfVoltage)(0,freq) + mEquivCurrent(freq,0);
 	}
@@ -87,15 +93,8 @@ void DP::Ph1::Capacitor::mnaCompInitialize(Real omega, Real timeStep, Attribute<
 void DP::Ph1::Capacitor::mnaCompInitializeHarm(Real omega, Real timeStep, std::vector<Attribute<Matrix>::Ptr> leftVectors) {
 		updateMatrixNodeIndices();
 
-	Real equivCondReal = 2.0 * **mCapacitance / timeStep;
-	Real prevVoltCoeffReal = 2.0 * **mCapacitance / timeStep;
-
+	mnaCompUpdateTimeStep(omega, timeStep);
 	for (UInt freq = 0; freq < mNumFreqs; freq++) {
-		Real equivCondImag = 2.*PI * mFrequencies(freq,0) * **mCapacitance;
-		mEquivCond(freq,0) = { equivCondReal, equivCondImag };
-		Real prevVoltCoeffImag = - 2.*PI * mFrequencies(freq,0) * **mCapacitance;
-		mPrevVoltCoeff(freq,0) = { prevVoltCoeffReal, prevVoltCoeffImag };
-
 		mEquivCurrent(freq,0) = -(**mIntfCurrent)(0,freq) + -mPrevVoltCoeff(freq,0) * (**mIntfVoltage)(0,freq);
 		(**mIntfCurrent)(0, freq) = mEquivCond(freq,0) * (**mIntfVoltage)(0,freq) + mEquivCurrent(freq,0);
 	}
@@ -228,6 +227,17 @@ void DP::Ph1::Capacitor::mnaCompPostStep(Real time, Int timeStepCount, Attribute
 	this->mnaUpdateCurrent(**leftVector);
 }
 
+Bool DP::Ph1::Capacitor::mnaLinearPhases(std::vector<LinearPhase>& phases) {
+	if (mNumFreqs != 1)
+		return false;
+
+	phases.push_back({ mEquivCond(0,0), -mPrevVoltCoeff(0,0), -1.,
+		&(**mIntfVoltage)(0,0), &(**mIntfCurrent)(0,0),
+		terminalNotGrounded(0) ? static_cast<Int>(matrixNodeIndex(0)) : -1,
+		terminalNotGrounded(1) ? static_cast<Int>(matrixNodeIndex(1)) : -1 });
+	return true;
+}
+
 void DP::Ph1::Capacitor::MnaPreStepHarm::execute(Real time, Int timeStepCount) {
 	mCapacitor.mnaCompApplyRightSideVectorStampHarm(**mCapacitor.mRightVector);
 }
@@ -58,7 +58,7 @@ void DP::Ph1::Inductor::initializeFromNodesAndTerminals(Real frequency) {
 
 // #### MNA functions ####
 
-void DP::Ph1::Inductor::initVars(Real timeStep) {
+Bool DP::Ph1::Inductor::mnaCompUpdateTimeStep(Real omega, Real timeStep) {
 	for (UInt freq = 0; freq < mNumFreqs; freq++) {
 		Real a = timeStep / (2. * **mInductance);
 		Real b = timeStep * 2.*PI * mFrequencies(freq,0) / 2.;
@@ -69,7 +69,13 @@ void DP::Ph1::Inductor::initVars(Real timeStep) {
 		Real preCurrFracReal = (1. - b * b) / (1. + b * b);
 		Real preCurrFracImag =  (-2. * b) / (1. + b * b);
 		mPrevCurrFac(freq,0) = { preCurrFracReal, preCurrFracImag };
+	}
+	return true;
+}
 
+void DP::Ph1::Inductor::initVars(Real omega, Real timeStep) {
+	mnaCompUpdateTimeStep(omega, timeStep);
+	for (UInt freq = 0; freq < mNumFreqs; freq++) {
 		// In steady-state, these variables should not change
 		mEquivCurrent(freq,0) = mEquivCond(freq,0) * (**mIntfVoltage)(0,freq) + mPrevCurrFac(freq,0) * (**mIntfCurrent)(0,freq);
 		(**mIntfCurrent)(0,freq) = mEquivCond(freq,0) * (**mIntfVoltage)(0,freq) + mEquivCurrent(freq,0);
@@ -78,7 +84,7 @@ void DP::Ph1::Inductor::initVars(Real timeStep) {
 
 void DP::Ph1::Inductor::mnaCompInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) {
 	updateMatrixNodeIndices();
-	initVars(timeStep);
+	initVars(omega, timeStep);
 
 	SPDLOG_LOGGER_INFO(mSLog,
 		"\n--- MNA initialization ---"
@@ -94,7 +100,7 @@ void DP::Ph1::Inductor::mnaCompInitialize(Real omega, Real timeStep, Attribute<M
 void DP::Ph1::Inductor::mnaCompInitializeHarm(Real omega, Real timeStep, std::vector<Attribute<Matrix>::Ptr> leftVectors) {
 		updateMatrixNodeIndices();
 
-	initVars(timeStep);
+	initVars(omega, timeStep);
 
 	mMnaTasks.push_back(std::make_shared<MnaPreStepHarm>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStepHarm>(*this, leftVectors));
@@ -211,6 +217,17 @@ void DP::Ph1::Inductor::mnaCompPostStep(Real time, Int timeStepCount, Attribute<
 	this->mnaUpdateCurrent(**leftVector);
 }
 
+Bool DP::Ph1::Inductor::mnaLinearPhases(std::vector<LinearPhase>& phases) {
+	if (mNumFreqs != 1)
+		return false;
+
+	phases.push_back({ mEquivCond(0,0), mEquivCond(0,0), mPrevCurrFac(0,0),
+		&(**mIntfVoltage)(0,0), &(**mIntfCurrent)(0,0),
+		terminalNotGrounded(0) ? static_cast<Int>(matrixNodeIndex(0)) : -1,
+		terminalNotGrounded(1) ? static_cast<Int>(matrixNodeIndex(1)) : -1 });
+	return true;
+}
+
 void DP::Ph1::Inductor::MnaPreStepHarm::execute(Real time, Int timeStepCount) {
 	mInductor.mnaCompApplyRightSideVectorStampHarm(**mInductor.mRightVector);
 }
@@ -261,7 +278,7 @@ void DP::Ph1::Inductor::mnaCompUpdateCurrentHarm() {
 
 // #### Tear Methods ####
 void DP::Ph1::Inductor::mnaTearInitialize(Real omega, Real timeStep) {
-	initVars(timeStep);
+	initVars(omega, timeStep);
 }
 
 void DP::Ph1::Inductor::mnaTearApplyMatrixStamp(SparseMatrixRow& tearMatrix) {
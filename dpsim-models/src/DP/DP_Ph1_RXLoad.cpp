@@ -26,6 +26,14 @@ DP::Ph1::RXLoad::RXLoad(String name, Logger::Level logLevel)
 	: RXLoad(name, name, logLevel) {
 }
 
+SimPowerComp<Complex>::Ptr DP::Ph1::RXLoad::clone(String name) {
+	auto copy = RXLoad::make(name, mLogLevel);
+	// Otherwise, the parameters are derived from the terminal powers of the copy
+	if (mParametersSet)
+		copy->setParameters(**mActivePower, **mReactivePower, **mNomVoltage);
+	return copy;
+}
+
 void DP::Ph1::RXLoad::initializeFromNodesAndTerminals(Real frequency) {
 
 	if(!mParametersSet){
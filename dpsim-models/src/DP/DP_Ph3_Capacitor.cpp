@@ -66,7 +66,7 @@ void DP::Ph3::Capacitor::initializeFromNodesAndTerminals(Real frequency) {
 }
 
 
-void DP::Ph3::Capacitor::initVars(Real omega, Real timeStep) {
+Bool DP::Ph3::Capacitor::mnaCompUpdateTimeStep(Real omega, Real timeStep) {
 	Matrix a = timeStep / 2 * (**mCapacitance).inverse();
 	Real b = timeStep * omega / 2.;
 
@@ -90,7 +90,11 @@ void DP::Ph3::Capacitor::initVars(Real omega, Real timeStep) {
 		Complex(mPrevVoltCoeffReal(0, 0), mPrevVoltCoeffImag(0, 0)), Complex(mPrevVoltCoeffReal(0, 1), mPrevVoltCoeffImag(0, 1)), Complex(mPrevVoltCoeffReal(0, 2), mPrevVoltCoeffImag(0, 2)),
 		Complex(mPrevVoltCoeffReal(1, 0), mPrevVoltCoeffImag(1, 0)), Complex(mPrevVoltCoeffReal(1, 1), mPrevVoltCoeffImag(1, 1)), Complex(mPrevVoltCoeffReal(1, 2), mPrevVoltCoeffImag(1, 2)),
 		Complex(mPrevVoltCoeffReal(2, 0), mPrevVoltCoeffImag(2, 0)), Complex(mPrevVoltCoeffReal(2, 1), mPrevVoltCoeffImag(2, 1)), Complex(mPrevVoltCoeffReal(2, 2), mPrevVoltCoeffImag(2, 2));
+	return true;
+}
 
+void DP::Ph3::Capacitor::initVars(Real omega, Real timeStep) {
+	mnaCompUpdateTimeStep(omega, timeStep);
 
 	mEquivCurrent = -mPrevVoltCoeff * **mIntfVoltage - **mIntfCurrent;
 }
@@ -63,7 +63,7 @@ void DP::Ph3::Inductor::initializeFromNodesAndTerminals(Real frequency) {
 				// << "--- Power flow initialization finished ---" << std::endl;
 }
 
-void DP::Ph3::Inductor::initVars(Real omega, Real timeStep) {
+Bool DP::Ph3::Inductor::mnaCompUpdateTimeStep(Real omega, Real timeStep) {
 	Matrix a = timeStep / 2. * (**mInductance).inverse();
 	Real b = timeStep * omega / 2.;
 
@@ -78,7 +78,11 @@ void DP::Ph3::Inductor::initVars(Real omega, Real timeStep) {
 	Real preCurrFracReal = (1. - b * b) / (1. + b * b);
 	Real preCurrFracImag =  (-2. * b) / (1. + b * b);
 	mPrevCurrFac = Complex(preCurrFracReal, preCurrFracImag);
+	return true;
+}
 
+void DP::Ph3::Inductor::initVars(Real omega, Real timeStep) {
+	mnaCompUpdateTimeStep(omega, timeStep);
 
 	// TODO: check if this is correct or if it should be only computed before the step
 	mEquivCurrent = mEquivCond * **mIntfVoltage + mPrevCurrFac * **mIntfCurrent;
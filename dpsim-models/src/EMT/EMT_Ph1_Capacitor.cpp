@@ -44,10 +44,15 @@ void EMT::Ph1::Capacitor::initializeFromNodesAndTerminals(Real frequency) {
 		initialSingleVoltage(1).real());
 }
 
+Bool EMT::Ph1::Capacitor::mnaCompUpdateTimeStep(Real omega, Real timeStep) {
+	mEquivCond = (2.0 * **mCapacitance) / timeStep;
+	return true;
+}
+
 void EMT::Ph1::Capacitor::mnaCompInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) {
 		updateMatrixNodeIndices();
 
-	mEquivCond = (2.0 * **mCapacitance) / timeStep;
+	mnaCompUpdateTimeStep(omega, timeStep);
 	// Update internal state
 	mEquivCurrent = -(**mIntfCurrent)(0,0) + -mEquivCond * (**mIntfVoltage)(0,0);
 }
@@ -94,6 +99,14 @@ void EMT::Ph1::Capacitor::mnaCompPostStep(Real time, Int timeStepCount, Attribut
 	mnaCompUpdateCurrent(**leftVector);
 }
 
+Bool EMT::Ph1::Capacitor::mnaLinearPhases(std::vector<LinearPhase>& phases) {
+	phases.push_back({ mEquivCond, -mEquivCond, -1.,
+		&(**mIntfVoltage)(0,0), &(**mIntfCurrent)(0,0),
+		terminalNotGrounded(0) ? static_cast<Int>(matrixNodeIndex(0)) : -1,
+		terminalNotGrounded(1) ? static_cast<Int>(matrixNodeIndex(1)) : -1 });
+	return true;
+}
+
 void EMT::Ph1::Capacitor::mnaCompUpdateVoltage(const Matrix& leftVector) {
 	// v1 - v0
 	(**mIntfVoltage)(0,0) = 0;
@@ -44,10 +44,15 @@ void EMT::Ph1::Inductor::initializeFromNodesAndTerminals(Real frequency) {
 		initialSingleVoltage(1).real());
 }
 
+Bool EMT::Ph1::Inductor::mnaCompUpdateTimeStep(Real omega, Real timeStep) {
+	mEquivCond = timeStep / (2.0 * **mInductance);
+	return true;
+}
+
 void EMT::Ph1::Inductor::mnaCompInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) {
 		updateMatrixNodeIndices();
 
-	mEquivCond = timeStep / (2.0 * **mInductance);
+	mnaCompUpdateTimeStep(omega, timeStep);
 	// Update internal state
 	mEquivCurrent = mEquivCond * (**mIntfVoltage)(0,0) + (**mIntfCurrent)(0,0);
 }
@@ -94,6 +99,14 @@ void EMT::Ph1::Inductor::mnaCompPostStep(Real time, Int timeStepCount, Attribute
 	mnaCompUpdateCurrent(**leftVector);
 }
 
+Bool EMT::Ph1::Inductor::mnaLinearPhases(std::vector<LinearPhase>& phases) {
+	phases.push_back({ mEquivCond, mEquivCond, 1.,
+		&(**mIntfVoltage)(0,0), &(**mIntfCurrent)(0,0),
+		terminalNotGrounded(0) ? static_cast<Int>(matrixNodeIndex(0)) : -1,
+		terminalNotGrounded(1) ? static_cast<Int>(matrixNodeIndex(1)) : -1 });
+	return true;
+}
+
 void EMT::Ph1::Inductor::mnaCompUpdateVoltage(const Matrix& leftVector) {
 	// v1 - v0
 	(**mIntfVoltage)(0,0) = 0;
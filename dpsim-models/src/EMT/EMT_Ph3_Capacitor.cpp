@@ -58,9 +58,14 @@ void EMT::Ph3::Capacitor::initializeFromNodesAndTerminals(Real frequency) {
 		Logger::phasorToString(RMS3PH_TO_PEAK1PH * initialSingleVoltage(1)));
 }
 
+Bool EMT::Ph3::Capacitor::mnaCompUpdateTimeStep(Real omega, Real timeStep) {
+	mEquivCond = (2.0 * **mCapacitance) / timeStep;
+	return true;
+}
+
 void EMT::Ph3::Capacitor::mnaCompInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) {
 		updateMatrixNodeIndices();
-	mEquivCond = (2.0 * **mCapacitance) / timeStep;
+	mnaCompUpdateTimeStep(omega, timeStep);
 	// Update internal state
 	mEquivCurrent = - **mIntfCurrent + - mEquivCond * **mIntfVoltage;
 }
@@ -158,6 +163,20 @@ void EMT::Ph3::Capacitor::mnaCompPostStep(Real time, Int timeStepCount, Attribut
 	mnaCompUpdateCurrent(**leftVector);
 }
 
+Bool EMT::Ph3::Capacitor::mnaLinearPhases(std::vector<LinearPhase>& phases) {
+	// Coupled phases can not be updated independently
+	if (!mEquivCond.isDiagonal(0.))
+		return false;
+
+	for (UInt phase = 0; phase < 3; phase++) {
+		phases.push_back({ mEquivCond(phase, phase), -mEquivCond(phase, phase), -1.,
+			&(**mIntfVoltage)(phase, 0), &(**mIntfCurrent)(phase, 0),
+			terminalNotGrounded(0) ? static_cast<Int>(matrixNodeIndex(0, phase)) : -1,
+			terminalNotGrounded(1) ? static_cast<Int>(matrixNodeIndex(1, phase)) : -1 });
+	}
+	return true;
+}
+
 void EMT::Ph3::Capacitor::mnaCompUpdateVoltage(const Matrix& leftVector) {
 	// v1 - v0
 	**mIntfVoltage = Matrix::Zero(3,1);
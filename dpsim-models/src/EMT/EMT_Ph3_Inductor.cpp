@@ -59,10 +59,15 @@ void EMT::Ph3::Inductor::initializeFromNodesAndTerminals(Real frequency) {
 		Logger::phasorToString(RMS3PH_TO_PEAK1PH * initialSingleVoltage(1)));
 }
 
+Bool EMT::Ph3::Inductor::mnaCompUpdateTimeStep(Real omega, Real timeStep) {
+	mEquivCond = timeStep / 2. * (**mInductance).inverse();
+	return true;
+}
+
 void EMT::Ph3::Inductor::mnaCompInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) {
 
 	updateMatrixNodeIndices();
-	mEquivCond = timeStep / 2. * (**mInductance).inverse();
+	mnaCompUpdateTimeStep(omega, timeStep);
 	// Update internal state
 	mEquivCurrent = mEquivCond * **mIntfVoltage + **mIntfCurrent;
 
@@ -173,6 +178,20 @@ void EMT::Ph3::Inductor::mnaCompPostStep(Real time, Int timeStepCount, Attribute
 	mnaCompUpdateCurrent(**leftVector);
 }
 
+Bool EMT::Ph3::Inductor::mnaLinearPhases(std::vector<LinearPhase>& phases) {
+	// Coupled phases can not be updated independently
+	if (!mEquivCond.isDiagonal(0.))
+		return false;
+
+	for (UInt phase = 0; phase < 3; phase++) {
+		phases.push_back({ mEquivCond(phase, phase), mEquivCond(phase, phase), 1.,
+			&(**mIntfVoltage)(phase, 0), &(**mIntfCurrent)(phase, 0),
+			terminalNotGrounded(0) ? static_cast<Int>(matrixNodeIndex(0, phase)) : -1,
+			terminalNotGrounded(1) ? static_cast<Int>(matrixNodeIndex(1, phase)) : -1 });
+	}
+	return true;
+}
+
 void EMT::Ph3::Inductor::mnaCompUpdateVoltage(const Matrix& leftVector) {
 	// v1 - v0
 	**mIntfVoltage = Matrix::Zero(3, 1);
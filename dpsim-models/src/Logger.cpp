@@ -8,6 +8,7 @@
 
 #include <memory>
 #include <iomanip>
+#include <mutex>
 
 #include <spdlog/sinks/null_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
@@ -136,6 +137,11 @@ String Logger::getCSVLineFromData(Real time, const MatrixComp& data) {
 }
 
 Logger::Log Logger::get(const std::string &name, Level filelevel, Level clilevel) {
+	// Components can be created concurrently, e.g. by the CIM reader, and
+	// lookup and creation of a logger with the same name have to be atomic
+	static std::mutex mutex;
+	std::lock_guard<std::mutex> lock(mutex);
+
 	Logger::Log logger = spdlog::get(name);
 
 	if (!logger) {
@@ -1,5 +1,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
+#include <algorithm>
+
 #include <dpsim-models/MNASimPowerComp.h>
 
 using namespace CPS;
@@ -14,6 +16,117 @@ Attribute<Matrix>::Ptr MNASimPowerComp<VarType>::getRightVector() const {
 	return mRightVector;
 }
 
+template<typename VarType>
+Attribute<Matrix>::Ptr MNASimPowerComp<VarType>::getCompactRightVector() const {
+	return mCompactRightVector;
+}
+
+template<typename VarType>
+const std::vector<UInt>& MNASimPowerComp<VarType>::getRightVectorIndices() const {
+	return mRightVectorIndices;
+}
+
+template<typename VarType>
+void MNASimPowerComp<VarType>::mnaSetSparseRightVectorStamping(Bool value) {
+	Bool compact = value && this->mnaCompSupportsCompactRightVector();
+	for (auto subComp : this->mSubComponents) {
+		if (auto mnaSubComp = std::dynamic_pointer_cast<MNASimPowerComp<VarType>>(subComp))
+			mnaSubComp->mnaSetSparseRightVectorStamping(compact);
+	}
+
+	mHasCompactRightVector = compact;
+	if (compact) {
+		// Keep the values stamped during initialization
+		**mCompactRightVector = Matrix::Zero(mRightVectorIndices.size(), 1);
+		updateCompactRightVector();
+	} else {
+		**mCompactRightVector = Matrix();
+	}
+}
+
+template<typename VarType>
+Bool MNASimPowerComp<VarType>::hasCompactRightVector() const {
+	return mHasCompactRightVector;
+}
+
+template<typename VarType>
+void MNASimPowerComp<VarType>::updateCompactRightVector() {
+	const Matrix& stamp = **mRightVector;
+	Matrix& compact = **mCompactRightVector;
+	for (std::size_t k = 0; k < mRightVectorIndices.size(); ++k)
+		compact(k, 0) = stamp(mRightVectorIndices[k], 0);
+
+#ifndef NDEBUG
+	// The solver only reads the compact entries, so a stamp anywhere else would be lost
+	std::size_t k = 0;
+	for (Matrix::Index row = 0; row < stamp.rows(); ++row) {
+		if (k < mRightVectorIndices.size() && mRightVectorIndices[k] == row) {
+			++k;
+			continue;
+		}
+		if (stamp(row, 0) != 0.)
+			throw SystemError("Right vector of " + **this->mName + " has a value at " + std::to_string(row)
+				+ ", which is not one of its right vector indices");
+	}
+#endif
+}
+
+template<typename VarType>
+std::vector<UInt> MNASimPowerComp<VarType>::rightVectorNodeIndices() {
+	std::vector<UInt> nodeIndices;
+	for (auto terminal : this->mTerminals) {
+		if (!terminal || terminal->node()->isGround())
+			continue;
+		auto indices = terminal->node()->matrixNodeIndices();
+		nodeIndices.insert(nodeIndices.end(), indices.begin(), indices.end());
+	}
+	for (auto virtualNode : this->mVirtualNodes) {
+		if (!virtualNode || virtualNode->isGround())
+			continue;
+		auto indices = virtualNode->matrixNodeIndices();
+		nodeIndices.insert(nodeIndices.end(), indices.begin(), indices.end());
+	}
+	for (auto subComp : this->mSubComponents) {
+		auto mnaSubComp = std::dynamic_pointer_cast<MNASimPowerComp<VarType>>(subComp);
+		if (!mnaSubComp)
+			continue;
+		auto indices = mnaSubComp->rightVectorNodeIndices();
+		nodeIndices.insert(nodeIndices.end(), indices.begin(), indices.end());
+	}
+	return nodeIndices;
+}
+
+template<>
+void MNASimPowerComp<Real>::updateRightVectorIndices(Matrix::Index rows, UInt numFreqs) {
+	mRightVectorIndices.clear();
+	for (auto idx : rightVectorNodeIndices()) {
+		if (idx < rows)
+			mRightVectorIndices.push_back(idx);
+	}
+	std::sort(mRightVectorIndices.begin(), mRightVectorIndices.end());
+	mRightVectorIndices.erase(std::unique(mRightVectorIndices.begin(), mRightVectorIndices.end()), mRightVectorIndices.end());
+}
+
+template<>
+void MNASimPowerComp<Complex>::updateRightVectorIndices(Matrix::Index rows, UInt numFreqs) {
+	// Same layout as used by Math::setVectorElement: real parts are followed by imaginary parts
+	// for each frequency
+	Matrix::Index harmonicOffset = rows / numFreqs;
+	Matrix::Index complexOffset = harmonicOffset / 2;
+
+	mRightVectorIndices.clear();
+	for (auto idx : rightVectorNodeIndices()) {
+		if (idx >= complexOffset)
+			continue;
+		for (UInt freq = 0; freq < numFreqs; ++freq) {
+			mRightVectorIndices.push_back(static_cast<UInt>(idx + harmonicOffset * freq));
+			mRightVectorIndices.push_back(static_cast<UInt>(idx + complexOffset + harmonicOffset * freq));
+		}
+	}
+	std::sort(mRightVectorIndices.begin(), mRightVectorIndices.end());
+	mRightVectorIndices.erase(std::unique(mRightVectorIndices.begin(), mRightVectorIndices.end()), mRightVectorIndices.end());
+}
+
 template<typename VarType>
 void MNASimPowerComp<VarType>::mnaInitialize(Real omega, Real timeStep) {
 	mMnaTasks.clear();
@@ -22,6 +135,7 @@ void MNASimPowerComp<VarType>::mnaInitialize(Real omega, Real timeStep) {
 template<typename VarType>
 void MNASimPowerComp<VarType>::mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) {
 	mMnaTasks.clear();
+	mHasCompactRightVector = false;
 	**this->mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
 
 	if (mHasPreStep) {
@@ -32,12 +146,21 @@ void MNASimPowerComp<VarType>::mnaInitialize(Real omega, Real timeStep, Attribut
 	}
 
 	this->mnaCompInitialize(omega, timeStep, leftVector);
+	this->updateRightVectorIndices((**this->mRightVector).rows(), std::max<UInt>(this->mNumFreqs, 1));
+}
+
+template<typename VarType>
+Bool MNASimPowerComp<VarType>::mnaUpdateTimeStep(Real omega, Real timeStep) {
+	return this->mnaCompUpdateTimeStep(omega, timeStep);
 }
 
 template<typename VarType>
 void MNASimPowerComp<VarType>::mnaInitializeHarm(Real omega, Real timeStep, std::vector<Attribute<Matrix>::Ptr> leftVector) {
 	mMnaTasks.clear();
+	mHasCompactRightVector = false;
 	this->mnaCompInitializeHarm(omega, timeStep, leftVector);
+	// Each column of the right vector holds one frequency
+	this->updateRightVectorIndices((**this->mRightVector).rows(), 1);
 }
 
 template<typename VarType>
@@ -64,6 +187,8 @@ void MNASimPowerComp<VarType>::mnaUpdateCurrent(const Matrix& leftVector) {
 template<typename VarType>
 void MNASimPowerComp<VarType>::mnaPreStep(Real time, Int timeStepCount) {
 	this->mnaCompPreStep(time, timeStepCount);
+	if (mHasCompactRightVector)
+		updateCompactRightVector();
 };
 
 template<typename VarType>
@@ -101,6 +226,16 @@ void MNASimPowerComp<VarType>::mnaCompInitialize(Real omega, Real timeStep, Attr
 	// Empty default implementation. Can be overridden by child classes if desired.
 }
 
+template<typename VarType>
+Bool MNASimPowerComp<VarType>::mnaCompUpdateTimeStep(Real omega, Real timeStep) {
+	return false;
+}
+
+template<typename VarType>
+Bool MNASimPowerComp<VarType>::mnaCompSupportsCompactRightVector() {
+	return true;
+}
+
 template<typename VarType>
 void MNASimPowerComp<VarType>::mnaCompApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	// Empty default implementation. Can be overridden by child classes if desired.
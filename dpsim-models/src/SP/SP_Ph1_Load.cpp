@@ -10,6 +10,16 @@
 
 using namespace CPS;
 
+/// Profile entry closest to the given time. The profile times and the simulation
+/// times can be computed in different ways and differ by rounding errors.
+template <typename T>
+static const T& profileEntry(const std::map<Real, T>& profile, Real time) {
+	auto entry = profile.lower_bound(time);
+	if (entry == profile.end() || (entry != profile.begin() && time - std::prev(entry)->first < entry->first - time))
+		--entry;
+	return entry->second;
+}
+
 // #### General ####
 // please note that P,Q values can not be passed inside constructor since P,Q are currently read from the terminal,
 // and these values are not yet assigned to the terminals when this constructor was called in reader.
@@ -77,10 +87,11 @@ void SP::Ph1::Load::modifyPowerFlowBusType(PowerflowBusType powerflowBusType) {
 
 void SP::Ph1::Load::updatePQ(Real time) {
 	if (mLoadProfile.weightingFactors.empty()) {
-		**mActivePower = mLoadProfile.pqData.find(time)->second.p;
-		**mReactivePower = mLoadProfile.pqData.find(time)->second.q;
+		const PQData& pq = profileEntry(mLoadProfile.pqData, time);
+		**mActivePower = pq.p;
+		**mReactivePower = pq.q;
 	} else {
-		Real wf = mLoadProfile.weightingFactors.find(time)->second;
+		Real wf = profileEntry(mLoadProfile.weightingFactors, time);
 		///THISISBAD: P_nom and Q_nom do not exist as attributes
 		Real P_new = this->attributeTyped<Real>("P_nom")->get()*wf;
 		Real Q_new = this->attributeTyped<Real>("Q_nom")->get()*wf;
@@ -35,6 +35,8 @@ void SP::Ph1::SynchronGenerator::setParameters(Real ratedApparentPower, Real rat
 	SPDLOG_LOGGER_INFO(mSLog, "Rated Apparent Power={} [VA] Rated Voltage={} [V]", ratedApparentPower, ratedVoltage);
     SPDLOG_LOGGER_INFO(mSLog, "Active Power Set Point={} [W] Voltage Set Point={} [V]", **mSetPointActivePower, **mSetPointVoltage);
 	mSLog->flush();
+
+	mParametersSet = true;
 }
 
 // #### Powerflow section ####
@@ -0,0 +1,475 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
+
+#include <dpsim-models/TopologySnapshot.h>
+#include <dpsim-models/SP/SP_Ph1_PiLine.h>
+#include <dpsim-models/SP/SP_Ph1_Transformer.h>
+#include <dpsim-models/SP/SP_Ph1_Load.h>
+#include <dpsim-models/SP/SP_Ph1_NetworkInjection.h>
+#include <dpsim-models/SP/SP_Ph1_Shunt.h>
+#include <dpsim-models/SP/SP_Ph1_SynchronGenerator.h>
+
+using namespace CPS;
+
+namespace {
+	const char MAGIC[8] = { 'D', 'P', 'S', 'I', 'M', 'T', 'O', 'P' };
+
+	enum class ComponentType : std::uint8_t {
+		PiLine, Transformer, Load, NetworkInjection, Shunt, SynchronGenerator, Unsupported
+	};
+
+	/// Exact type of the component, derived classes are not supported
+	ComponentType componentType(const IdentifiedObject &comp) {
+		const std::type_info &type = typeid(comp);
+		if (type == typeid(SP::Ph1::PiLine)) return ComponentType::PiLine;
+		if (type == typeid(SP::Ph1::Transformer)) return ComponentType::Transformer;
+		if (type == typeid(SP::Ph1::Load)) return ComponentType::Load;
+		if (type == typeid(SP::Ph1::NetworkInjection)) return ComponentType::NetworkInjection;
+		if (type == typeid(SP::Ph1::Shunt)) return ComponentType::Shunt;
+		if (type == typeid(SP::Ph1::SynchronGenerator)) return ComponentType::SynchronGenerator;
+		return ComponentType::Unsupported;
+	}
+
+	/// Thrown if a snapshot ends early or contains invalid data
+	class DamagedSnapshot { };
+
+	/// Appends values in native byte order to a buffer
+	class BufferWriter {
+	public:
+		template<typename T>
+		void put(const T &value) {
+			static_assert(std::is_trivially_copyable<T>::value, "Only plain values can be written");
+			putBytes(reinterpret_cast<const char*>(&value), sizeof(T));
+		}
+		void putBytes(const char *data, std::size_t size) {
+			mBuffer.insert(mBuffer.end(), data, data + size);
+		}
+		void putString(const String &str) {
+			put<std::uint32_t>(static_cast<std::uint32_t>(str.size()));
+			putBytes(str.data(), str.size());
+		}
+		void putMatrix(const MatrixComp &mat) {
+			put<std::uint32_t>(static_cast<std::uint32_t>(mat.rows()));
+			put<std::uint32_t>(static_cast<std::uint32_t>(mat.cols()));
+			for (Int col = 0; col < mat.cols(); ++col) {
+				for (Int row = 0; row < mat.rows(); ++row)
+					put<Complex>(mat(row, col));
+			}
+		}
+		const std::vector<char>& buffer() const { return mBuffer; }
+
+	private:
+		std::vector<char> mBuffer;
+	};
+
+	/// Reads values from a buffer that has been read in one piece
+	class BufferReader {
+	public:
+		BufferReader(const std::vector<char> &buffer) : mBuffer(buffer) { }
+
+		template<typename T>
+		T get() {
+			static_assert(std::is_trivially_copyable<T>::value, "Only plain values can be read");
+			T value;
+			std::memcpy(&value, take(sizeof(T)), sizeof(T));
+			return value;
+		}
+		const char* take(std::size_t size) {
+			if (size > mBuffer.size() - mPos)
+				throw DamagedSnapshot();
+			const char *data = mBuffer.data() + mPos;
+			mPos += size;
+			return data;
+		}
+		String getString() {
+			std::uint32_t size = get<std::uint32_t>();
+			return String(take(size), size);
+		}
+		MatrixComp getMatrix() {
+			std::uint32_t rows = get<std::uint32_t>();
+			std::uint32_t cols = get<std::uint32_t>();
+			if (static_cast<std::size_t>(rows) * cols * sizeof(Complex) > mBuffer.size() - mPos)
+				throw DamagedSnapshot();
+			MatrixComp mat(rows, cols);
+			for (std::uint32_t col = 0; col < cols; ++col) {
+				for (std::uint32_t row = 0; row < rows; ++row)
+					mat(row, col) = get<Complex>();
+			}
+			return mat;
+		}
+		Bool atEnd() const { return mPos == mBuffer.size(); }
+
+	private:
+		const std::vector<char> &mBuffer;
+		std::size_t mPos = 0;
+	};
+
+	/// 64 bit FNV-1a hash
+	class Hash {
+	public:
+		void update(const char *data, std::size_t size) {
+			for (std::size_t i = 0; i < size; ++i) {
+				mValue ^= static_cast<unsigned char>(data[i]);
+				mValue *= 0x100000001b3ULL;
+			}
+		}
+		template<typename T>
+		void update(const T &value) {
+			update(reinterpret_cast<const char*>(&value), sizeof(T));
+		}
+		std::uint64_t value() const { return mValue; }
+
+	private:
+		std::uint64_t mValue = 0xcbf29ce484222325ULL;
+	};
+}
+
+TopologySnapshot::TopologySnapshot(String name, Logger::Level logLevel) :
+	mSLog(Logger::get(name, logLevel)) {
+}
+
+String TopologySnapshot::contentKey(const std::list<fs::path> &filenames, const String &settings) {
+	Hash hash;
+	hash.update(static_cast<std::uint32_t>(FORMAT_VERSION));
+	hash.update(settings.size());
+	hash.update(settings.data(), settings.size());
+
+	std::vector<char> chunk(1 << 20);
+	for (auto &filename : filenames) {
+		std::ifstream file(filename.string(), std::ios::binary);
+		if (!file)
+			throw SystemError("Cannot read " + filename.string());
+
+		std::uint64_t size = 0;
+		while (file) {
+			file.read(chunk.data(), chunk.size());
+			std::size_t count = static_cast<std::size_t>(file.gcount());
+			hash.update(chunk.data(), count);
+			size += count;
+		}
+		// The sizes separate the files, so that moving data between files changes the key
+		hash.update(size);
+	}
+
+	std::ostringstream key;
+	key << std::hex << std::setw(16) << std::setfill('0') << hash.value();
+	return key.str();
+}
+
+Bool TopologySnapshot::isSupported(const SystemTopology &system) {
+	for (auto &node : system.mNodes) {
+		auto simNode = std::dynamic_pointer_cast<SimNode<Complex>>(node);
+		if (!simNode || simNode->phaseType() != PhaseType::Single) {
+			SPDLOG_LOGGER_INFO(mSLog, "Node {} is not supported in snapshots", node ? node->name() : "<none>");
+			return false;
+		}
+	}
+	for (auto &comp : system.mComponents) {
+		if (componentType(*comp) == ComponentType::Unsupported) {
+			SPDLOG_LOGGER_INFO(mSLog, "Component {} of type {} is not supported in snapshots", comp->name(), comp->type());
+			return false;
+		}
+		auto powerComp = std::dynamic_pointer_cast<SimPowerComp<Complex>>(comp);
+		if (powerComp->terminalNumberConnected() < powerComp->terminalNumber()) {
+			SPDLOG_LOGGER_INFO(mSLog, "Component {} is not fully connected", comp->name());
+			return false;
+		}
+	}
+	return true;
+}
+
+Bool TopologySnapshot::write(const SystemTopology &system, const fs::path &filename, const String &key) {
+	if (!isSupported(system))
+		return false;
+
+	BufferWriter out;
+	out.putBytes(MAGIC, sizeof(MAGIC));
+	out.put<std::uint32_t>(static_cast<std::uint32_t>(FORMAT_VERSION));
+	out.putString(key);
+	out.put<Real>(system.mSystemFrequency);
+
+	std::unordered_map<const TopologicalNode*, Int> nodeIndices;
+	out.put<std::uint32_t>(static_cast<std::uint32_t>(system.mNodes.size()));
+	for (UInt i = 0; i < system.mNodes.size(); ++i) {
+		auto node = std::dynamic_pointer_cast<SimNode<Complex>>(system.mNodes[i]);
+		nodeIndices[node.get()] = static_cast<Int>(i);
+		out.putString(node->uid());
+		out.putString(node->name());
+		out.put<std::uint32_t>(node->matrixNodeIndex());
+		out.putMatrix(node->initialVoltage());
+	}
+
+	out.put<std::uint32_t>(static_cast<std::uint32_t>(system.mComponents.size()));
+	for (auto &comp : system.mComponents) {
+		auto powerComp = std::dynamic_pointer_cast<SimPowerComp<Complex>>(comp);
+		ComponentType type = componentType(*comp);
+		PowerflowBusType busType = PowerflowBusType::None;
+		std::vector<Real> params;
+
+		switch (type) {
+		case ComponentType::PiLine: {
+			auto line = std::dynamic_pointer_cast<SP::Ph1::PiLine>(comp);
+			params = { **line->mSeriesRes, **line->mSeriesInd, **line->mParallelCap, **line->mParallelCond, **line->mBaseVoltage };
+			break;
+		}
+		case ComponentType::Transformer: {
+			auto trafo = std::dynamic_pointer_cast<SP::Ph1::Transformer>(comp);
+			params = { **trafo->mNominalVoltageEnd1, **trafo->mNominalVoltageEnd2, **trafo->mRatedPower,
+				std::abs(**trafo->mRatio), std::arg(**trafo->mRatio), **trafo->mResistance, **trafo->mInductance,
+				**trafo->mBaseVoltage };
+			break;
+		}
+		case ComponentType::Load: {
+			auto load = std::dynamic_pointer_cast<SP::Ph1::Load>(comp);
+			params = { **load->mActivePower, **load->mReactivePower, **load->mNomVoltage };
+			busType = load->mPowerflowBusType;
+			break;
+		}
+		case ComponentType::NetworkInjection: {
+			auto extnet = std::dynamic_pointer_cast<SP::Ph1::NetworkInjection>(comp);
+			params = { **extnet->mVoltageSetPoint, extnet->baseVoltage() };
+			busType = extnet->mPowerflowBusType;
+			break;
+		}
+		case ComponentType::Shunt: {
+			auto shunt = std::dynamic_pointer_cast<SP::Ph1::Shunt>(comp);
+			params = { **shunt->mConductance, **shunt->mSusceptance, shunt->baseVoltage() };
+			break;
+		}
+		case ComponentType::SynchronGenerator: {
+			auto gen = std::dynamic_pointer_cast<SP::Ph1::SynchronGenerator>(comp);
+			params = { **gen->mSetPointActivePower, **gen->mSetPointReactivePower, **gen->mSetPointVoltage, **gen->mBaseVoltage };
+			if (gen->parametersSet())
+				busType = gen->mPowerflowBusType;
+			break;
+		}
+		default:
+			return false;
+		}
+
+		out.put<std::uint8_t>(static_cast<std::uint8_t>(type));
+		out.putString(comp->uid());
+		out.putString(comp->name());
+		out.put<std::uint8_t>(powerComp->parametersSet());
+		// The bus type is not initialized by all component constructors
+		if (busType != PowerflowBusType::PV && busType != PowerflowBusType::PQ && busType != PowerflowBusType::VD)
+			busType = PowerflowBusType::None;
+		out.put<std::uint8_t>(static_cast<std::uint8_t>(busType));
+		out.put<std::uint32_t>(static_cast<std::uint32_t>(params.size()));
+		for (Real param : params)
+			out.put<Real>(param);
+
+		out.put<std::uint32_t>(powerComp->terminalNumber());
+		for (UInt t = 0; t < powerComp->terminalNumber(); ++t) {
+			auto terminal = powerComp->terminal(t);
+			auto node = terminal->node();
+			auto search = nodeIndices.find(node.get());
+			out.putString(terminal->uid());
+			out.put<std::int32_t>(search != nodeIndices.end() ? search->second : -1);
+			out.putMatrix(terminal->power());
+		}
+	}
+
+	// Write to a temporary file first, concurrent runs only see complete snapshots.
+	// A failure to store the snapshot is never fatal, so no filesystem errors are thrown.
+	std::error_code ec;
+	if (filename.has_parent_path() && !fs::exists(filename.parent_path(), ec)) {
+		fs::create_directories(filename.parent_path(), ec);
+		if (ec) {
+			SPDLOG_LOGGER_WARN(mSLog, "Failed to create snapshot directory {}: {}", filename.parent_path(), ec.message());
+			return false;
+		}
+	}
+	fs::path tempname = filename.string() + ".tmp" + std::to_string(std::random_device()());
+	{
+		std::ofstream file(tempname.string(), std::ios::binary | std::ios::trunc);
+		file.write(out.buffer().data(), static_cast<std::streamsize>(out.buffer().size()));
+		if (!file) {
+			SPDLOG_LOGGER_WARN(mSLog, "Failed to write snapshot {}", tempname);
+			file.close();
+			fs::remove(tempname, ec);
+			return false;
+		}
+	}
+	fs::rename(tempname, filename, ec);
+	if (ec) {
+		SPDLOG_LOGGER_WARN(mSLog, "Failed to replace snapshot {}: {}", filename, ec.message());
+		fs::remove(tempname, ec);
+		return false;
+	}
+
+	SPDLOG_LOGGER_INFO(mSLog, "Wrote snapshot {} with {} nodes and {} components ({} bytes)",
+		filename, system.mNodes.size(), system.mComponents.size(), out.buffer().size());
+	return true;
+}
+
+Bool TopologySnapshot::read(const fs::path &filename, const String &key, SystemTopology &system, Logger::Level componentLogLevel) {
+	std::ifstream file(filename.string(), std::ios::binary | std::ios::ate);
+	if (!file)
+		return false;
+
+	// The snapshot is read in one piece and decoded from memory
+	std::vector<char> buffer(static_cast<std::size_t>(file.tellg()));
+	file.seekg(0);
+	file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+	if (!file) {
+		SPDLOG_LOGGER_WARN(mSLog, "Failed to read snapshot {}", filename);
+		return false;
+	}
+
+	try {
+		BufferReader in(buffer);
+		if (std::memcmp(in.take(sizeof(MAGIC)), MAGIC, sizeof(MAGIC)) != 0)
+			throw DamagedSnapshot();
+		std::uint32_t version = in.get<std::uint32_t>();
+		if (version != FORMAT_VERSION) {
+			SPDLOG_LOGGER_INFO(mSLog, "Ignoring snapshot {} with format version {}", filename, version);
+			return false;
+		}
+		if (in.getString() != key) {
+			SPDLOG_LOGGER_INFO(mSLog, "Ignoring snapshot {} written for other source files", filename);
+			return false;
+		}
+
+		SystemTopology result(in.get<Real>());
+
+		std::uint32_t numNodes = in.get<std::uint32_t>();
+		SimNode<Complex>::List nodes;
+		for (std::uint32_t i = 0; i < numNodes; ++i) {
+			String uid = in.getString();
+			String name = in.getString();
+			std::uint32_t matrixNodeIndex = in.get<std::uint32_t>();
+			auto node = SimNode<Complex>::make(uid, name, matrixNodeIndex, PhaseType::Single);
+			node->setInitialVoltage(in.getMatrix());
+			nodes.push_back(node);
+		}
+		result.mNodes.resize(numNodes);
+		for (std::uint32_t i = 0; i < numNodes; ++i)
+			result.addNodeAt(nodes[i], i);
+
+		std::uint32_t numComps = in.get<std::uint32_t>();
+		for (std::uint32_t c = 0; c < numComps; ++c) {
+			ComponentType type = static_cast<ComponentType>(in.get<std::uint8_t>());
+			String uid = in.getString();
+			String name = in.getString();
+			Bool parametersSet = in.get<std::uint8_t>() != 0;
+			std::uint8_t busTypeValue = in.get<std::uint8_t>();
+			if (busTypeValue > static_cast<std::uint8_t>(PowerflowBusType::None))
+				throw DamagedSnapshot();
+			PowerflowBusType busType = static_cast<PowerflowBusType>(busTypeValue);
+			std::vector<Real> params(in.get<std::uint32_t>());
+			for (auto &param : params)
+				param = in.get<Real>();
+
+			auto expectParams = [&params](std::size_t count) {
+				if (params.size() != count)
+					throw DamagedSnapshot();
+			};
+
+			SimPowerComp<Complex>::Ptr comp;
+			switch (type) {
+			case ComponentType::PiLine: {
+				expectParams(5);
+				auto line = std::make_shared<SP::Ph1::PiLine>(uid, name, componentLogLevel);
+				if (parametersSet)
+					line->setParameters(params[0], params[1], params[2], params[3]);
+				line->setBaseVoltage(params[4]);
+				comp = line;
+				break;
+			}
+			case ComponentType::Transformer: {
+				expectParams(8);
+				auto trafo = std::make_shared<SP::Ph1::Transformer>(uid, name, componentLogLevel);
+				if (parametersSet)
+					trafo->setParameters(params[0], params[1], params[2], params[3], params[4], params[5], params[6]);
+				trafo->setBaseVoltage(params[7]);
+				comp = trafo;
+				break;
+			}
+			case ComponentType::Load: {
+				expectParams(3);
+				auto load = std::make_shared<SP::Ph1::Load>(uid, name, componentLogLevel);
+				if (parametersSet)
+					load->setParameters(params[0], params[1], params[2]);
+				if (busType == PowerflowBusType::PQ)
+					load->modifyPowerFlowBusType(busType);
+				comp = load;
+				break;
+			}
+			case ComponentType::NetworkInjection: {
+				expectParams(2);
+				auto extnet = std::make_shared<SP::Ph1::NetworkInjection>(uid, name, componentLogLevel);
+				extnet->modifyPowerFlowBusType(busType);
+				extnet->setBaseVoltage(params[1]);
+				if (parametersSet)
+					extnet->setParameters(params[0]);
+				comp = extnet;
+				break;
+			}
+			case ComponentType::Shunt: {
+				expectParams(3);
+				auto shunt = std::make_shared<SP::Ph1::Shunt>(uid, name, componentLogLevel);
+				if (parametersSet)
+					shunt->setParameters(params[0], params[1]);
+				shunt->setBaseVoltage(params[2]);
+				comp = shunt;
+				break;
+			}
+			case ComponentType::SynchronGenerator: {
+				expectParams(4);
+				auto gen = std::make_shared<SP::Ph1::SynchronGenerator>(uid, name, componentLogLevel);
+				// The rated values are not stored by the generator and only used for logging
+				if (parametersSet)
+					gen->setParameters(0, 0, params[0], params[2], busType, params[1]);
+				gen->setBaseVoltage(params[3]);
+				comp = gen;
+				break;
+			}
+			default:
+				throw DamagedSnapshot();
+			}
+
+			std::uint32_t numTerminals = in.get<std::uint32_t>();
+			if (numTerminals != comp->terminalNumber())
+				throw DamagedSnapshot();
+			for (std::uint32_t t = 0; t < numTerminals; ++t) {
+				auto terminal = SimTerminal<Complex>::make(in.getString());
+				Int nodeIndex = in.get<std::int32_t>();
+				if (nodeIndex >= static_cast<Int>(numNodes))
+					throw DamagedSnapshot();
+				terminal->setNode(nodeIndex < 0 ? SimNode<Complex>::GND : nodes[nodeIndex]);
+				terminal->setPower(in.getMatrix());
+				comp->setTerminalAt(terminal, t);
+			}
+			result.addComponent(comp);
+		}
+		if (!in.atEnd())
+			throw DamagedSnapshot();
+
+		result.componentsAtNodeList();
+		system = result;
+	}
+	catch (DamagedSnapshot&) {
+		SPDLOG_LOGGER_WARN(mSLog, "Ignoring damaged snapshot {}", filename);
+		return false;
+	}
+
+	SPDLOG_LOGGER_INFO(mSLog, "Read snapshot {} with {} nodes and {} components",
+		filename, system.mNodes.size(), system.mComponents.size());
+	return true;
+}
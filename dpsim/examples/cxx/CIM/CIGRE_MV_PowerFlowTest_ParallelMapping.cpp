@@ -0,0 +1,103 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <iostream>
+
+#include <dpsim-models/CIM/Reader.h>
+#include <DPsim.h>
+
+using namespace std;
+using namespace DPsim;
+using namespace CPS;
+using namespace CPS::CIM;
+
+/*
+ * This example maps the CIGRE MV benchmark system to components on one and on
+ * several threads. Both topologies have to contain the same nodes and components
+ * in the same order and yield the same power flow solution.
+ */
+
+std::vector<Complex> solvePowerflow(SystemTopology &system, const String &simName) {
+	Simulation sim(simName, Logger::Level::off);
+	sim.setSystem(system);
+	sim.setTimeStep(1);
+	sim.setFinalTime(1);
+	sim.setDomain(Domain::SP);
+	sim.setSolverType(Solver::Type::NRP);
+	sim.setSolverAndComponentBehaviour(Solver::Behaviour::Simulation);
+	sim.doInitFromNodesAndTerminals(true);
+	sim.run();
+
+	std::vector<Complex> voltages;
+	for (auto node : system.mNodes)
+		voltages.push_back(std::dynamic_pointer_cast<SimNode<Complex>>(node)->singleVoltage());
+	return voltages;
+}
+
+int main(int argc, char** argv){
+
+	// Find CIM files
+	std::list<fs::path> filenames;
+	if (argc <= 1) {
+		filenames = DPsim::Utils::findFiles({
+			"Rootnet_FULL_NE_06J16h_DI.xml",
+			"Rootnet_FULL_NE_06J16h_EQ.xml",
+			"Rootnet_FULL_NE_06J16h_SV.xml",
+			"Rootnet_FULL_NE_06J16h_TP.xml"
+		}, "build/_deps/cim-data-src/CIGRE_MV/NEPLAN/CIGRE_MV_no_tapchanger_With_LoadFlow_Results", "CIMPATH");
+	}
+	else {
+		filenames = std::list<fs::path>(argv + 1, argv + argc);
+	}
+
+	String simName = "CIGRE_MV_PowerFlowTest_ParallelMapping";
+	Logger::setLogDir("logs/" + simName);
+	CPS::Real system_freq = 50;
+
+	CIM::Reader sequentialReader(simName + "_Sequential", Logger::Level::info, Logger::Level::off);
+	sequentialReader.setNumThreads(1);
+	SystemTopology sequential = sequentialReader.loadCIM(system_freq, filenames, CPS::Domain::SP);
+
+	CIM::Reader parallelReader(simName + "_Parallel", Logger::Level::info, Logger::Level::off);
+	parallelReader.setNumThreads(4);
+	SystemTopology parallel = parallelReader.loadCIM(system_freq, filenames, CPS::Domain::SP);
+
+	int failures = 0;
+	if (sequential.mNodes.size() != parallel.mNodes.size() || sequential.mComponents.size() != parallel.mComponents.size()) {
+		std::cerr << "Parallel mapping gives " << parallel.mNodes.size() << " nodes and " << parallel.mComponents.size()
+			<< " components instead of " << sequential.mNodes.size() << " and " << sequential.mComponents.size() << std::endl;
+		return 1;
+	}
+	for (UInt i = 0; i < sequential.mNodes.size(); ++i) {
+		if (sequential.mNodes[i]->name() != parallel.mNodes[i]->name()) {
+			std::cerr << "Node " << i << " is " << parallel.mNodes[i]->name() << " instead of "
+				<< sequential.mNodes[i]->name() << std::endl;
+			++failures;
+		}
+	}
+	auto component = parallel.mComponents.begin();
+	for (auto reference : sequential.mComponents) {
+		if (reference->name() != (*component)->name() || reference->type() != (*component)->type()) {
+			std::cerr << "Component " << (*component)->name() << " is mapped in place of "
+				<< reference->name() << std::endl;
+			++failures;
+		}
+		++component;
+	}
+
+	auto sequentialVoltages = solvePowerflow(sequential, simName + "_SequentialPF");
+	auto parallelVoltages = solvePowerflow(parallel, simName + "_ParallelPF");
+	for (UInt i = 0; i < sequentialVoltages.size(); ++i) {
+		if (sequentialVoltages[i] != parallelVoltages[i]) {
+			std::cerr << "Voltage of node " << sequential.mNodes[i]->name() << " differs by "
+				<< std::abs(sequentialVoltages[i] - parallelVoltages[i]) << std::endl;
+			++failures;
+		}
+	}
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,104 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <iostream>
+
+#include <dpsim-models/CIM/Reader.h>
+#include <DPsim.h>
+
+using namespace std;
+using namespace DPsim;
+using namespace CPS;
+using namespace CPS::CIM;
+
+/*
+ * This example loads the IEEE LV benchmark system twice with a snapshot directory.
+ * The first load parses the CIM files and stores a snapshot, the second load reads
+ * the snapshot. Both topologies have to yield the same power flow solution.
+ */
+
+std::vector<Complex> solvePowerflow(SystemTopology &system, const String &simName) {
+	Simulation sim(simName, Logger::Level::off);
+	sim.setSystem(system);
+	sim.setTimeStep(1);
+	sim.setFinalTime(1);
+	sim.setDomain(Domain::SP);
+	sim.setSolverType(Solver::Type::NRP);
+	sim.setSolverAndComponentBehaviour(Solver::Behaviour::Simulation);
+	sim.doInitFromNodesAndTerminals(true);
+	sim.run();
+
+	std::vector<Complex> voltages;
+	for (auto node : system.mNodes)
+		voltages.push_back(std::dynamic_pointer_cast<SimNode<Complex>>(node)->singleVoltage());
+	return voltages;
+}
+
+int main(int argc, char** argv){
+
+	// Find CIM files
+	std::list<fs::path> filenames;
+	if (argc <= 1) {
+		filenames = DPsim::Utils::findFiles({
+			"Rootnet_FULL_NE_13J16h_DI.xml",
+			"Rootnet_FULL_NE_13J16h_EQ.xml",
+			"Rootnet_FULL_NE_13J16h_SV.xml",
+			"Rootnet_FULL_NE_13J16h_TP.xml"
+		}, "build/_deps/cim-data-src/IEEE_EU_LV/IEEE_EU_LV_reduced", "CIMPATH");
+	}
+	else {
+		filenames = std::list<fs::path>(argv + 1, argv + argc);
+	}
+
+	String simName = "IEEE_LV_PowerFlowTest_Snapshot";
+	Logger::setLogDir("logs/" + simName);
+	fs::path snapshotDir = "logs/" + simName + "/snapshots";
+	fs::remove_all(snapshotDir);
+	CPS::Real system_freq = 50;
+
+	CIM::Reader parsingReader(simName + "_Parse", Logger::Level::info, Logger::Level::off);
+	parsingReader.setSnapshotDirectory(snapshotDir);
+	SystemTopology parsed = parsingReader.loadCIM(system_freq, filenames, CPS::Domain::SP);
+
+	// Other domains are never stored as snapshot
+	CIM::Reader dpReader(simName + "_DP", Logger::Level::info, Logger::Level::off);
+	dpReader.setSnapshotDirectory(snapshotDir);
+	dpReader.loadCIM(system_freq, filenames, CPS::Domain::DP);
+
+	UInt numSnapshots = 0;
+	for (auto &entry : fs::directory_iterator(snapshotDir)) {
+		if (entry.path().extension() == ".snapshot")
+			++numSnapshots;
+	}
+	if (numSnapshots != 1) {
+		std::cerr << "Expected one snapshot, found " << numSnapshots << std::endl;
+		return 1;
+	}
+
+	CIM::Reader snapshotReader(simName + "_Snapshot", Logger::Level::info, Logger::Level::off);
+	snapshotReader.setSnapshotDirectory(snapshotDir);
+	SystemTopology restored = snapshotReader.loadCIM(system_freq, filenames, CPS::Domain::SP);
+
+	auto parsedVoltages = solvePowerflow(parsed, simName + "_Parsed");
+	auto restoredVoltages = solvePowerflow(restored, simName + "_Restored");
+	if (parsedVoltages.size() != restoredVoltages.size()) {
+		std::cerr << "Restored topology has " << restoredVoltages.size() << " instead of "
+			<< parsedVoltages.size() << " nodes" << std::endl;
+		return 1;
+	}
+
+	int failures = 0;
+	for (UInt i = 0; i < parsedVoltages.size(); ++i) {
+		Real diff = std::abs(parsedVoltages[i] - restoredVoltages[i]);
+		if (diff > 1e-9 * std::abs(parsedVoltages[i])) {
+			std::cerr << "Voltage of node " << parsed.mNodes[i]->name() << " differs by " << diff << std::endl;
+			++failures;
+		}
+	}
+	return failures == 0 ? 0 : 1;
+}
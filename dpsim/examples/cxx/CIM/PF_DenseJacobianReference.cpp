@@ -0,0 +1,150 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <iostream>
+
+#include <dpsim-models/CIM/Reader.h>
+#include <DPsim.h>
+#include <dpsim/PFSolverPowerPolar.h>
+
+using namespace DPsim;
+using namespace CPS;
+using namespace CPS::CIM;
+
+/*
+ * Solves the power flow of the CIGRE MV and the IEEE LV benchmark systems with
+ * the sparse Newton-Raphson solver, with and without reuse of the Jacobian, and
+ * with a dense reference. The reference computes the full Jacobian by central
+ * differences of the mismatch, so it does not depend on the sparse assembly.
+ * All solutions have to agree.
+ */
+
+/// Newton-Raphson with a dense Jacobian computed by finite differences
+class DenseReferenceSolver : public PFSolverPowerPolar {
+public:
+	using PFSolverPowerPolar::PFSolverPowerPolar;
+
+	void solve() {
+		initialize();
+		getTasks().front()->execute(0, 0);
+	}
+
+protected:
+	Bool solvePowerflow() override {
+		const Real h = 1e-7;
+		calculateMismatch();
+		isConverged = checkConvergence();
+
+		mIterations = 0;
+		for (UInt i = 1; i < 2 * mMaxIterations && !isConverged; ++i) {
+			Vector voltages = sol_V, angles = sol_D;
+			Matrix jacobian(mNumUnknowns, mNumUnknowns);
+			for (UInt col = 0; col < mNumUnknowns; ++col) {
+				Vector mismatch[2];
+				for (Int side = 0; side < 2; ++side) {
+					mX.setZero();
+					mX(col) = side == 0 ? h : -h;
+					updateSolution();
+					calculateMismatch();
+					mismatch[side] = mF;
+					sol_V = voltages;
+					sol_D = angles;
+				}
+				// The mismatch is the specified minus the calculated power
+				jacobian.col(col) = (mismatch[1] - mismatch[0]) / (2 * h);
+			}
+			calculateMismatch();
+
+			mX = jacobian.partialPivLu().solve(mF);
+			updateSolution();
+			calculateMismatch();
+			isConverged = checkConvergence();
+			mIterations = i;
+		}
+		return isConverged;
+	}
+};
+
+std::vector<Complex> nodeVoltages(const SystemTopology& system) {
+	std::vector<Complex> voltages;
+	for (auto node : system.mNodes)
+		voltages.push_back(std::dynamic_pointer_cast<SimNode<Complex>>(node)->singleVoltage());
+	return voltages;
+}
+
+std::vector<Complex> solveSparse(const std::list<fs::path>& filenames, const String& simName, Bool reuse) {
+	CIM::Reader reader(simName, Logger::Level::info, Logger::Level::off);
+	SystemTopology system = reader.loadCIM(50, filenames, CPS::Domain::SP);
+
+	Simulation sim(simName, Logger::Level::off);
+	sim.setSystem(system);
+	sim.setTimeStep(1);
+	sim.setFinalTime(1);
+	sim.setDomain(Domain::SP);
+	sim.setSolverType(Solver::Type::NRP);
+	sim.setSolverAndComponentBehaviour(Solver::Behaviour::Simulation);
+	sim.doInitFromNodesAndTerminals(true);
+	sim.doPowerflowJacobianReuse(reuse);
+	sim.run();
+	return nodeVoltages(system);
+}
+
+std::vector<Complex> solveDense(const std::list<fs::path>& filenames, const String& simName) {
+	CIM::Reader reader(simName, Logger::Level::info, Logger::Level::off);
+	SystemTopology system = reader.loadCIM(50, filenames, CPS::Domain::SP);
+
+	DenseReferenceSolver solver(simName, system, 1, Logger::Level::off);
+	solver.doInitFromNodesAndTerminals(true);
+	solver.setSolverAndComponentBehaviour(Solver::Behaviour::Simulation);
+	solver.solve();
+	return nodeVoltages(system);
+}
+
+int compare(const String& name, const std::vector<Complex>& reference, const std::vector<Complex>& voltages) {
+	int failures = 0;
+	for (UInt i = 0; i < reference.size(); ++i) {
+		Real diff = std::abs(voltages[i] - reference[i]);
+		if (diff > 1e-6 * std::abs(reference[i])) {
+			std::cerr << name << ": voltage of node " << i << " differs by " << diff << " V" << std::endl;
+			++failures;
+		}
+	}
+	return failures;
+}
+
+int check(const String& grid, const std::list<fs::path>& filenames) {
+	String simName = "PF_DenseJacobianReference_" + grid;
+	auto reference = solveDense(filenames, simName + "_Dense");
+	int failures = compare(grid + " sparse", reference, solveSparse(filenames, simName + "_Sparse", false));
+	failures += compare(grid + " sparse with reuse", reference, solveSparse(filenames, simName + "_Reuse", true));
+	if (failures == 0)
+		std::cout << grid << ": sparse solutions of " << reference.size() << " nodes match the dense reference" << std::endl;
+	return failures;
+}
+
+int main(int argc, char** argv) {
+	Logger::setLogDir("logs/PF_DenseJacobianReference");
+
+	auto cigre = DPsim::Utils::findFiles({
+		"Rootnet_FULL_NE_06J16h_DI.xml",
+		"Rootnet_FULL_NE_06J16h_EQ.xml",
+		"Rootnet_FULL_NE_06J16h_SV.xml",
+		"Rootnet_FULL_NE_06J16h_TP.xml"
+	}, "build/_deps/cim-data-src/CIGRE_MV/NEPLAN/CIGRE_MV_no_tapchanger_With_LoadFlow_Results", "CIMPATH");
+
+	auto ieeeLV = DPsim::Utils::findFiles({
+		"Rootnet_FULL_NE_13J16h_DI.xml",
+		"Rootnet_FULL_NE_13J16h_EQ.xml",
+		"Rootnet_FULL_NE_13J16h_SV.xml",
+		"Rootnet_FULL_NE_13J16h_TP.xml"
+	}, "build/_deps/cim-data-src/IEEE_EU_LV/IEEE_EU_LV_reduced", "CIMPATH");
+
+	int failures = check("CIGRE_MV", cigre);
+	failures += check("IEEE_LV", ieeeLV);
+	return failures == 0 ? 0 : 1;
+}
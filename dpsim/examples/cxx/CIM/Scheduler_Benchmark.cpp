@@ -0,0 +1,184 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <iostream>
+#include <list>
+
+#include <DPsim.h>
+#include <dpsim/SequentialScheduler.h>
+#include <dpsim/ThreadLevelScheduler.h>
+#include <dpsim/ThreadListScheduler.h>
+#include <dpsim/WorkStealingScheduler.h>
+#include <dpsim/AdaptiveListScheduler.h>
+
+using namespace DPsim;
+using namespace CPS;
+
+// Compares the schedulers on multiplied WSCC-9bus or CIGRE-MV grids.
+// The copies of the grid are not coupled, so every copy gets its own solver
+// and the tasks of the copies can be executed in parallel.
+//
+// Options:
+//   -o grid=wscc|cigre      grid to simulate (default: wscc)
+//   -o copies=<n>           number of additional copies of the grid (default: 0)
+//   -o threads=<n>          number of threads (default: 1)
+//   -o scheduler=<name>     sequential, openmp, level, list, stealing, adaptive or all (default: all)
+//   -o pin=true|false       pin the threads of the work stealing scheduler (default: false)
+//   -o fusion=true|false    fuse small tasks before scheduling (default: false)
+//   -o barrier=<name>       spin, condition, hybrid or tree barriers between the steps (default: spin)
+//
+// The scheduler threads can be placed with --cpus, --rt-priority, --numa-local and --mlock.
+
+SystemTopology loadWSCC(const std::list<fs::path>& filenames, const String& simName, Int copies) {
+	CIM::Reader reader(simName, Logger::Level::off, Logger::Level::off);
+	SystemTopology sys = reader.loadCIM(60, filenames, Domain::DP, PhaseType::Single, CPS::GeneratorType::IdealVoltageSource);
+	if (copies > 0)
+		sys.multiply(copies);
+	return sys;
+}
+
+SystemTopology loadCIGRE(const std::list<fs::path>& filenames, const String& simName, Int copies) {
+	String simNamePF = simName + "_Powerflow";
+	Logger::setLogDir("logs/" + simNamePF);
+	CIM::Reader readerPF(simNamePF, Logger::Level::off, Logger::Level::off);
+	SystemTopology systemPF = readerPF.loadCIM(50, filenames, Domain::SP);
+
+	Simulation simPF(simNamePF, Logger::Level::off);
+	simPF.setSystem(systemPF);
+	simPF.setTimeStep(1);
+	simPF.setFinalTime(1);
+	simPF.setDomain(Domain::SP);
+	simPF.setSolverType(Solver::Type::NRP);
+	simPF.setSolverAndComponentBehaviour(Solver::Behaviour::Initialization);
+	simPF.doInitFromNodesAndTerminals(true);
+	simPF.run();
+
+	Logger::setLogDir("logs/" + simName);
+	CIM::Reader reader(simName, Logger::Level::off, Logger::Level::off);
+	SystemTopology sys = reader.loadCIM(50, filenames, Domain::DP);
+	sys.initWithPowerflow(systemPF);
+	if (copies > 0)
+		sys.multiply(copies);
+	return sys;
+}
+
+std::shared_ptr<Scheduler> createScheduler(const String& name, Int threads, Bool pin) {
+	if (name == "sequential")
+		return std::make_shared<SequentialScheduler>();
+#ifdef WITH_OPENMP
+	if (name == "openmp")
+		return std::make_shared<OpenMPLevelScheduler>(threads);
+#endif
+	if (name == "level")
+		return std::make_shared<ThreadLevelScheduler>(threads);
+	if (name == "list")
+		return std::make_shared<ThreadListScheduler>(threads);
+	if (name == "stealing")
+		return std::make_shared<WorkStealingScheduler>(threads, String(), pin);
+	if (name == "adaptive")
+		return std::make_shared<AdaptiveListScheduler>(threads);
+	return nullptr;
+}
+
+void benchmark(const String& grid, const std::list<fs::path>& filenames, CommandLineArgs& args,
+	Int copies, Int threads, const String& schedulerName, Bool pin, Bool fusion, BarrierType barrier) {
+	String simName = "Scheduler_Benchmark_" + grid + "_" + schedulerName
+		+ "_" + std::to_string(copies) + "_" + std::to_string(threads) + (fusion ? "_fused" : "");
+	Logger::setLogDir("logs/" + simName);
+
+	auto scheduler = createScheduler(schedulerName, threads, pin);
+	if (!scheduler) {
+		std::cout << "Scheduler " << schedulerName << " is not available" << std::endl;
+		return;
+	}
+	scheduler->setBarrierType(barrier);
+
+	SystemTopology sys = grid == "cigre"
+		? loadCIGRE(filenames, simName, copies)
+		: loadWSCC(filenames, simName, copies);
+
+	Simulation sim(simName, Logger::Level::off);
+	sim.setSystem(sys);
+	sim.setTimeStep(args.timeStep);
+	sim.setFinalTime(args.duration);
+	sim.setDomain(Domain::DP);
+	sim.doSplitSubnets(true);
+	sim.setScheduler(scheduler);
+	sim.doTaskFusion(fusion);
+	sim.setTaskFusionParallelism(threads);
+	sim.setThreadPlacement(args.threadPlacement);
+	sim.run();
+
+	auto& stepTimes = sim.stepTimeStatistics();
+	std::cout << grid << ", " << schedulerName << (fusion ? " (fused), " : ", ")
+		<< copies << " copies, " << threads << " threads: "
+		<< "mean " << stepTimes.mean() << " s, "
+		<< "p50 " << stepTimes.percentile(50) << " s, "
+		<< "p99 " << stepTimes.percentile(99) << " s, "
+		<< "max " << stepTimes.max() << " s" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+	CommandLineArgs args(argc, argv, "Scheduler_Benchmark", 0.0001, 0.1);
+
+	String grid = "wscc";
+	Int copies = 0;
+	Int threads = 1;
+	String schedulerName = "all";
+	Bool pin = false;
+	Bool fusion = false;
+	BarrierType barrier = BarrierType::Spin;
+
+	if (args.options.find("grid") != args.options.end())
+		grid = args.getOptionString("grid");
+	if (args.options.find("copies") != args.options.end())
+		copies = args.getOptionInt("copies");
+	if (args.options.find("threads") != args.options.end())
+		threads = args.getOptionInt("threads");
+	if (args.options.find("scheduler") != args.options.end())
+		schedulerName = args.getOptionString("scheduler");
+	if (args.options.find("pin") != args.options.end())
+		pin = args.getOptionBool("pin");
+	if (args.options.find("fusion") != args.options.end())
+		fusion = args.getOptionBool("fusion");
+	if (args.options.find("barrier") != args.options.end()) {
+		String barrierName = args.getOptionString("barrier");
+		if (barrierName == "condition")
+			barrier = BarrierType::Condition;
+		else if (barrierName == "hybrid")
+			barrier = BarrierType::Hybrid;
+		else if (barrierName == "tree")
+			barrier = BarrierType::Tree;
+		else if (barrierName != "spin")
+			throw std::invalid_argument("Invalid value for barrier");
+	}
+
+	std::list<fs::path> filenames;
+	if (grid == "cigre") {
+		filenames = DPsim::Utils::findFiles({
+			"Rootnet_FULL_NE_28J17h_DI.xml",
+			"Rootnet_FULL_NE_28J17h_EQ.xml",
+			"Rootnet_FULL_NE_28J17h_SV.xml",
+			"Rootnet_FULL_NE_28J17h_TP.xml"
+		}, "dpsim/Examples/CIM/grid-data/CIGRE_MV/NEPLAN/CIGRE_MV_no_tapchanger_noLoad1_LeftFeeder_With_LoadFlow_Results", "CIMPATH");
+	} else {
+		filenames = DPsim::Utils::findFiles({
+			"WSCC-09_RX_DI.xml",
+			"WSCC-09_RX_EQ.xml",
+			"WSCC-09_RX_SV.xml",
+			"WSCC-09_RX_TP.xml"
+		}, "build/_deps/cim-data-src/WSCC-09/WSCC-09_RX", "CIMPATH");
+	}
+
+	std::vector<String> schedulers = { schedulerName };
+	if (schedulerName == "all")
+		schedulers = { "sequential", "openmp", "level", "list", "stealing", "adaptive" };
+
+	for (auto& name : schedulers)
+		benchmark(grid, filenames, args, copies, threads, name, pin, fusion, barrier);
+}
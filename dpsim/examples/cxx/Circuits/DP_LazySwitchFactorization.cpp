@@ -0,0 +1,122 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <chrono>
+#include <thread>
+
+#include <DPsim.h>
+#include "../ResultComparison.h"
+
+using namespace DPsim;
+using namespace CPS;
+
+/*
+ * Switches two breakers of an RL network back and forth. Lazy factorization
+ * with a cache of a single state, lazy factorization with background
+ * prefactorization of the scheduled states and precomputing all switch
+ * combinations have to result in the same node voltages. The single cached
+ * state has to be evicted and factorized again on every switching, the
+ * prefactorized states have to be used without factorizing on demand.
+ */
+
+const Real timeStep = 1e-4;
+const Real finalTime = 0.1;
+
+int failures = 0;
+
+enum class Mode { Precomputed, LazyEvicting, Prefactorized };
+
+std::vector<MatrixComp> simulate(const String& simName, Mode mode) {
+	auto n1 = SimNode<Complex>::make("n1");
+	auto n2 = SimNode<Complex>::make("n2");
+	auto n3 = SimNode<Complex>::make("n3");
+
+	auto vs = DP::Ph1::VoltageSource::make("vs");
+	vs->setParameters(Complex(1000, 0));
+	auto r = DP::Ph1::Resistor::make("r_line");
+	r->setParameters(1);
+	auto l = DP::Ph1::Inductor::make("l_line");
+	l->setParameters(0.02);
+	auto load = DP::Ph1::Resistor::make("r_load");
+	load->setParameters(100);
+	auto breaker1 = DP::Ph1::Switch::make("breaker_1");
+	breaker1->setParameters(1e6, 5);
+	breaker1->open();
+	auto breaker2 = DP::Ph1::Switch::make("breaker_2");
+	breaker2->setParameters(1e6, 20);
+	breaker2->open();
+
+	vs->connect({ SimNode<Complex>::GND, n1 });
+	r->connect({ n1, n2 });
+	l->connect({ n2, n3 });
+	load->connect({ n3, SimNode<Complex>::GND });
+	breaker1->connect({ n3, SimNode<Complex>::GND });
+	breaker2->connect({ n2, SimNode<Complex>::GND });
+
+	auto system = SystemTopology(50, SystemNodeList{ n1, n2, n3 },
+		SystemComponentList{ vs, r, l, load, breaker1, breaker2 });
+
+	Simulation sim(simName, Logger::Level::off);
+	sim.setSystem(system);
+	sim.setTimeStep(timeStep);
+	sim.setFinalTime(finalTime);
+	sim.setDomain(Domain::DP);
+	sim.setDirectLinearSolverImplementation(DirectLinearSolverImpl::SparseLU);
+	if (mode != Mode::Precomputed)
+		sim.doLazySwitchFactorization(true);
+	if (mode == Mode::LazyEvicting)
+		sim.setSwitchFactorizationCacheSize(1);
+	if (mode == Mode::Prefactorized)
+		sim.doSwitchPrefactorization(true);
+
+	sim.addEvent(SwitchEvent::make(0.02, breaker1, true));
+	sim.addEvent(SwitchEvent::make(0.04, breaker2, true));
+	sim.addEvent(SwitchEvent::make(0.06, breaker1, false));
+	sim.addEvent(SwitchEvent::make(0.08, breaker2, false));
+
+	std::vector<MatrixComp> results;
+	sim.start();
+	// Leave the prefactorization thread enough time to finish before the first switching
+	if (mode == Mode::Prefactorized)
+		std::this_thread::sleep_for(std::chrono::milliseconds(200));
+	while (sim.time() < finalTime) {
+		sim.next();
+		for (auto node : { n1, n2, n3 })
+			results.push_back(**node->mVoltage);
+	}
+	sim.stop();
+
+	// The four switchings lead to three new states and back to the initial one
+	auto statistics = sim.switchFactorizationStatistics();
+	if (mode == Mode::LazyEvicting) {
+		failures += ResultComparison::expect(statistics->onDemand == 4, simName + ": "
+			+ std::to_string(statistics->onDemand) + " instead of 4 factorizations on demand");
+		failures += ResultComparison::expect(statistics->evictions == 4, simName + ": "
+			+ std::to_string(statistics->evictions) + " instead of 4 evicted factorizations");
+	}
+	if (mode == Mode::Prefactorized) {
+		failures += ResultComparison::expect(statistics->prefactorized == 3 && statistics->prefactorizationHits == 3, simName + ": "
+			+ std::to_string(statistics->prefactorizationHits) + " of " + std::to_string(statistics->prefactorized)
+			+ " prefactorized states used instead of 3 of 3");
+		failures += ResultComparison::expect(statistics->onDemand == 0 && statistics->evictions == 0, simName + ": "
+			+ std::to_string(statistics->onDemand) + " factorizations on demand and " + std::to_string(statistics->evictions) + " evictions");
+	}
+	return results;
+}
+
+int main(int argc, char* argv[]) {
+	Logger::setLogDir("logs/DP_LazySwitchFactorization");
+
+	auto reference = simulate("DP_LazySwitch_Precomputed", Mode::Precomputed);
+	failures += ResultComparison::compare<Complex>("Lazy with a single cached state", reference, simulate("DP_LazySwitch_Evicting", Mode::LazyEvicting));
+	failures += ResultComparison::compare<Complex>("Background prefactorization", reference, simulate("DP_LazySwitch_Prefactorized", Mode::Prefactorized));
+
+	if (failures == 0)
+		std::cout << "Lazily factorized switch states match the precomputed ones" << std::endl;
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,140 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <iostream>
+
+#include <DPsim.h>
+
+using namespace DPsim;
+using namespace CPS;
+
+/*
+ * Toggles two breakers with variable resistance several times and solves the
+ * circuit once with a refactorization for every change of the system matrix
+ * and once with low-rank updates of the factorization. The node voltages have
+ * to be the same in every step.
+ */
+
+const Real timeStep = 1e-4;
+const Real finalTime = 0.2;
+
+struct Result {
+	std::vector<MatrixComp> voltages;
+	UInt numRefactorizations = 0;
+	UInt numLowRankUpdates = 0;
+};
+
+Result simulate(const String& simName, Bool lowRank) {
+	auto n1 = SimNode<Complex>::make("n1");
+	auto n2 = SimNode<Complex>::make("n2");
+	auto n3 = SimNode<Complex>::make("n3");
+
+	auto vs = DP::Ph1::VoltageSource::make("vs");
+	vs->setParameters(Complex(1000, 0));
+	auto line = DP::Ph1::Resistor::make("r_line");
+	line->setParameters(0.5);
+	auto lineL = DP::Ph1::Inductor::make("l_line");
+	lineL->setParameters(5e-3);
+	auto load = DP::Ph1::Resistor::make("r_load");
+	load->setParameters(20);
+	auto cap = DP::Ph1::Capacitor::make("c_load");
+	cap->setParameters(1e-5);
+	auto load2 = DP::Ph1::Resistor::make("r_load2");
+	load2->setParameters(40);
+
+	auto fault = DP::Ph1::varResSwitch::make("fault");
+	fault->setParameters(1e6, 0.1);
+	fault->setInitParameters(timeStep);
+	fault->open();
+	auto breaker = DP::Ph1::varResSwitch::make("breaker");
+	breaker->setParameters(1e6, 0.01);
+	breaker->setInitParameters(timeStep);
+	breaker->close();
+
+	vs->connect({ SimNode<Complex>::GND, n1 });
+	line->connect({ n1, n2 });
+	lineL->connect({ n2, n3 });
+	load->connect({ n3, SimNode<Complex>::GND });
+	cap->connect({ n3, SimNode<Complex>::GND });
+	fault->connect({ n3, SimNode<Complex>::GND });
+	breaker->connect({ n2, SimNode<Complex>::GND });
+	load2->connect({ n2, SimNode<Complex>::GND });
+
+	auto system = SystemTopology(50, SystemNodeList{ n1, n2, n3 },
+		SystemComponentList{ vs, line, lineL, load, cap, load2, fault, breaker });
+
+	Simulation sim(simName, Logger::Level::off);
+	sim.setSystem(system);
+	sim.setTimeStep(timeStep);
+	sim.setFinalTime(finalTime);
+	sim.setDomain(Domain::DP);
+	sim.setDirectLinearSolverImplementation(DirectLinearSolverImpl::SparseLU);
+	sim.doSystemMatrixRecomputation(true);
+	sim.doLowRankSystemMatrixUpdates(lowRank);
+	sim.setMaxLowRankUpdates(4);
+
+	for (Real time : { 0.02, 0.06, 0.1, 0.14 }) {
+		sim.addEvent(SwitchEvent::make(time, fault, true));
+		sim.addEvent(SwitchEvent::make(time + 0.02, fault, false));
+	}
+	sim.addEvent(SwitchEvent::make(0.05, breaker, false));
+	sim.addEvent(SwitchEvent::make(0.12, breaker, true));
+
+	Result result;
+	sim.start();
+	while (sim.time() < finalTime) {
+		sim.next();
+		MatrixComp voltages(3, 1);
+		voltages << n1->singleVoltage(), n2->singleVoltage(), n3->singleVoltage();
+		result.voltages.push_back(voltages);
+	}
+	sim.stop();
+
+	result.numRefactorizations = sim.recomputationTimes()->count();
+	result.numLowRankUpdates = sim.lowRankUpdateTimes()->count();
+	return result;
+}
+
+int main(int argc, char* argv[]) {
+	Logger::setLogDir("logs/DP_LowRankSwitchUpdates");
+	int failures = 0;
+
+	auto reference = simulate("DP_LowRankSwitchUpdates_Refactorization", false);
+	auto lowRank = simulate("DP_LowRankSwitchUpdates_LowRank", true);
+
+	if (reference.voltages.size() != lowRank.voltages.size()) {
+		std::cerr << "Low-rank simulation has " << lowRank.voltages.size() << " instead of "
+			<< reference.voltages.size() << " steps" << std::endl;
+		return 1;
+	}
+
+	Real maxDiff = 0, maxVoltage = 0;
+	for (UInt step = 0; step < reference.voltages.size(); ++step) {
+		maxDiff = std::max(maxDiff, (reference.voltages[step] - lowRank.voltages[step]).cwiseAbs().maxCoeff());
+		maxVoltage = std::max(maxVoltage, reference.voltages[step].cwiseAbs().maxCoeff());
+	}
+	if (maxDiff > 1e-8 * maxVoltage) {
+		std::cerr << "Node voltages differ by up to " << maxDiff << " V" << std::endl;
+		++failures;
+	}
+
+	// Low-rank updates replace refactorizations and are counted separately
+	if (reference.numLowRankUpdates != 0 || lowRank.numLowRankUpdates == 0
+		|| lowRank.numRefactorizations >= reference.numRefactorizations) {
+		std::cerr << "Refactorizations without low-rank updates: " << reference.numRefactorizations
+			<< ", with: " << lowRank.numRefactorizations << " and " << lowRank.numLowRankUpdates
+			<< " low-rank updates" << std::endl;
+		++failures;
+	}
+
+	if (failures == 0)
+		std::cout << lowRank.numLowRankUpdates << " low-rank updates replace "
+			<< reference.numRefactorizations - lowRank.numRefactorizations
+			<< " refactorizations with a maximum voltage difference of " << maxDiff << " V" << std::endl;
+	return failures == 0 ? 0 : 1;
+}
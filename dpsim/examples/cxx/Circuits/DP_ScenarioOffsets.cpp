@@ -0,0 +1,136 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <iostream>
+
+#include <DPsim.h>
+
+using namespace DPsim;
+using namespace CPS;
+
+/*
+ * Solves two current injection scenarios together with a resistive network
+ * that switches a load in the middle of the run. Every scenario solution has
+ * to match a separate simulation with a current source injecting the scenario
+ * offset. Scenarios share the component states of the nominal system, so this
+ * only holds for networks without history terms.
+ */
+
+const Real timeStep = 1e-3;
+const Real finalTime = 0.1;
+const std::vector<Complex> injections = { Complex(2, 1), Complex(-5, 0) };
+
+struct Network {
+	SimNode<Complex>::List nodes;
+	SystemTopology system;
+	std::shared_ptr<DP::Ph1::Switch> breaker;
+};
+
+Network createNetwork() {
+	auto n1 = SimNode<Complex>::make("n1");
+	auto n2 = SimNode<Complex>::make("n2");
+	auto n3 = SimNode<Complex>::make("n3");
+
+	auto vs = DP::Ph1::VoltageSource::make("vs");
+	vs->setParameters(Complex(100, 0));
+	auto r1 = DP::Ph1::Resistor::make("r_1");
+	r1->setParameters(1);
+	auto r2 = DP::Ph1::Resistor::make("r_2");
+	r2->setParameters(10);
+	auto r3 = DP::Ph1::Resistor::make("r_3");
+	r3->setParameters(5);
+	auto r4 = DP::Ph1::Resistor::make("r_4");
+	r4->setParameters(20);
+	auto breaker = DP::Ph1::Switch::make("breaker");
+	breaker->setParameters(1e6, 2);
+	breaker->open();
+
+	vs->connect({ SimNode<Complex>::GND, n1 });
+	r1->connect({ n1, n2 });
+	r2->connect({ n2, SimNode<Complex>::GND });
+	r3->connect({ n2, n3 });
+	r4->connect({ n3, SimNode<Complex>::GND });
+	breaker->connect({ n3, SimNode<Complex>::GND });
+
+	return { { n1, n2, n3 }, SystemTopology(50, SystemNodeList{ n1, n2, n3 },
+		SystemComponentList{ vs, r1, r2, r3, r4, breaker }), breaker };
+}
+
+/// Index of the node the scenario injects its current into
+UInt injectionNode(UInt scenario) { return scenario + 1; }
+
+void setupSimulation(Simulation& sim, Network& network) {
+	sim.setSystem(network.system);
+	sim.setTimeStep(timeStep);
+	sim.setFinalTime(finalTime);
+	sim.setDomain(Domain::DP);
+	sim.setDirectLinearSolverImplementation(DirectLinearSolverImpl::SparseLU);
+	sim.addEvent(SwitchEvent::make(finalTime / 2, network.breaker, true));
+}
+
+int main(int argc, char* argv[]) {
+	Logger::setLogDir("logs/DP_ScenarioOffsets");
+	const UInt numScenarios = static_cast<UInt>(injections.size());
+
+	auto nominal = createNetwork();
+	Simulation sim("DP_ScenarioOffsets", Logger::Level::off);
+	setupSimulation(sim, nominal);
+	sim.setNumberOfScenarios(numScenarios);
+	sim.initialize();
+
+	// The imaginary parts follow the real parts in the source vector
+	Matrix offsets = Matrix::Zero(sim.scenarioLeftSideVectors().rows(), numScenarios);
+	const Matrix::Index complexOffset = offsets.rows() / 2;
+	for (UInt scenario = 0; scenario < numScenarios; ++scenario) {
+		auto idx = nominal.nodes[injectionNode(scenario)]->matrixNodeIndex();
+		offsets(idx, scenario) = injections[scenario].real();
+		offsets(idx + complexOffset, scenario) = injections[scenario].imag();
+	}
+	sim.setScenarioRightSideOffsets(offsets);
+
+	std::vector<Network> separateNetworks;
+	std::vector<std::shared_ptr<Simulation>> separateSims;
+	for (UInt scenario = 0; scenario < numScenarios; ++scenario) {
+		auto network = createNetwork();
+		auto injection = DP::Ph1::CurrentSource::make("injection");
+		injection->setParameters(injections[scenario]);
+		injection->connect({ SimNode<Complex>::GND, network.nodes[injectionNode(scenario)] });
+		network.system.addComponent(injection);
+
+		auto separate = std::make_shared<Simulation>("DP_ScenarioOffsets_Separate" + std::to_string(scenario), Logger::Level::off);
+		setupSimulation(*separate, network);
+		separate->start();
+		separateNetworks.push_back(network);
+		separateSims.push_back(separate);
+	}
+
+	sim.start();
+	Real maxDiff = 0;
+	while (sim.time() < finalTime) {
+		sim.next();
+		const Matrix& scenarios = sim.scenarioLeftSideVectors();
+		for (UInt scenario = 0; scenario < numScenarios; ++scenario) {
+			separateSims[scenario]->next();
+			for (UInt node = 0; node < nominal.nodes.size(); ++node) {
+				auto idx = nominal.nodes[node]->matrixNodeIndex();
+				Complex voltage(scenarios(idx, scenario), scenarios(idx + complexOffset, scenario));
+				maxDiff = std::max(maxDiff, std::abs(voltage - separateNetworks[scenario].nodes[node]->singleVoltage()));
+			}
+		}
+	}
+	sim.stop();
+	for (auto& separate : separateSims)
+		separate->stop();
+
+	if (maxDiff > 1e-8) {
+		std::cerr << "Scenario solutions differ from separate simulations by up to " << maxDiff << " V" << std::endl;
+		return 1;
+	}
+	std::cout << "Scenario solutions match separate simulations, maximum difference " << maxDiff << " V" << std::endl;
+	return 0;
+}
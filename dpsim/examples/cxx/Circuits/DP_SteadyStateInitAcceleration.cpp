@@ -0,0 +1,101 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <chrono>
+#include <iostream>
+
+#include <DPsim.h>
+
+using namespace DPsim;
+using namespace CPS;
+
+/*
+ * Runs the steady-state initialization of a lightly damped RLC circuit that
+ * starts from zero with plain time stepping, with Anderson acceleration and
+ * with a ten times larger init time step plus acceleration. All variants have
+ * to reach the phasor solution of the circuit. The init times are printed.
+ */
+
+const Real timeStep = 1e-4;
+const Real resistance = 0.5;
+const Real inductance = 0.01;
+const Real capacitance = 1e-4;
+const Real loadResistance = 100;
+const Complex sourceVoltage(100, 0);
+
+struct Result {
+	Complex voltage;
+	Real initTime;
+};
+
+Result initialize(const String& simName, Bool acceleration, Real initTimeStep) {
+	auto n1 = SimNode<Complex>::make("n1");
+	auto n2 = SimNode<Complex>::make("n2");
+	auto n3 = SimNode<Complex>::make("n3");
+
+	auto vs = DP::Ph1::VoltageSource::make("vs");
+	vs->setParameters(sourceVoltage);
+	auto r = DP::Ph1::Resistor::make("r");
+	r->setParameters(resistance);
+	auto l = DP::Ph1::Inductor::make("l");
+	l->setParameters(inductance);
+	auto c = DP::Ph1::Capacitor::make("c");
+	c->setParameters(capacitance);
+	auto load = DP::Ph1::Resistor::make("r_load");
+	load->setParameters(loadResistance);
+
+	vs->connect({ SimNode<Complex>::GND, n1 });
+	r->connect({ n1, n2 });
+	l->connect({ n2, n3 });
+	c->connect({ n3, SimNode<Complex>::GND });
+	load->connect({ n3, SimNode<Complex>::GND });
+
+	auto system = SystemTopology(50, SystemNodeList{ n1, n2, n3 }, SystemComponentList{ vs, r, l, c, load });
+
+	Simulation sim(simName, Logger::Level::off);
+	sim.setSystem(system);
+	sim.setTimeStep(timeStep);
+	sim.setFinalTime(timeStep);
+	sim.setDomain(Domain::DP);
+	sim.setDirectLinearSolverImplementation(DirectLinearSolverImpl::SparseLU);
+	sim.doSteadyStateInit(true);
+	sim.setSteadStIniAccLimit(1e-9);
+	sim.doSteadStIniAcceleration(acceleration);
+	sim.setSteadStIniTimeStep(initTimeStep);
+
+	auto start = std::chrono::steady_clock::now();
+	sim.initialize();
+	std::chrono::duration<Real> initTime = std::chrono::steady_clock::now() - start;
+
+	return { n3->singleVoltage(), initTime.count() };
+}
+
+int main(int argc, char* argv[]) {
+	Logger::setLogDir("logs/DP_SteadyStateInitAcceleration");
+
+	// Phasor solution of the circuit
+	Real omega = 2. * PI * 50;
+	Complex parallel = 1. / (Complex(0, omega * capacitance) + 1. / loadResistance);
+	Complex expected = sourceVoltage * parallel / (resistance + Complex(0, omega * inductance) + parallel);
+
+	int failures = 0;
+	auto check = [&](const String& name, const Result& result) {
+		Real error = std::abs(result.voltage - expected);
+		std::cout << name << ": " << 1e3 * result.initTime << " ms, voltage error " << error << " V" << std::endl;
+		if (error > 1e-4 * std::abs(expected)) {
+			std::cerr << name << ": steady state voltage " << result.voltage << " instead of " << expected << std::endl;
+			++failures;
+		}
+	};
+
+	check("Plain iteration", initialize("DP_SteadyStateInit_Plain", false, 0));
+	check("Anderson acceleration", initialize("DP_SteadyStateInit_Accelerated", true, 0));
+	check("Larger init time step and acceleration", initialize("DP_SteadyStateInit_LargeStep", true, 10 * timeStep));
+
+	return failures == 0 ? 0 : 1;
+}
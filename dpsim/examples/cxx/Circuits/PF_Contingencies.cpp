@@ -0,0 +1,188 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <fstream>
+#include <iostream>
+
+#include <DPsim.h>
+
+using namespace DPsim;
+using namespace CPS;
+
+/*
+ * Runs the N-1 contingency analysis of a meshed grid with a radial spur on one
+ * and on several threads. Both runs have to give the same ranked results, and
+ * every converged outage has to match a separate power flow of the grid
+ * without the outaged component. The same holds for the fast decoupled
+ * solvers, which refill B' and B'' instead of composing them again.
+ */
+
+const Real Vnom = 20e3;
+using Result = PFSolver::ContingencyResult;
+
+/// Grid without the component of the given name
+SystemTopology buildSystem(const String& outage = "") {
+	const UInt numNodes = 9;
+	SimNode<Complex>::List nodes;
+	SystemComponentList components;
+	for (UInt i = 0; i <= numNodes; ++i)
+		nodes.push_back(SimNode<Complex>::make("n" + std::to_string(i), PhaseType::Single));
+
+	auto add = [&](IdentifiedObject::Ptr component) {
+		if (component->name() != outage)
+			components.push_back(component);
+	};
+
+	auto extnet = SP::Ph1::NetworkInjection::make("Slack", Logger::Level::off);
+	extnet->setParameters(1.02 * Vnom);
+	extnet->setBaseVoltage(Vnom);
+	extnet->modifyPowerFlowBusType(PowerflowBusType::VD);
+	extnet->connect({ nodes[0] });
+	add(extnet);
+
+	auto gen = SP::Ph1::SynchronGenerator::make("Gen", Logger::Level::off);
+	gen->setParameters(10e6, Vnom, 3e6, 1.01 * Vnom, PowerflowBusType::PV);
+	gen->setBaseVoltage(Vnom);
+	gen->connect({ nodes[5] });
+	add(gen);
+
+	auto addLine = [&](UInt from, UInt to, Real length) {
+		auto line = SP::Ph1::PiLine::make("Line" + std::to_string(from) + "_" + std::to_string(to), Logger::Level::off);
+		line->setParameters(0.1 * length, 1e-3 * length, 1e-8, 1e-6 * length);
+		line->setBaseVoltage(Vnom);
+		line->connect({ nodes[from], nodes[to] });
+		add(line);
+	};
+	// Ring with a cross connection, node 9 hangs on node 7 only
+	for (UInt i = 0; i < numNodes; ++i)
+		addLine(i, (i + 1) % numNodes, 1 + 0.3 * (i % 3));
+	addLine(2, 6, 2);
+	addLine(7, 9, 1);
+
+	for (UInt i = 1; i <= numNodes; ++i) {
+		if (i == 5)
+			continue;
+		auto load = SP::Ph1::Load::make("Load" + std::to_string(i), Logger::Level::off);
+		load->setParameters(1.5e6 + 3e5 * (i % 4), 3e5 + 1e5 * (i % 3), Vnom);
+		load->modifyPowerFlowBusType(PowerflowBusType::PQ);
+		load->connect({ nodes[i] });
+		add(load);
+	}
+
+	return SystemTopology(50, SystemNodeList(nodes.begin(), nodes.end()), components);
+}
+
+void configure(Simulation& sim, const SystemTopology& system, Solver::Type solverType = Solver::Type::NRP) {
+	sim.setSystem(system);
+	sim.setTimeStep(1);
+	sim.setFinalTime(1);
+	sim.setDomain(Domain::SP);
+	sim.setSolverType(solverType);
+	sim.setSolverAndComponentBehaviour(Solver::Behaviour::Initialization);
+	sim.doInitFromNodesAndTerminals(false);
+}
+
+std::vector<Result> analyze(const String& simName, UInt numThreads, Solver::Type solverType = Solver::Type::NRP) {
+	Simulation sim(simName, Logger::Level::off);
+	configure(sim, buildSystem(), solverType);
+	return sim.runPowerflowContingencies("logs/PF_Contingencies/" + simName + ".csv", numThreads);
+}
+
+/// Lowest voltage magnitude in per unit of a separate power flow without the outaged component
+Real minVoltageWithout(const String& outage, Solver::Type solverType = Solver::Type::NRP) {
+	auto system = buildSystem(outage);
+	Simulation sim("PF_Contingencies_" + outage, Logger::Level::off);
+	configure(sim, system, solverType);
+	sim.run();
+
+	Real minVoltage = std::numeric_limits<Real>::max();
+	for (auto node : system.mNodes)
+		minVoltage = std::min(minVoltage, std::abs(std::dynamic_pointer_cast<SimNode<Complex>>(node)->singleVoltage()) / Vnom);
+	return minVoltage;
+}
+
+int main(int argc, char* argv[]) {
+	Logger::setLogDir("logs/PF_Contingencies");
+	int failures = 0;
+
+	auto sequential = analyze("Sequential", 1);
+	auto parallel = analyze("Parallel", 3);
+
+	// 11 lines and the generator at the PV bus
+	if (sequential.size() != 12 || parallel.size() != sequential.size()) {
+		std::cerr << "Expected 12 contingencies, got " << sequential.size() << " and " << parallel.size() << std::endl;
+		return 1;
+	}
+
+	// Every thread solves its contingencies in a different order, so the
+	// solutions only agree up to round-off
+	auto differs = [](Real x, Real y) { return std::abs(x - y) > 1e-12 * std::max(1., std::abs(x)); };
+
+	for (UInt rank = 0; rank < sequential.size(); ++rank) {
+		const Result& a = sequential[rank];
+		const Result& b = parallel[rank];
+		if (a.contingency.name != b.contingency.name || a.status != b.status || differs(a.severity, b.severity)
+			|| differs(a.minVoltage, b.minVoltage)) {
+			std::cerr << "Rank " << rank + 1 << " is " << a.contingency.name << " on one and "
+				<< b.contingency.name << " on three threads" << std::endl;
+			++failures;
+		}
+		if (rank > 0) {
+			const Result& previous = sequential[rank - 1];
+			if (previous.status < a.status || (previous.status == a.status && previous.severity < a.severity)) {
+				std::cerr << "Contingency " << a.contingency.name << " is ranked too low" << std::endl;
+				++failures;
+			}
+		}
+	}
+
+	// Only the outage of the spur line islands a bus
+	if (sequential.front().contingency.name != "Line7_9" || sequential.front().status != Result::Status::Islanded) {
+		std::cerr << "Outage of the spur line is not ranked first as islanded" << std::endl;
+		++failures;
+	}
+
+	for (auto& result : sequential) {
+		if (result.status != Result::Status::Converged)
+			continue;
+		Real expected = minVoltageWithout(result.contingency.name);
+		if (std::abs(result.minVoltage - expected) > 1e-6) {
+			std::cerr << "Outage of " << result.contingency.name << " gives a minimum voltage of "
+				<< result.minVoltage << " instead of " << expected << " pu" << std::endl;
+			++failures;
+		}
+	}
+
+	for (auto solverType : { Solver::Type::FDXB, Solver::Type::FDBX }) {
+		String variant = solverType == Solver::Type::FDXB ? "XB" : "BX";
+		for (auto& result : analyze("FastDecoupled" + variant, 1, solverType)) {
+			if (result.status != Result::Status::Converged)
+				continue;
+			Real expected = minVoltageWithout(result.contingency.name, solverType);
+			if (std::abs(result.minVoltage - expected) > 1e-6) {
+				std::cerr << "Fast decoupled " << variant << " outage of " << result.contingency.name
+					<< " gives a minimum voltage of " << result.minVoltage << " instead of " << expected << " pu" << std::endl;
+				++failures;
+			}
+		}
+	}
+
+	std::ifstream report("logs/PF_Contingencies/Sequential.csv");
+	UInt numLines = 0;
+	for (String line; std::getline(report, line);)
+		++numLines;
+	if (numLines != sequential.size() + 1) {
+		std::cerr << "Report has " << numLines << " lines" << std::endl;
+		++failures;
+	}
+
+	if (failures == 0)
+		std::cout << "Contingency analysis of " << sequential.size()
+			<< " outages matches separate power flows" << std::endl;
+	return failures == 0 ? 0 : 1;
+}
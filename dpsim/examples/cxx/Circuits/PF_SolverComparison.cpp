@@ -0,0 +1,120 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <iostream>
+
+#include <DPsim.h>
+
+using namespace DPsim;
+using namespace CPS;
+
+/*
+ * Solves the power flow of a meshed grid with the Newton-Raphson, both fast
+ * decoupled and the DC solver. The fast decoupled solvers have to converge to
+ * the Newton-Raphson solution, the DC solution has to approximate its angles.
+ */
+
+const Real Vnom = 20e3;
+
+SystemTopology buildSystem() {
+	const UInt numNodes = 10;
+	SimNode<Complex>::List nodes;
+	SystemComponentList components;
+	for (UInt i = 0; i < numNodes; ++i)
+		nodes.push_back(SimNode<Complex>::make("n" + std::to_string(i), PhaseType::Single));
+
+	auto extnet = SP::Ph1::NetworkInjection::make("Slack", Logger::Level::off);
+	extnet->setParameters(1.02 * Vnom);
+	extnet->setBaseVoltage(Vnom);
+	extnet->modifyPowerFlowBusType(PowerflowBusType::VD);
+	extnet->connect({ nodes[0] });
+	components.push_back(extnet);
+
+	auto gen = SP::Ph1::SynchronGenerator::make("Gen", Logger::Level::off);
+	gen->setParameters(10e6, Vnom, 2e6, 1.01 * Vnom, PowerflowBusType::PV);
+	gen->setBaseVoltage(Vnom);
+	gen->connect({ nodes[5] });
+	components.push_back(gen);
+
+	// Ring with two cross connections and small R/X ratios
+	auto addLine = [&](UInt from, UInt to, Real length) {
+		auto line = SP::Ph1::PiLine::make("Line" + std::to_string(from) + "_" + std::to_string(to), Logger::Level::off);
+		line->setParameters(0.05 * length, 1e-3 * length, 1e-8, 1e-6 * length);
+		line->setBaseVoltage(Vnom);
+		line->connect({ nodes[from], nodes[to] });
+		components.push_back(line);
+	};
+	for (UInt i = 0; i < numNodes; ++i)
+		addLine(i, (i + 1) % numNodes, 1 + 0.2 * (i % 3));
+	addLine(0, 4, 2);
+	addLine(3, 8, 2.5);
+
+	for (UInt i = 1; i < numNodes; ++i) {
+		if (i == 5)
+			continue;
+		auto load = SP::Ph1::Load::make("Load" + std::to_string(i), Logger::Level::off);
+		load->setParameters(1e6 + 2e5 * (i % 4), 2e5 + 5e4 * (i % 3), Vnom);
+		load->modifyPowerFlowBusType(PowerflowBusType::PQ);
+		load->connect({ nodes[i] });
+		components.push_back(load);
+	}
+
+	return SystemTopology(50, SystemNodeList(nodes.begin(), nodes.end()), components);
+}
+
+std::vector<Complex> solvePowerflow(Solver::Type type, const String& simName) {
+	auto system = buildSystem();
+	Simulation sim(simName, Logger::Level::off);
+	sim.setSystem(system);
+	sim.setTimeStep(1);
+	sim.setFinalTime(1);
+	sim.setDomain(Domain::SP);
+	sim.setSolverType(type);
+	sim.setSolverAndComponentBehaviour(Solver::Behaviour::Initialization);
+	sim.doInitFromNodesAndTerminals(false);
+	sim.run();
+
+	std::vector<Complex> voltages;
+	for (auto node : system.mNodes)
+		voltages.push_back(std::dynamic_pointer_cast<SimNode<Complex>>(node)->singleVoltage());
+	return voltages;
+}
+
+int main(int argc, char* argv[]) {
+	Logger::setLogDir("logs/PF_SolverComparison");
+	int failures = 0;
+
+	auto reference = solvePowerflow(Solver::Type::NRP, "PF_SolverComparison_NRP");
+
+	for (auto type : { Solver::Type::FDXB, Solver::Type::FDBX }) {
+		String name = type == Solver::Type::FDXB ? "FDXB" : "FDBX";
+		auto voltages = solvePowerflow(type, "PF_SolverComparison_" + name);
+		for (UInt i = 0; i < reference.size(); ++i) {
+			Real diff = std::abs(voltages[i] - reference[i]);
+			if (diff > 1e-6 * Vnom) {
+				std::cerr << name << " voltage of node " << i << " differs by " << diff << " V" << std::endl;
+				++failures;
+			}
+		}
+	}
+
+	// The DC power flow neglects losses and reactive power, so only the angles are close
+	auto voltages = solvePowerflow(Solver::Type::DCPF, "PF_SolverComparison_DCPF");
+	Real maxAngleDiff = 0;
+	for (UInt i = 0; i < reference.size(); ++i)
+		maxAngleDiff = std::max(maxAngleDiff, std::abs(std::arg(voltages[i]) - std::arg(reference[i])));
+	if (maxAngleDiff > 0.01) {
+		std::cerr << "DC power flow angles differ by up to " << maxAngleDiff << " rad" << std::endl;
+		++failures;
+	}
+
+	if (failures == 0)
+		std::cout << "Fast decoupled solutions match Newton-Raphson, DC angles differ by up to "
+			<< maxAngleDiff << " rad" << std::endl;
+	return failures == 0 ? 0 : 1;
+}
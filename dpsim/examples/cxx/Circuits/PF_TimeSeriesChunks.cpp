@@ -0,0 +1,156 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+
+#include <DPsim.h>
+
+using namespace DPsim;
+using namespace CPS;
+
+/*
+ * Solves a quasi-static time series power flow with load profiles once in a
+ * single chunk and once split into several chunks solved in parallel. Both
+ * runs have to yield the same time points and node voltages.
+ */
+
+const Real timeStep = 0.1;
+const UInt numSteps = 40;
+
+SystemTopology buildSystem(Real Vnom) {
+	const UInt numNodes = 12;
+	SimNode<Complex>::List nodes;
+	SystemComponentList components;
+	for (UInt i = 0; i < numNodes; ++i)
+		nodes.push_back(SimNode<Complex>::make("n" + std::to_string(i), PhaseType::Single));
+
+	auto extnet = SP::Ph1::NetworkInjection::make("Slack", Logger::Level::off);
+	extnet->setParameters(1.02 * Vnom);
+	extnet->setBaseVoltage(Vnom);
+	extnet->modifyPowerFlowBusType(PowerflowBusType::VD);
+	extnet->connect({ nodes[0] });
+	components.push_back(extnet);
+
+	auto gen = SP::Ph1::SynchronGenerator::make("Gen", Logger::Level::off);
+	gen->setParameters(5e6, Vnom, 1e6, 1.01 * Vnom, PowerflowBusType::PV);
+	gen->setBaseVoltage(Vnom);
+	gen->connect({ nodes[numNodes / 2] });
+	components.push_back(gen);
+
+	for (UInt i = 1; i < numNodes; ++i) {
+		auto line = SP::Ph1::PiLine::make("Line" + std::to_string(i), Logger::Level::off);
+		line->setParameters(0.2 + 0.01 * (i % 3), 1e-3, 1e-8, 1e-6);
+		line->setBaseVoltage(Vnom);
+		line->connect({ nodes[i - 1], nodes[i] });
+		components.push_back(line);
+
+		if (i == numNodes / 2)
+			continue;
+		auto load = SP::Ph1::Load::make("Load" + std::to_string(i), Logger::Level::off);
+		load->setParameters(5e5, 1e5, Vnom);
+		load->modifyPowerFlowBusType(PowerflowBusType::PQ);
+		load->connect({ nodes[i] });
+		components.push_back(load);
+
+		// Profile times are accumulated like in the CSV reader
+		load->use_profile = true;
+		Real time = 0;
+		for (UInt step = 0; step <= numSteps; ++step, time += timeStep) {
+			Real factor = 1 + 0.3 * std::sin(0.2 * step + i);
+			load->mLoadProfile.pqData[time] = PQData{ 5e5 * factor, 1e5 * factor };
+		}
+	}
+
+	return SystemTopology(50, SystemNodeList(nodes.begin(), nodes.end()), components);
+}
+
+struct TimeSeries {
+	std::vector<Real> times;
+	std::vector<std::uint32_t> converged;
+	std::vector<Real> voltages;
+};
+
+TimeSeries solveTimeSeries(const String& simName, UInt numChunks) {
+	Simulation sim(simName, Logger::Level::info);
+	sim.setSystem(buildSystem(20e3));
+	sim.setTimeStep(timeStep);
+	sim.setFinalTime(numSteps * timeStep);
+	sim.setDomain(Domain::SP);
+	sim.setSolverType(Solver::Type::NRP);
+	sim.setSolverAndComponentBehaviour(Solver::Behaviour::Simulation);
+	sim.doInitFromNodesAndTerminals(false);
+	sim.doPowerflowWarmStart(true);
+	sim.doPowerflowJacobianReuse(true);
+
+	String filename = "logs/PF_TimeSeriesChunks/" + simName + ".bin";
+	sim.runPowerflowTimeSeries(filename, numChunks);
+
+	TimeSeries series;
+	std::ifstream file(filename, std::ios::binary);
+	char magic[8];
+	std::uint32_t sizes[2];
+	file.read(magic, sizeof(magic));
+	file.read(reinterpret_cast<char*>(sizes), sizeof(sizes));
+	for (UInt i = 0; i < sizes[0]; ++i) {
+		std::uint32_t length;
+		file.read(reinterpret_cast<char*>(&length), sizeof(length));
+		file.ignore(length);
+	}
+	for (UInt idx = 0; idx < sizes[1] && file; ++idx) {
+		Real time;
+		std::uint32_t status[2];
+		std::vector<Real> values(2 * sizes[0]);
+		file.read(reinterpret_cast<char*>(&time), sizeof(time));
+		file.read(reinterpret_cast<char*>(status), sizeof(status));
+		file.read(reinterpret_cast<char*>(values.data()), values.size() * sizeof(Real));
+		series.times.push_back(time);
+		series.converged.push_back(status[1]);
+		series.voltages.insert(series.voltages.end(), values.begin(), values.end());
+	}
+	return series;
+}
+
+int main(int argc, char* argv[]) {
+	Logger::setLogDir("logs/PF_TimeSeriesChunks");
+	int failures = 0;
+
+	auto sequential = solveTimeSeries("Sequential", 1);
+	auto chunked = solveTimeSeries("Chunked", 4);
+
+	if (sequential.times.size() != numSteps || chunked.times.size() != numSteps) {
+		std::cerr << "Expected " << numSteps << " time points, got " << sequential.times.size()
+			<< " and " << chunked.times.size() << std::endl;
+		return 1;
+	}
+	for (UInt idx = 0; idx < numSteps; ++idx) {
+		if (sequential.times[idx] != idx * timeStep || chunked.times[idx] != sequential.times[idx]) {
+			std::cerr << "Time point " << idx << " is " << sequential.times[idx] << " and "
+				<< chunked.times[idx] << std::endl;
+			++failures;
+		}
+		if (!sequential.converged[idx] || !chunked.converged[idx]) {
+			std::cerr << "Time point " << idx << " did not converge" << std::endl;
+			++failures;
+		}
+	}
+
+	// Chunks start cold instead of warm, so the solutions only agree within the solver tolerance
+	Real maxDiff = 0;
+	for (UInt i = 0; i < sequential.voltages.size(); ++i)
+		maxDiff = std::max(maxDiff, std::abs(sequential.voltages[i] - chunked.voltages[i]));
+	if (maxDiff > 1e-6 * 20e3) {
+		std::cerr << "Node voltages of the chunked run differ by up to " << maxDiff << " V" << std::endl;
+		++failures;
+	}
+
+	if (failures == 0)
+		std::cout << "Chunked time series matches the sequential one within " << maxDiff << " V" << std::endl;
+	return failures == 0 ? 0 : 1;
+}
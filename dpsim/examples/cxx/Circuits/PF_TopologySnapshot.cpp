@@ -0,0 +1,153 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <fstream>
+#include <iostream>
+
+#include <DPsim.h>
+#include <dpsim-models/TopologySnapshot.h>
+
+using namespace DPsim;
+using namespace CPS;
+
+/*
+ * Stores a power flow topology as binary snapshot, restores it and checks
+ * that the restored topology yields the same power flow solution.
+ */
+
+SystemTopology buildSystem(Real Vnom) {
+	auto n1 = SimNode<Complex>::make("n1", PhaseType::Single);
+	auto n2 = SimNode<Complex>::make("n2", PhaseType::Single);
+	auto n3 = SimNode<Complex>::make("n3", PhaseType::Single);
+	auto n4 = SimNode<Complex>::make("n4", PhaseType::Single);
+
+	auto extnet = SP::Ph1::NetworkInjection::make("Slack", Logger::Level::off);
+	extnet->setParameters(1.02 * Vnom);
+	extnet->setBaseVoltage(Vnom);
+	extnet->modifyPowerFlowBusType(PowerflowBusType::VD);
+
+	auto gen = SP::Ph1::SynchronGenerator::make("Gen", Logger::Level::off);
+	gen->setParameters(5e6, Vnom, 1e6, 1.01 * Vnom, PowerflowBusType::PV);
+	gen->setBaseVoltage(Vnom);
+
+	auto line12 = SP::Ph1::PiLine::make("Line12", Logger::Level::off);
+	line12->setParameters(0.5, 1e-3, 1e-8, 1e-6);
+	line12->setBaseVoltage(Vnom);
+	auto line23 = SP::Ph1::PiLine::make("Line23", Logger::Level::off);
+	line23->setParameters(0.4, 2e-3, 1e-8, 1e-6);
+	line23->setBaseVoltage(Vnom);
+
+	auto trafo = SP::Ph1::Transformer::make("Trafo", Logger::Level::off);
+	trafo->setParameters(Vnom, Vnom, 10e6, 1.02, 0.0, 0.5, 5e-3);
+	trafo->setBaseVoltage(Vnom);
+
+	auto load3 = SP::Ph1::Load::make("Load3", Logger::Level::off);
+	load3->setParameters(1e6, 3e5, Vnom);
+	load3->modifyPowerFlowBusType(PowerflowBusType::PQ);
+	auto load4 = SP::Ph1::Load::make("Load4", Logger::Level::off);
+	load4->setParameters(2e6, 5e5, Vnom);
+	load4->modifyPowerFlowBusType(PowerflowBusType::PQ);
+
+	auto shunt = SP::Ph1::Shunt::make("Shunt", Logger::Level::off);
+	shunt->setParameters(1e-6, 2e-5);
+	shunt->setBaseVoltage(Vnom);
+
+	extnet->connect({ n1 });
+	line12->connect({ n1, n2 });
+	gen->connect({ n2 });
+	line23->connect({ n2, n3 });
+	load3->connect({ n3 });
+	shunt->connect({ n3 });
+	trafo->connect({ n3, n4 });
+	load4->connect({ n4 });
+
+	return SystemTopology(50,
+		SystemNodeList{ n1, n2, n3, n4 },
+		SystemComponentList{ extnet, gen, line12, line23, trafo, load3, load4, shunt });
+}
+
+std::vector<Complex> solvePowerflow(SystemTopology &system, const String &simName) {
+	Simulation sim(simName, Logger::Level::off);
+	sim.setSystem(system);
+	sim.setTimeStep(1);
+	sim.setFinalTime(1);
+	sim.setDomain(Domain::SP);
+	sim.setSolverType(Solver::Type::NRP);
+	sim.setSolverAndComponentBehaviour(Solver::Behaviour::Initialization);
+	sim.doInitFromNodesAndTerminals(true);
+	sim.run();
+
+	std::vector<Complex> voltages;
+	for (auto node : system.mNodes)
+		voltages.push_back(std::dynamic_pointer_cast<SimNode<Complex>>(node)->singleVoltage());
+	return voltages;
+}
+
+int main(int argc, char* argv[]) {
+	String simName = "PF_TopologySnapshot";
+	Logger::setLogDir("logs/" + simName);
+	fs::path snapshotDir = "logs/" + simName + "/snapshots";
+	fs::path snapshotFile = snapshotDir / "grid.snapshot";
+	int failures = 0;
+
+	auto original = buildSystem(20e3);
+	TopologySnapshot snapshot(simName, Logger::Level::info);
+	if (!snapshot.write(original, snapshotFile, "grid")) {
+		std::cerr << "Writing the snapshot failed" << std::endl;
+		return 1;
+	}
+
+	SystemTopology restored;
+	if (!snapshot.read(snapshotFile, "grid", restored)) {
+		std::cerr << "Reading the snapshot failed" << std::endl;
+		return 1;
+	}
+	if (restored.mNodes.size() != original.mNodes.size() || restored.mComponents.size() != original.mComponents.size()) {
+		std::cerr << "Restored topology has a different size" << std::endl;
+		++failures;
+	}
+
+	// Snapshots of other keys, missing and damaged snapshots are not read
+	SystemTopology ignored;
+	if (snapshot.read(snapshotFile, "other", ignored)) {
+		std::cerr << "Snapshot with another key was read" << std::endl;
+		++failures;
+	}
+	std::ifstream in(snapshotFile.string(), std::ios::binary);
+	String content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+	fs::path truncatedFile = snapshotDir / "truncated.snapshot";
+	std::ofstream(truncatedFile.string(), std::ios::binary).write(content.data(), content.size() / 2);
+	if (snapshot.read(truncatedFile, "grid", ignored) || snapshot.read(snapshotDir / "missing.snapshot", "grid", ignored)) {
+		std::cerr << "Truncated or missing snapshot was read" << std::endl;
+		++failures;
+	}
+
+	// Failing to store a snapshot is reported, but does not throw
+	fs::path blockingFile = snapshotDir / "not_a_directory";
+	std::ofstream(blockingFile.string()) << "blocks the snapshot directory";
+	if (snapshot.write(original, blockingFile / "grid.snapshot", "grid")) {
+		std::cerr << "Snapshot below a regular file was reported as written" << std::endl;
+		++failures;
+	}
+
+	// The restored topology yields the same power flow solution
+	auto originalVoltages = solvePowerflow(original, simName + "_Original");
+	auto restoredVoltages = solvePowerflow(restored, simName + "_Restored");
+	for (UInt i = 0; i < originalVoltages.size(); ++i) {
+		Real diff = std::abs(originalVoltages[i] - restoredVoltages[i]);
+		if (diff > 1e-9 * std::abs(originalVoltages[i])) {
+			std::cerr << "Voltage of node " << i << " differs by " << diff << std::endl;
+			++failures;
+		}
+	}
+
+	if (failures == 0)
+		std::cout << "Snapshot round trip reproduces the power flow of "
+			<< originalVoltages.size() << " nodes" << std::endl;
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,146 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <DPsim.h>
+#include "../ResultComparison.h"
+
+using namespace DPsim;
+using namespace CPS;
+
+/*
+ * Simulates a DP grid with an inverter, a pi-line and a switched fault and an
+ * EMT three phase circuit with a pi-line and a breaker, once with dense and
+ * once with compact right vector contributions of the components. The inverter
+ * and the lines are composite components with nested pre-steps. All components
+ * except the breaker have to switch to compact right vectors and node voltages
+ * have to be the same in every step.
+ */
+
+const Real timeStep = 1e-4;
+const Real finalTime = 0.1;
+
+int failures = 0;
+
+/// Simulate the system and return the voltages of the given nodes in every step
+template <typename VarType>
+std::vector<CPS::MatrixVar<VarType>> simulate(const String& simName, Domain domain, SystemTopology system,
+	typename SimNode<VarType>::List nodes, std::shared_ptr<Event> event, Bool sparse) {
+	Simulation sim(simName, Logger::Level::off);
+	sim.setSystem(system);
+	sim.setTimeStep(timeStep);
+	sim.setFinalTime(finalTime);
+	sim.setDomain(domain);
+	sim.setDirectLinearSolverImplementation(DirectLinearSolverImpl::SparseLU);
+	sim.doSparseRightVectorStamping(sparse);
+	sim.addEvent(event);
+
+	std::vector<typename CPS::Attribute<CPS::MatrixVar<VarType>>::Ptr> voltages;
+	for (auto node : nodes)
+		voltages.push_back(node->mVoltage);
+	auto results = ResultComparison::recordSteps<VarType>(sim, voltages);
+
+	for (auto comp : system.mComponents) {
+		// Switches that are no variable components are not part of the right vector
+		auto mnaComp = std::dynamic_pointer_cast<MNAInterface>(comp);
+		if (!mnaComp || (std::dynamic_pointer_cast<MNASwitchInterface>(comp) && !std::dynamic_pointer_cast<MNAVariableCompInterface>(comp)))
+			continue;
+		UInt compactRows = static_cast<UInt>(mnaComp->getCompactRightVector()->get().rows());
+		failures += ResultComparison::expect(mnaComp->hasCompactRightVector() == sparse, simName + ": "
+			+ comp->name() + (sparse ? " has no" : " has a") + " compact right vector");
+		failures += ResultComparison::expect(compactRows == (sparse ? mnaComp->getRightVectorIndices().size() : 0),
+			simName + ": compact right vector of " + comp->name() + " has " + std::to_string(compactRows) + " rows");
+	}
+	return results;
+}
+
+std::vector<MatrixComp> simulateDP(Bool sparse) {
+	Real Vnom = 3300.;
+	Real rf = 0.01, lf = 0.928e-3, cf = 789.3e-6, rc = 0.5;
+
+	auto n1 = SimNode<Complex>::make("n1");
+	auto n2 = SimNode<Complex>::make("n2");
+	auto n3 = SimNode<Complex>::make("n3");
+	auto n4 = SimNode<Complex>::make("n4");
+
+	auto vs = DP::Ph1::VoltageSource::make("vs");
+	vs->setParameters(Complex(Vnom, 0));
+	auto piline = DP::Ph1::PiLine::make("piline");
+	piline->setParameters(0.04, lf * 0.1, cf);
+	auto vsi = DP::Ph1::AvVoltageSourceInverterDQ::make("vsi", "vsi", Logger::Level::off, true);
+	vsi->setParameters(2 * PI * 50, Vnom, 30000, 200);
+	vsi->setControllerParameters(0.25, 2, 0.001, 0.08, 3.77, 1400, 2 * PI * 50);
+	vsi->setFilterParameters(lf, cf, rf, rc);
+	vsi->setTransformerParameters(Vnom, Vnom, 50000, 1, 0, 0, lf);
+	auto rline = DP::Ph1::Resistor::make("r_line");
+	rline->setParameters(0.04);
+	auto rload = DP::Ph1::Resistor::make("r_load");
+	rload->setParameters(48.4);
+	auto lload = DP::Ph1::Inductor::make("l_load");
+	lload->setParameters(1.54);
+	auto fault = DP::Ph1::varResSwitch::make("fault");
+	fault->setParameters(1e6, 10);
+	fault->setInitParameters(timeStep);
+	fault->open();
+
+	vs->connect({ SimNode<Complex>::GND, n1 });
+	piline->connect({ n1, n2 });
+	vsi->connect({ n2 });
+	rline->connect({ n2, n3 });
+	rload->connect({ n3, n4 });
+	lload->connect({ n4, SimNode<Complex>::GND });
+	fault->connect({ n3, SimNode<Complex>::GND });
+
+	auto system = SystemTopology(50, SystemNodeList{ n1, n2, n3, n4 },
+		SystemComponentList{ vs, piline, vsi, rline, rload, lload, fault });
+	for (auto node : system.mNodes)
+		node->setInitialVoltage(Complex(Vnom, 0));
+
+	return simulate<Complex>(sparse ? "DP_Sparse" : "DP_Dense", Domain::DP, system,
+		{ n1, n2, n3, n4 }, SwitchEvent::make(finalTime / 2, fault, true), sparse);
+}
+
+std::vector<Matrix> simulateEMTPh3(Bool sparse) {
+	auto n1 = SimNode<Real>::make("n1", PhaseType::ABC);
+	auto n2 = SimNode<Real>::make("n2", PhaseType::ABC);
+	auto n3 = SimNode<Real>::make("n3", PhaseType::ABC);
+
+	auto vs = EMT::Ph3::VoltageSource::make("vs");
+	vs->setParameters(CPS::Math::singlePhaseVariableToThreePhase(Complex(1000, 0)), 50);
+	auto piline = EMT::Ph3::PiLine::make("piline");
+	piline->setParameters(0.5 * Matrix::Identity(3, 3), 5e-3 * Matrix::Identity(3, 3), 1e-6 * Matrix::Identity(3, 3));
+	auto rload = EMT::Ph3::Resistor::make("r_load");
+	rload->setParameters(20 * Matrix::Identity(3, 3));
+	auto lload = EMT::Ph3::Inductor::make("l_load");
+	lload->setParameters(0.02 * Matrix::Identity(3, 3));
+	auto breaker = EMT::Ph3::Switch::make("breaker");
+	breaker->setParameters(1e6 * Matrix::Identity(3, 3), 0.1 * Matrix::Identity(3, 3));
+	breaker->openSwitch();
+
+	vs->connect({ SimNode<Real>::GND, n1 });
+	piline->connect({ n1, n2 });
+	rload->connect({ n2, n3 });
+	lload->connect({ n3, SimNode<Real>::GND });
+	breaker->connect({ n2, SimNode<Real>::GND });
+
+	auto system = SystemTopology(50, SystemNodeList{ n1, n2, n3 },
+		SystemComponentList{ vs, piline, rload, lload, breaker });
+
+	return simulate<Real>(sparse ? "EMT_Ph3_Sparse" : "EMT_Ph3_Dense", Domain::EMT, system,
+		{ n1, n2, n3 }, SwitchEvent3Ph::make(finalTime / 2, breaker, true), sparse);
+}
+
+int main(int argc, char* argv[]) {
+	Logger::setLogDir("logs/SparseRightVectorStamping");
+
+	failures += ResultComparison::compare<Complex>("DP", simulateDP(false), simulateDP(true));
+	failures += ResultComparison::compare<Real>("EMT three phase", simulateEMTPh3(false), simulateEMTPh3(true));
+
+	if (failures == 0)
+		std::cout << "Compact right vector contributions match the dense summation" << std::endl;
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,134 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <DPsim.h>
+#include "../ResultComparison.h"
+
+using namespace DPsim;
+using namespace CPS;
+
+/*
+ * Simulates RLC circuits in DP, EMT single phase and EMT three phase with the
+ * companion models of inductors and capacitors updated per component and in
+ * bulk. The inductor and the capacitor of each circuit have to be updated in
+ * bulk and node voltages and element currents have to be the same in every step.
+ */
+
+const Real timeStep = 1e-4;
+const Real finalTime = 0.05;
+
+int failures = 0;
+
+/// Simulate the circuit and return the voltage of n2 and the inductor current of every step
+template <typename VarType>
+std::vector<CPS::MatrixVar<VarType>> simulate(const String& simName, Domain domain, SystemTopology system,
+	typename SimNode<VarType>::Ptr node, typename SimPowerComp<VarType>::Ptr inductor, Bool vectorize) {
+	Simulation sim(simName, Logger::Level::off);
+	sim.setSystem(system);
+	sim.setTimeStep(timeStep);
+	sim.setFinalTime(finalTime);
+	sim.setDomain(domain);
+	sim.setDirectLinearSolverImplementation(DirectLinearSolverImpl::SparseLU);
+	sim.doVectorizeLinearElements(vectorize);
+
+	auto results = ResultComparison::recordSteps<VarType>(sim, { node->mVoltage, inductor->mIntfCurrent });
+	UInt expected = vectorize ? 2 : 0;
+	failures += ResultComparison::expect(sim.numVectorizedLinearElements() == expected, simName + ": "
+		+ std::to_string(sim.numVectorizedLinearElements()) + " instead of " + std::to_string(expected) + " linear elements updated in bulk");
+	return results;
+}
+
+std::vector<MatrixComp> simulateDP(Bool vectorize) {
+	auto n1 = SimNode<Complex>::make("n1");
+	auto n2 = SimNode<Complex>::make("n2");
+	auto n3 = SimNode<Complex>::make("n3");
+
+	auto vs = DP::Ph1::VoltageSource::make("vs");
+	vs->setParameters(Complex(10, 0));
+	auto r1 = DP::Ph1::Resistor::make("r_1");
+	r1->setParameters(1);
+	auto l1 = DP::Ph1::Inductor::make("l_1");
+	l1->setParameters(0.02);
+	auto c1 = DP::Ph1::Capacitor::make("c_1");
+	c1->setParameters(1e-3);
+	auto r2 = DP::Ph1::Resistor::make("r_2");
+	r2->setParameters(5);
+
+	vs->connect({ SimNode<Complex>::GND, n1 });
+	r1->connect({ n1, n2 });
+	l1->connect({ n2, n3 });
+	c1->connect({ n3, SimNode<Complex>::GND });
+	r2->connect({ n3, SimNode<Complex>::GND });
+
+	auto system = SystemTopology(50, SystemNodeList{ n1, n2, n3 }, SystemComponentList{ vs, r1, l1, c1, r2 });
+	return simulate<Complex>(vectorize ? "DP_Vectorized" : "DP_Reference", Domain::DP, system, n2, l1, vectorize);
+}
+
+std::vector<Matrix> simulateEMT(Bool vectorize) {
+	auto n1 = SimNode<Real>::make("n1");
+	auto n2 = SimNode<Real>::make("n2");
+	auto n3 = SimNode<Real>::make("n3");
+
+	auto vs = EMT::Ph1::VoltageSource::make("vs");
+	vs->setParameters(Complex(10, 0), 50);
+	auto r1 = EMT::Ph1::Resistor::make("r_1");
+	r1->setParameters(1);
+	auto l1 = EMT::Ph1::Inductor::make("l_1");
+	l1->setParameters(0.02);
+	auto c1 = EMT::Ph1::Capacitor::make("c_1");
+	c1->setParameters(1e-3);
+	auto r2 = EMT::Ph1::Resistor::make("r_2");
+	r2->setParameters(5);
+
+	vs->connect({ SimNode<Real>::GND, n1 });
+	r1->connect({ n1, n2 });
+	l1->connect({ n2, n3 });
+	c1->connect({ n3, SimNode<Real>::GND });
+	r2->connect({ n3, SimNode<Real>::GND });
+
+	auto system = SystemTopology(50, SystemNodeList{ n1, n2, n3 }, SystemComponentList{ vs, r1, l1, c1, r2 });
+	return simulate<Real>(vectorize ? "EMT_Vectorized" : "EMT_Reference", Domain::EMT, system, n2, l1, vectorize);
+}
+
+std::vector<Matrix> simulateEMTPh3(Bool vectorize) {
+	auto n1 = SimNode<Real>::make("n1", PhaseType::ABC);
+	auto n2 = SimNode<Real>::make("n2", PhaseType::ABC);
+	auto n3 = SimNode<Real>::make("n3", PhaseType::ABC);
+
+	auto vs = EMT::Ph3::VoltageSource::make("vs");
+	vs->setParameters(CPS::Math::singlePhaseVariableToThreePhase(Complex(10, 0)), 50);
+	auto r1 = EMT::Ph3::Resistor::make("r_1");
+	r1->setParameters(Matrix::Identity(3, 3));
+	auto l1 = EMT::Ph3::Inductor::make("l_1");
+	l1->setParameters(0.02 * Matrix::Identity(3, 3));
+	auto c1 = EMT::Ph3::Capacitor::make("c_1");
+	c1->setParameters(1e-3 * Matrix::Identity(3, 3));
+	auto r2 = EMT::Ph3::Resistor::make("r_2");
+	r2->setParameters(5 * Matrix::Identity(3, 3));
+
+	vs->connect({ SimNode<Real>::GND, n1 });
+	r1->connect({ n1, n2 });
+	l1->connect({ n2, n3 });
+	c1->connect({ n3, SimNode<Real>::GND });
+	r2->connect({ n3, SimNode<Real>::GND });
+
+	auto system = SystemTopology(50, SystemNodeList{ n1, n2, n3 }, SystemComponentList{ vs, r1, l1, c1, r2 });
+	return simulate<Real>(vectorize ? "EMT_Ph3_Vectorized" : "EMT_Ph3_Reference", Domain::EMT, system, n2, l1, vectorize);
+}
+
+int main(int argc, char* argv[]) {
+	Logger::setLogDir("logs/VectorizedLinearElements");
+
+	failures += ResultComparison::compare<Complex>("DP", simulateDP(false), simulateDP(true));
+	failures += ResultComparison::compare<Real>("EMT", simulateEMT(false), simulateEMT(true));
+	failures += ResultComparison::compare<Real>("EMT three phase", simulateEMTPh3(false), simulateEMTPh3(true));
+
+	if (failures == 0)
+		std::cout << "Bulk updated linear elements match the per component updates" << std::endl;
+	return failures == 0 ? 0 : 1;
+}
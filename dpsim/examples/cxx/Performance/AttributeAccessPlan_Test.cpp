@@ -0,0 +1,77 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <iostream>
+
+#include <DPsim.h>
+#include <dpsim-models/AttributeAccessPlan.h>
+
+using namespace DPsim;
+using namespace CPS;
+
+// Checks that an attribute access plan reads the same values as `get`,
+// also after the logged attributes have been redirected with setReference.
+
+int check(AttributeAccessPlan& plan, const AttributeBase::List& attributes, const String& stage) {
+	std::vector<Real> values(plan.size());
+	plan.gather(values.data());
+
+	int failures = 0;
+	for (UInt column = 0; column < attributes.size(); column++) {
+		Real expected = std::dynamic_pointer_cast<Attribute<Real>>(attributes[column].getPtr())->get();
+		if (values[column] != expected) {
+			std::cerr << stage << ": column " << column << " is " << values[column]
+				<< " instead of " << expected << std::endl;
+			failures++;
+		}
+	}
+	return failures;
+}
+
+int main(int argc, char* argv[]) {
+	auto voltage = AttributeDynamic<MatrixComp>::make(MatrixComp::Zero(3, 1));
+	voltage->set((MatrixComp(3, 1) << Complex(1, 2), Complex(3, 4), Complex(5, 6)).finished());
+	auto current = AttributeStatic<Real>::make(7);
+
+	AttributeBase::List attributes;
+	for (UInt row = 0; row < 3; row++) {
+		auto coeff = voltage->deriveCoeff<Complex>(row, 0);
+		attributes.push_back(coeff->deriveReal());
+		attributes.push_back(coeff->deriveImag());
+	}
+	attributes.push_back(current);
+
+	AttributeAccessPlan plan;
+	for (auto& attr : attributes)
+		plan.add(attr);
+	plan.compile();
+
+	int failures = check(plan, attributes, "compiled");
+	if (plan.numDirect() != plan.size()) {
+		std::cerr << "Only " << plan.numDirect() << " of " << plan.size() << " columns are read directly" << std::endl;
+		failures++;
+	}
+
+	voltage->set((MatrixComp(3, 1) << Complex(-1, -2), Complex(-3, -4), Complex(-5, -6)).finished());
+	failures += check(plan, attributes, "updated");
+
+	// Redirect logged attributes to other storage, the plan has to follow
+	auto replacement = AttributeStatic<Real>::make(42);
+	auto dynamicReplacement = AttributeDynamic<Real>::make(43);
+	std::dynamic_pointer_cast<Attribute<Real>>(attributes[0].getPtr())->setReference(replacement);
+	std::dynamic_pointer_cast<Attribute<Real>>(attributes[3].getPtr())->setReference(dynamicReplacement);
+	failures += check(plan, attributes, "redirected");
+
+	dynamicReplacement->set(44);
+	failures += check(plan, attributes, "redirected and updated");
+
+	if (failures == 0)
+		std::cout << "Access plan with " << plan.size() << " columns in " << plan.numRuns()
+			<< " runs reads the attribute values" << std::endl;
+	return failures == 0 ? 0 : 1;
+}
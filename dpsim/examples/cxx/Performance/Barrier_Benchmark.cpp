@@ -0,0 +1,125 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <algorithm>
+#include <iostream>
+#include <thread>
+
+#include <DPsim.h>
+#include <dpsim/Scheduler.h>
+
+using namespace DPsim;
+
+// Measures the latency of the barrier types against the number of threads.
+// Every thread passes the barrier in a loop, the simulation thread records
+// the time between two releases.
+//
+// Options:
+//   -o barrier=<name>       spin, condition, hybrid, tree or all (default: all)
+//   -o threads=<n>          maximum number of threads (default: number of hardware threads)
+//   -o iterations=<n>       barrier episodes per measurement (default: 100000)
+//
+// The threads can be pinned with --cpus, --rt-priority and --mlock.
+
+/// Scheduler without tasks, only used to apply the thread placement
+class PlacementScheduler : public Scheduler {
+public:
+	PlacementScheduler(const ThreadPlacement& placement) { setThreadPlacement(placement); }
+	void createSchedule(const CPS::Task::List&, const Edges&, const Edges&) { }
+	void step(Real, Int) { }
+	void place(Int thread) { applyThreadPlacement(thread); }
+};
+
+void benchmark(const String& name, BarrierType type, Int threads, Int iterations, PlacementScheduler& placement) {
+	Barrier barrier(threads, type);
+	std::vector<std::thread> workers;
+	for (Int idx = 1; idx < threads; idx++) {
+		workers.emplace_back([&barrier, &placement, idx, iterations]() {
+			placement.place(idx);
+			// One additional episode to start the measurement at the same time
+			for (Int i = 0; i <= iterations; i++)
+				barrier.wait(idx);
+		});
+	}
+	placement.place(0);
+
+	std::vector<Real> latencies(iterations);
+	barrier.wait(0);
+	auto last = std::chrono::steady_clock::now();
+	for (Int i = 0; i < iterations; i++) {
+		barrier.wait(0);
+		auto now = std::chrono::steady_clock::now();
+		latencies[i] = std::chrono::duration<Real, std::nano>(now - last).count();
+		last = now;
+	}
+	for (auto& worker : workers)
+		worker.join();
+
+	std::sort(latencies.begin(), latencies.end());
+	Real sum = 0;
+	for (Real latency : latencies)
+		sum += latency;
+	std::cout << name << ", " << threads << " threads: "
+		<< "mean " << sum / iterations << " ns, "
+		<< "p50 " << latencies[iterations / 2] << " ns, "
+		<< "p99 " << latencies[static_cast<size_t>(iterations * 0.99)] << " ns, "
+		<< "max " << latencies.back() << " ns" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+	CommandLineArgs args(argc, argv, "Barrier_Benchmark");
+
+	String barrierName = "all";
+	Int maxThreads = std::max<Int>(std::thread::hardware_concurrency(), 1);
+	Int iterations = 100000;
+
+	if (args.options.find("barrier") != args.options.end())
+		barrierName = args.getOptionString("barrier");
+	if (args.options.find("threads") != args.options.end())
+		maxThreads = args.getOptionInt("threads");
+	if (args.options.find("iterations") != args.options.end())
+		iterations = args.getOptionInt("iterations");
+	// The percentiles index the sorted latencies
+	if (iterations < 1) {
+		std::cout << "Number of iterations has to be at least one" << std::endl;
+		return 1;
+	}
+	if (maxThreads < 1) {
+		std::cout << "Number of threads has to be at least one" << std::endl;
+		return 1;
+	}
+
+	std::vector<std::pair<String, BarrierType>> barriers = {
+		{ "spin", BarrierType::Spin },
+		{ "condition", BarrierType::Condition },
+		{ "hybrid", BarrierType::Hybrid },
+		{ "tree", BarrierType::Tree }
+	};
+	if (barrierName != "all") {
+		barriers.erase(std::remove_if(barriers.begin(), barriers.end(),
+			[&barrierName](const std::pair<String, BarrierType>& barrier) { return barrier.first != barrierName; }),
+			barriers.end());
+		if (barriers.empty()) {
+			std::cout << "Unknown barrier " << barrierName << std::endl;
+			return 1;
+		}
+	}
+
+	PlacementScheduler placement(args.threadPlacement);
+
+	// Powers of two up to the maximum number of threads
+	std::vector<Int> threadCounts;
+	for (Int threads = 1; threads < maxThreads; threads *= 2)
+		threadCounts.push_back(threads);
+	threadCounts.push_back(maxThreads);
+
+	for (auto& barrier : barriers) {
+		for (Int threads : threadCounts)
+			benchmark(barrier.first, barrier.second, threads, iterations, placement);
+	}
+}
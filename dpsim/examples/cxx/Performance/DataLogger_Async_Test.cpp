@@ -0,0 +1,98 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include <DPsim.h>
+
+using namespace DPsim;
+using namespace CPS;
+
+// Logs a counter with the asynchronous writer into small queues and checks
+// the written rows against the dropped and stalled row counts.
+
+/// Read the counter column of a CSV log
+std::vector<Real> readCounter(const String& filename) {
+	std::ifstream file(filename);
+	std::vector<Real> values;
+	String line;
+	std::getline(file, line);
+	while (std::getline(file, line)) {
+		std::istringstream row(line);
+		String time, value;
+		std::getline(row, time, ',');
+		std::getline(row, value, ',');
+		values.push_back(std::stod(value));
+	}
+	return values;
+}
+
+int main(int argc, char* argv[]) {
+	String simName = "DataLogger_Async_Test";
+	Logger::setLogDir("logs/" + simName);
+	const Int numRows = 20000;
+	int failures = 0;
+
+	auto counter = AttributeStatic<Real>::make(0);
+
+	// Blocking mode: every row is written, some rows wait for the writer
+	auto blocking = DataLogger::make(String("blocking"));
+	blocking->doAsyncWriting(true, 4);
+	blocking->doBlockOnFullQueue(true);
+	blocking->logAttribute("counter", counter);
+	for (Int step = 0; step < numRows; step++) {
+		counter->set(step);
+		blocking->log(step * 1e-3, step);
+	}
+	blocking->close();
+
+	auto values = readCounter("logs/" + simName + "/blocking.csv");
+	if (values.size() != static_cast<std::size_t>(numRows) || blocking->droppedRows() != 0) {
+		std::cerr << "Blocking logger wrote " << values.size() << " of " << numRows
+			<< " rows and dropped " << blocking->droppedRows() << std::endl;
+		failures++;
+	}
+	for (std::size_t row = 0; row < values.size(); row++) {
+		if (values[row] != row) {
+			std::cerr << "Blocking logger wrote " << values[row] << " in row " << row << std::endl;
+			failures++;
+			break;
+		}
+	}
+
+	// Dropping mode: written and dropped rows add up, the order is kept
+	auto dropping = DataLogger::make(String("dropping"));
+	dropping->doAsyncWriting(true, 1);
+	dropping->logAttribute("counter", counter);
+	for (Int step = 0; step < numRows; step++) {
+		counter->set(step);
+		dropping->log(step * 1e-3, step);
+	}
+	dropping->close();
+
+	values = readCounter("logs/" + simName + "/dropping.csv");
+	if (values.size() + dropping->droppedRows() != static_cast<std::size_t>(numRows) || dropping->stalledRows() != 0) {
+		std::cerr << "Dropping logger wrote " << values.size() << " rows, dropped " << dropping->droppedRows()
+			<< " and stalled " << dropping->stalledRows() << " of " << numRows << " rows" << std::endl;
+		failures++;
+	}
+	for (std::size_t row = 1; row < values.size(); row++) {
+		if (values[row] <= values[row - 1]) {
+			std::cerr << "Dropping logger wrote rows out of order" << std::endl;
+			failures++;
+			break;
+		}
+	}
+
+	if (failures == 0)
+		std::cout << "Blocking logger stalled " << blocking->stalledRows() << " rows, dropping logger dropped "
+			<< dropping->droppedRows() << " of " << numRows << " rows" << std::endl;
+	return failures == 0 ? 0 : 1;
+}
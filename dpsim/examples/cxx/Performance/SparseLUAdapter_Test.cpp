@@ -0,0 +1,120 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <iostream>
+#include <random>
+
+#include <DPsim.h>
+#include <dpsim/SparseLUAdapter.h>
+
+using namespace DPsim;
+using namespace CPS;
+
+// Compares the substitution of SparseLUAdapter, which does the forward
+// substitution with the supernodal lower factor itself, with the solve of
+// Eigen's SparseLU. The matrix is an unsymmetric grid with a densely coupled
+// block, so the lower factor has supernodes with several columns.
+
+int failures = 0;
+
+void expect(Bool condition, const String& message) {
+	if (!condition) {
+		std::cerr << message << std::endl;
+		failures++;
+	}
+}
+
+DPsim::SparseMatrix gridMatrix(UInt size, UInt blockSize, std::mt19937& generator) {
+	std::uniform_real_distribution<Real> distribution(0.5, 1.5);
+	std::vector<Eigen::Triplet<Real>> entries;
+	auto index = [size](UInt row, UInt col) { return row * size + col; };
+
+	for (UInt row = 0; row < size; ++row) {
+		for (UInt col = 0; col < size; ++col) {
+			UInt k = index(row, col);
+			entries.emplace_back(k, k, 6.);
+			if (col + 1 < size) {
+				entries.emplace_back(k, index(row, col + 1), -distribution(generator));
+				entries.emplace_back(index(row, col + 1), k, -distribution(generator));
+			}
+			if (row + 1 < size) {
+				entries.emplace_back(k, index(row + 1, col), -distribution(generator));
+				entries.emplace_back(index(row + 1, col), k, -distribution(generator));
+			}
+		}
+	}
+
+	// Densely coupled nodes in the middle of the grid
+	UInt first = index(size / 2, 0);
+	for (UInt i = first; i < first + blockSize; ++i) {
+		entries.emplace_back(i, i, blockSize);
+		for (UInt j = first; j < first + blockSize; ++j) {
+			if (i != j)
+				entries.emplace_back(i, j, -0.5 * distribution(generator));
+		}
+	}
+
+	DPsim::SparseMatrix matrix(size * size, size * size);
+	matrix.setFromTriplets(entries.begin(), entries.end());
+	matrix.makeCompressed();
+	return matrix;
+}
+
+Real maxDifference(const Matrix& a, const Matrix& b) {
+	return (a - b).cwiseAbs().maxCoeff();
+}
+
+int main(int argc, char* argv[]) {
+	const UInt size = 20;
+	const UInt blockSize = 30;
+	const Real tolerance = 1e-10;
+
+	std::mt19937 generator(42);
+	DPsim::SparseMatrix matrix = gridMatrix(size, blockSize, generator);
+	Matrix rightSides = Matrix::Random(matrix.rows(), 5);
+
+	Eigen::SparseLU<DPsim::SparseMatrix, Eigen::COLAMDOrdering<int>> reference;
+	reference.compute(matrix);
+	expect(reference.info() == Eigen::Success, "Eigen's factorization failed");
+	Matrix expected = reference.solve(rightSides);
+	expect((matrix * expected - rightSides).cwiseAbs().maxCoeff() < tolerance, "Eigen's solution does not solve the system");
+
+#if EIGEN_VERSION_AT_LEAST(3,4,0) && !EIGEN_VERSION_AT_LEAST(3,4,90)
+	// The adapter only uses its own forward substitution for Eigen 3.4
+	const auto& lower = reference.matrixL().m_mapL;
+	Bool hasSupernodes = false;
+	for (Eigen::Index k = 0; k <= lower.nsuper(); ++k)
+		hasSupernodes |= lower.supToCol()[k + 1] - lower.supToCol()[k] > 1;
+	expect(hasSupernodes, "The lower factor has no supernodes with several columns");
+#endif
+
+	SparseLUAdapter adapter;
+	std::vector<std::pair<UInt, UInt>> variableEntries;
+	adapter.preprocessing(matrix, variableEntries);
+	adapter.factorize(matrix);
+
+	// Single right hand sides before and after blocks, as in the scenario solves
+	Matrix solution(matrix.rows(), 1);
+	adapter.solveInPlace(rightSides.col(0), solution);
+	expect(maxDifference(solution, expected.col(0)) < tolerance, "Single solution differs from Eigen's solve");
+
+	Matrix block = rightSides;
+	adapter.solveBatch(block);
+	expect(maxDifference(block, expected) < tolerance, "Block of solutions differs from Eigen's solve");
+
+	Matrix pair = rightSides.leftCols(2);
+	adapter.solveBatch(pair);
+	expect(maxDifference(pair, expected.leftCols(2)) < tolerance, "Smaller block differs from Eigen's solve");
+
+	adapter.solveInPlace(rightSides.col(4), solution);
+	expect(maxDifference(solution, expected.col(4)) < tolerance, "Single solution after a block differs from Eigen's solve");
+
+	if (failures == 0)
+		std::cout << "Substitution of SparseLUAdapter matches Eigen's solve" << std::endl;
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,107 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <type_traits>
+
+#include <DPsim.h>
+
+using namespace DPsim;
+using namespace CPS;
+
+// Compares the streaming statistics of TimingStatistics with exact statistics
+// of the same measurements and checks the step times of a short simulation.
+
+// Long real-time runs add more than 2^32 measurements
+static_assert(std::is_same<decltype(std::declval<TimingStatistics>().count()), std::uint64_t>::value,
+	"The measurement count has to be 64 bit");
+
+int failures = 0;
+
+void expect(Bool condition, const String& message) {
+	if (!condition) {
+		std::cerr << message << std::endl;
+		failures++;
+	}
+}
+
+int main(int argc, char* argv[]) {
+	const UInt capacity = 1000;
+	const UInt numSamples = 100000;
+
+	// Log-normally distributed times around 50 us with a few outliers
+	std::mt19937 generator(42);
+	std::lognormal_distribution<Real> distribution(std::log(50e-6), 0.5);
+	std::vector<Real> times(numSamples);
+	for (auto& time : times)
+		time = distribution(generator);
+	times[numSamples / 3] = 0.1;
+	times[numSamples / 2] = 2e-7;
+
+	TimingStatistics statistics(capacity);
+	Real sum = 0;
+	for (Real time : times) {
+		statistics.add(time);
+		sum += time;
+	}
+
+	std::vector<Real> sorted = times;
+	std::sort(sorted.begin(), sorted.end());
+
+	expect(statistics.count() == numSamples, "Wrong number of measurements");
+	expect(statistics.min() == sorted.front(), "Wrong minimum");
+	expect(statistics.max() == sorted.back(), "Wrong maximum");
+	expect(std::abs(statistics.mean() - sum / numSamples) <= 1e-12, "Wrong mean");
+
+	// Percentiles are estimated with a relative error of at most 1/32 (plus rounding to nanoseconds)
+	for (Real p : { 0.1, 1., 10., 50., 90., 99., 99.9, 100. }) {
+		UInt rank = std::max<UInt>(1, static_cast<UInt>(std::ceil(p / 100 * numSamples)));
+		Real exact = sorted[rank - 1];
+		Real estimate = statistics.percentile(p);
+		expect(std::abs(estimate - exact) <= exact / 32 + 1e-9,
+			"Percentile " + std::to_string(p) + " is " + std::to_string(estimate) + " instead of " + std::to_string(exact));
+	}
+
+	// Only the most recent measurements are kept
+	auto samples = statistics.samples();
+	expect(samples.size() == capacity, "Wrong number of kept samples");
+	expect(std::equal(samples.begin(), samples.end(), times.end() - capacity), "Kept samples are not the most recent ones");
+	expect(statistics.last() == times.back(), "Wrong last measurement");
+
+	statistics.reset();
+	expect(statistics.empty() && statistics.samples().empty() && statistics.percentile(50) == 0, "Reset does not discard the measurements");
+
+	// Step times of a simulation with more steps than kept samples
+	auto n1 = SimNode<Complex>::make("n1");
+	auto vs = DP::Ph1::VoltageSource::make("vs");
+	vs->setParameters(Complex(10, 0));
+	auto res = DP::Ph1::Resistor::make("r");
+	res->setParameters(1);
+	vs->connect({ SimNode<Complex>::GND, n1 });
+	res->connect({ n1, SimNode<Complex>::GND });
+
+	Simulation sim("TimingStatistics_Test", Logger::Level::off);
+	sim.setSystem(SystemTopology(50, SystemNodeList{ n1 }, SystemComponentList{ vs, res }));
+	sim.setTimeStep(1e-4);
+	sim.setFinalTime(0.05);
+	sim.setDirectLinearSolverImplementation(DirectLinearSolverImpl::SparseLU);
+	sim.setStepTimesCapacity(100);
+	sim.run();
+
+	auto& stepTimes = sim.stepTimeStatistics();
+	expect(stepTimes.count() == static_cast<UInt>(sim.timeStepCount()), "Step time statistics do not cover all steps");
+	expect(stepTimes.samples().size() == 100, "Wrong number of kept step times");
+	expect(sim.stepTimes() == stepTimes.samples(), "Deprecated step time accessor differs from the statistics");
+	expect(stepTimes.percentile(50) <= stepTimes.max() && stepTimes.percentile(50) >= stepTimes.min(), "Median outside of measured range");
+
+	if (failures == 0)
+		std::cout << "Timing statistics match the exact statistics of " << numSamples << " measurements" << std::endl;
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,110 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <iostream>
+
+#include <DPsim.h>
+#include <dpsim/AllocationCounter.h>
+
+using namespace DPsim;
+using namespace CPS;
+
+// Counts the heap allocations of simulation steps after a few warm-up steps.
+// Steps of the direct MNA solver with the sparse and the dense LU, with
+// scenarios and with low-rank updates of a switched system must not allocate.
+// Requires a build with WITH_ALLOCATION_COUNTER, otherwise the test is skipped.
+
+const Real timeStep = 1e-4;
+const UInt warmUpSteps = 10;
+const UInt numSteps = 500;
+
+int failures = 0;
+
+void check(const String& name, DirectLinearSolverImpl impl, UInt numScenarios, Bool lowRank) {
+	auto n1 = SimNode<Complex>::make("n1");
+	auto n2 = SimNode<Complex>::make("n2");
+	auto n3 = SimNode<Complex>::make("n3");
+
+	auto vs = DP::Ph1::VoltageSource::make("vs");
+	vs->setParameters(Complex(100, 0));
+	auto line = DP::Ph1::Resistor::make("r_line");
+	line->setParameters(1);
+	auto lineL = DP::Ph1::Inductor::make("l_line");
+	lineL->setParameters(1e-3);
+	auto load = DP::Ph1::Resistor::make("r_load");
+	load->setParameters(10);
+	auto cap = DP::Ph1::Capacitor::make("c_load");
+	cap->setParameters(1e-5);
+	auto fault = DP::Ph1::varResSwitch::make("fault");
+	fault->setParameters(1e6, 0.1);
+	fault->setInitParameters(timeStep);
+	fault->open();
+
+	vs->connect({ SimNode<Complex>::GND, n1 });
+	line->connect({ n1, n2 });
+	lineL->connect({ n2, n3 });
+	load->connect({ n3, SimNode<Complex>::GND });
+	cap->connect({ n3, SimNode<Complex>::GND });
+	fault->connect({ n3, SimNode<Complex>::GND });
+
+	auto system = SystemTopology(50, SystemNodeList{ n1, n2, n3 },
+		SystemComponentList{ vs, line, lineL, load, cap, fault });
+
+	Simulation sim(name, Logger::Level::off);
+	sim.setSystem(system);
+	sim.setTimeStep(timeStep);
+	sim.setFinalTime((warmUpSteps + numSteps + 1) * timeStep);
+	sim.setDomain(Domain::DP);
+	sim.setDirectLinearSolverImplementation(impl);
+	sim.setNumberOfScenarios(numScenarios);
+	if (lowRank) {
+		// Toggling the switch changes the system matrix in the following steps,
+		// which is handled by low-rank updates of a frozen pattern
+		sim.doSystemMatrixRecomputation(true);
+		sim.doFreezeSystemMatrixPattern(true);
+		sim.doLowRankSystemMatrixUpdates(true);
+		sim.setMaxLowRankUpdates(numSteps);
+		sim.addEvent(SwitchEvent::make((warmUpSteps + 100) * timeStep, fault, true));
+		sim.addEvent(SwitchEvent::make((warmUpSteps + 300) * timeStep, fault, false));
+	}
+
+	sim.start();
+	for (UInt step = 0; step < warmUpSteps; ++step)
+		sim.next();
+
+	std::size_t allocations = AllocationCounter::count();
+	for (UInt step = 0; step < numSteps; ++step)
+		sim.next();
+	allocations = AllocationCounter::count() - allocations;
+	sim.stop();
+
+	if (allocations > 0) {
+		std::cerr << name << ": " << allocations << " heap allocations in " << numSteps << " steps" << std::endl;
+		failures++;
+	}
+}
+
+int main(int argc, char* argv[]) {
+	if (!AllocationCounter::enabled()) {
+		std::cout << "Skipped, heap allocations are only counted with WITH_ALLOCATION_COUNTER" << std::endl;
+		return 0;
+	}
+	Logger::setLogDir("logs/ZeroAllocationStep_Test");
+	// The first output allocates the stdout buffer, events print their time within the counted steps
+	std::cout << "Counting heap allocations of " << numSteps << " steps" << std::endl;
+
+	check("ZeroAllocationStep_SparseLU", DirectLinearSolverImpl::SparseLU, 0, false);
+	check("ZeroAllocationStep_DenseLU", DirectLinearSolverImpl::DenseLU, 0, false);
+	check("ZeroAllocationStep_Scenarios", DirectLinearSolverImpl::SparseLU, 4, false);
+	check("ZeroAllocationStep_LowRank", DirectLinearSolverImpl::SparseLU, 0, true);
+	check("ZeroAllocationStep_LowRankScenarios", DirectLinearSolverImpl::SparseLU, 4, true);
+
+	if (failures == 0)
+		std::cout << "Simulation steps do not allocate" << std::endl;
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,64 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <iostream>
+
+#include <DPsim.h>
+
+#pragma once
+
+namespace ResultComparison {
+
+using namespace DPsim;
+using namespace CPS;
+
+/// Run the simulation until its final time and record the values of the attributes after every step
+template <typename VarType>
+std::vector<CPS::MatrixVar<VarType>> recordSteps(Simulation& sim,
+	const std::vector<typename CPS::Attribute<CPS::MatrixVar<VarType>>::Ptr>& attributes) {
+	std::vector<CPS::MatrixVar<VarType>> results;
+	sim.start();
+	while (sim.time() < sim.finalTime()) {
+		sim.next();
+		for (auto attribute : attributes)
+			results.push_back(**attribute);
+	}
+	sim.stop();
+	return results;
+}
+
+/// Compare recorded results with a reference, relative to the largest value of the reference.
+/// Returns the number of failures, so that several comparisons can be summed up.
+template <typename VarType>
+int compare(const String& name, const std::vector<CPS::MatrixVar<VarType>>& reference,
+	const std::vector<CPS::MatrixVar<VarType>>& results, Real relativeTolerance = 1e-10) {
+	if (reference.size() != results.size() || reference.empty()) {
+		std::cerr << name << ": " << results.size() << " instead of " << reference.size() << " results" << std::endl;
+		return 1;
+	}
+	Real maxDiff = 0, maxValue = 0;
+	for (UInt i = 0; i < reference.size(); ++i) {
+		maxDiff = std::max(maxDiff, (reference[i] - results[i]).cwiseAbs().maxCoeff());
+		maxValue = std::max(maxValue, reference[i].cwiseAbs().maxCoeff());
+	}
+	if (maxDiff > relativeTolerance * maxValue) {
+		std::cerr << name << ": results differ by up to " << maxDiff << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+/// Report a failed check. Returns the number of failures like compare.
+inline int expect(Bool condition, const String& message) {
+	if (condition)
+		return 0;
+	std::cerr << message << std::endl;
+	return 1;
+}
+
+}
@@ -0,0 +1,104 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <dpsim/Scheduler.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace DPsim {
+	/// List scheduler with critical path priorities that follows the measured task durations.
+	///
+	/// The duration of every task is tracked as exponential moving average while
+	/// the simulation runs. Tasks are prioritized by their upward rank (length of
+	/// the longest path to the end of the step) and assigned to the thread on
+	/// which they finish earliest, as in HEFT. The per-thread schedules are
+	/// rebuilt every rebalance interval or when the step time regresses, and
+	/// the new schedule replaces the old one at a step boundary.
+	class AdaptiveListScheduler : public Scheduler {
+	public:
+		AdaptiveListScheduler(Int threads = 1, UInt rebalanceInterval = 1000, Real regressionThreshold = 0.2,
+			Real smoothing = 0.1, String inMeasurementFile = String(), String outMeasurementFile = String(),
+			Bool useConditionVariable = false);
+		virtual ~AdaptiveListScheduler();
+
+		void createSchedule(const CPS::Task::List& tasks, const Edges& inEdges, const Edges& outEdges);
+		void step(Real time, Int timeStepCount);
+		void stop();
+		void setBarrierType(BarrierType type) {
+			mStartBarrier.setType(type);
+			mEndBarrier.setType(type);
+		}
+
+		/// Number of times the schedule has been rebuilt after the initial schedule
+		UInt numRebalances() const { return mNumRebalances; }
+
+	private:
+		/// Per-thread lists of task indices in execution order
+		typedef std::vector<std::vector<UInt>> Schedule;
+
+		/// Rebuild the per-thread lists from the current duration estimates
+		void buildSchedule(Schedule& schedule);
+		/// Rebuild the schedule into the inactive buffer and activate it
+		void rebalance();
+		void doStep(Int thread);
+		/// Stop and join the worker threads
+		void joinThreads();
+		static void threadFunction(AdaptiveListScheduler* sched, Int idx);
+
+		Int mNumThreads;
+		UInt mRebalanceInterval;
+		Real mRegressionThreshold;
+		Real mSmoothing;
+		String mInMeasurementFile;
+		String mOutMeasurementFile;
+		Barrier mStartBarrier;
+		Barrier mEndBarrier;
+		std::vector<std::thread> mThreads;
+
+		/// Tasks to execute in topological order
+		std::vector<CPS::Task*> mTasks;
+		/// Indices of the predecessors of each task
+		std::vector<std::vector<UInt>> mPredecessors;
+		/// Indices of the successors of each task
+		std::vector<std::vector<UInt>> mSuccessors;
+
+		/// Per-task state, padded to avoid false sharing between threads
+		struct alignas(64) TaskState {
+			/// Index of the last step in which the task has finished
+			std::atomic<UInt> finishedStep { 0 };
+			/// Moving average of the execution time in nanoseconds
+			Real duration = 1;
+		};
+		std::unique_ptr<TaskState[]> mStates;
+
+		/// Double-buffered schedules, the active one is only switched between steps
+		Schedule mSchedules[2];
+		std::atomic<Schedule*> mActiveSchedule { nullptr };
+
+		/// Number of executed steps, starts at 1 so that finished steps are never 0
+		UInt mStepIndex = 0;
+		/// Steps since the last rebuild of the schedule
+		UInt mStepsSinceRebalance = 0;
+		/// Moving average of the step time
+		Real mStepTime = 0;
+		/// Step time right after the last rebuild, used to detect regressions
+		Real mReferenceStepTime = 0;
+		/// Number of steps after a rebuild at which the reference step time is taken
+		UInt mReferenceSteps;
+		UInt mNumRebalances = 0;
+
+		Bool mJoining = false;
+		Real mTime = 0;
+		Int mTimeStepCount = 0;
+	};
+}
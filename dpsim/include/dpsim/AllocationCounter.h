@@ -0,0 +1,33 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+
+#include <dpsim/Config.h>
+
+namespace DPsim {
+
+	/// Counts the heap allocations of the whole process. Counting is only
+	/// active if DPsim is built with WITH_ALLOCATION_COUNTER, which replaces
+	/// the allocation functions and should only be used for debugging.
+	class AllocationCounter {
+	public:
+		/// Number of heap allocations since program start (zero if counting is disabled)
+		static std::size_t count();
+		/// Check if heap allocations are counted
+		static constexpr bool enabled() {
+#ifdef WITH_ALLOCATION_COUNTER
+			return true;
+#else
+			return false;
+#endif
+		}
+	};
+}
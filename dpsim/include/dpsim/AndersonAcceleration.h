@@ -0,0 +1,81 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <dpsim/Definitions.h>
+#include <dpsim-models/Attribute.h>
+
+namespace DPsim {
+	/// \brief Anderson acceleration of a fixed-point iteration on attribute values.
+	///
+	/// The state of the iteration is given by a set of attributes, e.g. the
+	/// previous step dependencies of the tasks of a solver. After every
+	/// iteration, the new state is replaced by a combination of the last
+	/// iterates that minimizes the residual in the least squares sense.
+	/// The history is discarded when the residual grows, so the iteration
+	/// falls back to plain fixed-point steps if the extrapolation does not help.
+	class AndersonAcceleration {
+	public:
+		/// The depth is the maximum number of previous iterates used for the extrapolation
+		AndersonAcceleration(UInt depth = 5) : mDepth(depth) { }
+
+		/// Set the attributes holding the state, only Real, Complex, Matrix and MatrixComp
+		/// attributes are supported, others are ignored. Stores the current state as start value.
+		void setAttributes(const std::vector<CPS::AttributeBase::Ptr>& attributes);
+		/// Number of real values in the state
+		UInt size() const { return static_cast<UInt>(mState.rows()); }
+
+		/// Read the result of the iteration from the attributes and write the extrapolated state back
+		void update();
+		/// Discard the previous iterates
+		void reset();
+
+	private:
+		/// Copy the attribute values into a vector
+		void gather(Matrix& state) const;
+		/// Copy a vector into the attribute values
+		void scatter(const Matrix& state);
+
+		/// Attribute holding a part of the state, exactly one pointer is set
+		struct StateAttribute {
+			std::shared_ptr<CPS::Attribute<Real>> real;
+			std::shared_ptr<CPS::Attribute<Complex>> complex;
+			std::shared_ptr<CPS::Attribute<Matrix>> matrix;
+			std::shared_ptr<CPS::Attribute<MatrixComp>> matrixComp;
+		};
+
+		///
+		UInt mDepth;
+		/// Attributes holding the state
+		std::vector<StateAttribute> mAttributes;
+		/// State before the last iteration
+		Matrix mState;
+		/// Result of the last iteration
+		Matrix mResult;
+		/// Residual of the last iteration
+		Matrix mResidual;
+		/// Result and residual of the previous iteration
+		Matrix mPrevResult, mPrevResidual;
+		/// Weights of the previous iterates and extrapolated state
+		Matrix mGamma, mExtrapolated;
+		/// Differences of successive results and residuals, one column per iterate
+		Matrix mResultDiffs, mResidualDiffs;
+		/// Least squares solver for the weights
+		Eigen::ColPivHouseholderQR<Matrix> mQR;
+		/// Number of valid columns in the difference matrices
+		UInt mNumDiffs = 0;
+		/// Next column to be replaced in the difference matrices
+		UInt mNextDiff = 0;
+		/// Norm of the previous residual, negative if there is no previous iterate
+		Real mPrevResidualNorm = -1;
+	};
+}
@@ -8,15 +8,24 @@
 
 #pragma once
 
+#include <algorithm>
 #include <map>
 #include <iostream>
 #include <fstream>
+#include <limits>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include <readerwriterqueue.h>
 
 #include <dpsim/Definitions.h>
 #include <dpsim/Scheduler.h>
 #include <dpsim-models/Filesystem.h>
 #include <dpsim-models/PtrFactory.h>
 #include <dpsim-models/Attribute.h>
+#include <dpsim-models/AttributeAccessPlan.h>
 #include <dpsim-models/SimNode.h>
 #include <dpsim-models/Task.h>
 
@@ -24,25 +33,97 @@ namespace DPsim {
 
 	class DataLogger : public SharedFactory<DataLogger> {
 
+	public:
+		/// File format of the log
+		///
+		/// Binary logs start with a header: the magic "DPSIMLOG", the format
+		/// version and number of columns (uint32), the size of the header
+		/// (uint64), then the column names (uint32 length + characters), padded
+		/// to a multiple of 64 bytes. Each row then consists of the time and one
+		/// value per column, stored as little-endian doubles. The data can be
+		/// mapped with numpy.memmap(filename, '<f8', offset=headerSize).
+		enum class Format { CSV, Binary };
+
 	protected:
 		std::ofstream mLogFile;
 		String mName;
 		Bool mEnabled;
 		UInt mDownsampling;
+		Format mFormat;
 		fs::path mFilename;
 
 		std::map<String, CPS::AttributeBase::Ptr> mAttributes;
 
+		/// Number of values per row, including the time
+		UInt mNumColumns = 0;
+		/// Rows of binary logs are collected here before they are written to the file
+		std::vector<Real> mBuffer;
+		/// Number of values in the buffer
+		std::size_t mBufferFill = 0;
+		/// Reads the values of all logged attributes in column order
+		CPS::AttributeAccessPlan mAccessPlan;
+		/// Values gathered by the access plan for the CSV output
+		std::vector<Real> mPlanValues;
+
+		// #### Asynchronous writing ####
+		/// Write rows from a separate thread
+		Bool mAsync = false;
+		/// Number of rows that can be queued for the writer thread
+		UInt mAsyncCapacity = 4096;
+		/// Wait for the writer thread instead of dropping rows if the queue is full
+		Bool mBlockOnFullQueue = false;
+		/// Row storage shared with the writer thread
+		std::vector<Real> mRing;
+		/// Slots of the ring which are ready to be written
+		std::unique_ptr<moodycamel::ReaderWriterQueue<std::size_t>> mRowQueue;
+		/// Number of rows put into the ring (only modified by the simulation thread)
+		std::size_t mRowsProduced = 0;
+		/// Number of rows written by the writer thread
+		std::atomic<std::size_t> mRowsConsumed { 0 };
+		/// Number of rows that were dropped because the queue was full
+		std::atomic<std::size_t> mDroppedRows { 0 };
+		/// Number of rows that had to wait for the writer thread
+		std::atomic<std::size_t> mStalledRows { 0 };
+		std::thread mWriterThread;
+		/// Queue element which stops the writer thread
+		static constexpr std::size_t STOP_WRITER = std::numeric_limits<std::size_t>::max();
+		/// The writer thread sleeps between these durations while the queue is empty,
+		/// doubling the sleep time each time it finds the queue empty
+		static constexpr std::chrono::microseconds MIN_WRITER_SLEEP { 10 };
+		static constexpr std::chrono::microseconds MAX_WRITER_SLEEP { 1000 };
+
 		void logDataLine(Real time, Real data);
 		void logDataLine(Real time, const Matrix& data);
 		void logDataLine(Real time, const MatrixComp& data);
 
+		/// Check if data is passed as rows of real values instead of formatted directly
+		Bool useRows() const { return mFormat == Format::Binary || mAsync; }
+		void writeHeader(const std::vector<String>& names);
+		void writeBinaryHeader(const std::vector<String>& names);
+		/// Get storage for the next row (nullptr if the row is dropped)
+		Real* beginRow();
+		/// Pass the row obtained by beginRow on for writing
+		void endRow();
+		void logRow(Real time, const Real* data, Int size);
+		void logAttributeRow(Real time);
+		/// Build the access plan for the columns in `mAttributes`
+		void compileAccessPlan();
+		/// Write a row to the file or the binary buffer
+		void writeRow(const Real* row);
+		void flushBuffer();
+		void startWriter();
+		void stopWriter();
+
 	public:
 		typedef std::shared_ptr<DataLogger> Ptr;
 		typedef std::vector<DataLogger::Ptr> List;
 
+		/// Size of the buffer for rows of binary logs in bytes
+		static constexpr std::size_t BUFFER_SIZE = 1 << 20;
+
 		DataLogger(Bool enabled = true);
-		DataLogger(String name, Bool enabled = true, UInt downsampling = 1);
+		DataLogger(String name, Bool enabled = true, UInt downsampling = 1, Format format = Format::CSV);
+		~DataLogger();
 
 		void open();
 		void close();
@@ -51,6 +132,20 @@ namespace DPsim {
 			open();
 		}
 
+		/// Write the log from a separate thread so that logging only copies values
+		/// in the simulation thread. Only real values are logged in this mode.
+		/// Has to be set before the first values are logged.
+		void doAsyncWriting(Bool async, UInt capacity = 4096) {
+			mAsync = async;
+			mAsyncCapacity = std::max<UInt>(capacity, 1);
+		}
+		/// Wait for the writer thread instead of dropping rows if it falls behind
+		void doBlockOnFullQueue(Bool block) { mBlockOnFullQueue = block; }
+		/// Number of rows dropped because the writer thread fell behind
+		std::size_t droppedRows() const { return mDroppedRows; }
+		/// Number of rows that had to wait for the writer thread
+		std::size_t stalledRows() const { return mStalledRows; }
+
 		void logPhasorNodeValues(Real time, const Matrix& data, Int freqNum = 1);
 		void logEMTNodeValues(Real time, const Matrix& data);
 
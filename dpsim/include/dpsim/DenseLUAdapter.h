@@ -24,6 +24,8 @@ namespace DPsim
     class DenseLUAdapter : public DirectLinearSolver
     {
         Eigen::PartialPivLU<Matrix> LUFactorized;
+		/// Buffer for permuting right hand sides, which Eigen cannot do in place without allocating
+		Matrix mPermutationBuffer;
 
         public:
 		/// Constructor with logging
@@ -46,5 +48,11 @@ namespace DPsim
 
 		/// solution function for a right hand side
 		Matrix solve(Matrix& rightSideVector) override;
+
+		/// solution function writing into a preallocated solution vector
+		void solveInPlace(const Matrix& rightSideVector, Matrix& solution) override;
+
+		/// solution function for a block of right hand sides, overwritten with the solutions
+		void solveBatch(Matrix& rightSideVectors) override;
     };
 }
@@ -63,6 +63,19 @@ namespace DPsim
 		/// solution function for a right hand side
 		virtual Matrix solve(Matrix& rightSideVector) = 0;
 
+		/// solution function for a block of right hand sides, overwritten with the solutions
+		virtual void solveBatch(Matrix& rightSideVectors)
+		{
+			rightSideVectors = solve(rightSideVectors);
+		}
+
+		/// solution function writing into a preallocated solution vector of matching size
+		virtual void solveInPlace(const Matrix& rightSideVector, Matrix& solution)
+		{
+			solution = rightSideVector;
+			solveBatch(solution);
+		}
+
 		virtual void setConfiguration(DirectLinearSolverConfiguration& configuration)
 		{
 			mConfiguration = configuration;
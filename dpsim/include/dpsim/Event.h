@@ -10,6 +10,7 @@
 
 #include <deque>
 #include <queue>
+#include <vector>
 
 #include <dpsim/Config.h>
 #include <dpsim-models/Definitions.h>
@@ -24,6 +25,16 @@ namespace DPsim {
 	class EventComparator;
 	class EventQueue;
 
+	/// Scheduled change of a switch state
+	struct SwitchStateChange {
+		/// Time of the change
+		CPS::Real time;
+		/// Attribute holding the state of the switch
+		CPS::Attribute<CPS::Bool>::Ptr isClosed;
+		/// New state of the switch
+		CPS::Bool closed;
+	};
+
 	class Event {
 
 		friend class EventComparator;
@@ -90,6 +101,10 @@ namespace DPsim {
 			else
 				mSwitch->open();
 		}
+
+		SwitchStateChange switchStateChange() const {
+			return { mTime, mSwitch->mIsClosed, mNewState };
+		}
 	};
 
 	class SwitchEvent3Ph : public Event, public SharedFactory<SwitchEvent3Ph> {
@@ -113,6 +128,10 @@ namespace DPsim {
 			else
 				mSwitch->openSwitch();
 		}
+
+		SwitchStateChange switchStateChange() const {
+			return { mTime, mSwitch->mSwitchClosed, mNewState };
+		}
 	};
 
 
@@ -126,6 +145,8 @@ namespace DPsim {
 		void addEvent(Event::Ptr e);
 		///
 		void handleEvents(CPS::Real currentTime);
+		/// Returns the pending switch state changes ordered by time
+		std::vector<SwitchStateChange> getSwitchStateChanges() const;
 	};
 }
 
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <thread>
+#include <limits>
 
 #include <dpsim-models/Logger.h>
 #include <dpsim/Config.h>
@@ -24,13 +25,28 @@ namespace DPsim {
 	public:
 		typedef std::shared_ptr<Interface> Ptr;
 
+		/// Marks packets whose value does not belong to the export packet pool
+		static constexpr UInt POOL_SLOT_NONE = std::numeric_limits<UInt>::max();
+
 		using AttributePacket = struct AttributePacket {
 			CPS::AttributeBase::Ptr value;
 			UInt attributeId; //Used to identify the attribute. Defined by the position in the `mExportAttrsDpsim` and `mImportAttrsDpsim` lists
 			UInt sequenceId; //Increasing ID used to discern multiple consecutive updates of a single attribute
 			unsigned char flags; //Bit 0 set: Close interface
+			UInt poolSlot = POOL_SLOT_NONE; //Slot of the export packet pool holding `value`, POOL_SLOT_NONE if the value was allocated for this packet only
+		};
+
+		/// All attribute packets exported in one simulation step or read from the environment in one go
+		using AttributeFrame = struct AttributeFrame {
+			std::vector<AttributePacket> packets;
+			UInt sequenceId = 0; //Increasing ID of the frame, counts simulation steps for exports and environment reads for imports
+			unsigned char flags = 0; //Bit 0 set: Close interface
 		};
 
+		using PacketList = std::vector<AttributePacket>;
+		using FrameQueue = moodycamel::BlockingReaderWriterQueue<AttributeFrame>;
+		using PacketListQueue = moodycamel::ReaderWriterQueue<PacketList>;
+
 		enum AttributePacketFlags {
 			PACKET_NO_FLAGS = 0,
 			PACKET_CLOSE_INTERFACE = 1,
@@ -40,8 +56,10 @@ namespace DPsim {
 			mInterfaceWorker(intf),
 			mName(name),
 			mDownsampling(downsampling) {
-				mQueueDpsimToInterface = std::make_shared<moodycamel::BlockingReaderWriterQueue<AttributePacket>>();
-				mQueueInterfaceToDpsim = std::make_shared<moodycamel::BlockingReaderWriterQueue<AttributePacket>>();
+				mQueueDpsimToInterface = std::make_shared<FrameQueue>();
+				mQueueInterfaceToDpsim = std::make_shared<FrameQueue>();
+				mQueueReturnedExportFrames = std::make_shared<PacketListQueue>();
+				mQueueReturnedImportFrames = std::make_shared<PacketListQueue>();
 			};
 
 		virtual void open();
@@ -63,6 +81,15 @@ namespace DPsim {
 
 		void setLogger(CPS::Logger::Log log);
 
+		/// Number of preallocated export frames and packet values per exported attribute. Has to be set before the interface is opened
+		void setExportPoolSize(UInt size);
+		/// Number of export frames currently waiting for the writer thread
+		UInt exportQueueDepth() const;
+		/// Highest number of export frames waiting for the writer thread seen during the simulation
+		UInt maxExportQueueDepth() const { return mMaxExportQueueDepth; }
+		/// Number of times the export path found no free pooled frame or packet value and had to allocate
+		UInt exportPoolExhaustions() const { return mExportPoolExhaustions; }
+
 		virtual ~Interface() {
 			if (mOpened)
 				close();
@@ -81,13 +108,40 @@ namespace DPsim {
 		bool mSyncOnSimulationStart;
 		UInt mCurrentSequenceDpsimToInterface = 1;
 		UInt mNextSequenceInterfaceToDpsim = 1;
+		UInt mCurrentFrameDpsimToInterface = 1;
 		UInt mDownsampling;
 		std::atomic<bool> mOpened;
 		std::thread mInterfaceWriterThread;
 		std::thread mInterfaceReaderThread;
 
-		std::shared_ptr<moodycamel::BlockingReaderWriterQueue<AttributePacket>> mQueueDpsimToInterface;
-		std::shared_ptr<moodycamel::BlockingReaderWriterQueue<AttributePacket>> mQueueInterfaceToDpsim;
+		std::shared_ptr<FrameQueue> mQueueDpsimToInterface;
+		std::shared_ptr<FrameQueue> mQueueInterfaceToDpsim;
+		// Emptied packet lists handed back to the thread that fills the frames, so frames can be reused without allocating
+		std::shared_ptr<PacketListQueue> mQueueReturnedExportFrames;
+		std::shared_ptr<PacketListQueue> mQueueReturnedImportFrames;
+
+		// One bit per imported attribute, set once the attribute has been updated in the current popDpsimAttrsFromQueue call
+		std::vector<uint64_t> mImportReceived;
+		UInt mNumBlockingImports = 0;
+		UInt mNumSyncImports = 0;
+
+		using PoolSlotRef = std::pair<UInt, UInt>;
+
+		// Preallocated packet values per exported attribute, indexed by attributeId and slot
+		std::vector<std::vector<CPS::AttributeBase::Ptr>> mExportPool;
+		// Free slots per exported attribute. Only accessed by the dpsim-thread
+		std::vector<std::vector<UInt>> mExportPoolFree;
+		// Slots released by the writer thread after their value has been written
+		std::shared_ptr<moodycamel::ReaderWriterQueue<PoolSlotRef>> mQueueReturnedSlots;
+		UInt mExportPoolSize = 16;
+		UInt mMaxExportQueueDepth = 0;
+		UInt mExportPoolExhaustions = 0;
+
+		void initExportPool();
+		void initImportBitmap();
+		void reclaimExportSlots();
+		// Copies all packets of an import frame onto the imported attributes and returns how many of the attributes waited for were updated
+		UInt applyImportFrame(AttributeFrame& frame, bool isSync);
 
 		virtual void addImport(CPS::AttributeBase::Ptr attr, bool blockOnRead = false, bool syncOnSimulationStart = true);
 		virtual void addExport(CPS::AttributeBase::Ptr attr);
@@ -96,32 +150,47 @@ namespace DPsim {
 
 		class WriterThread {
 			private:
-				std::shared_ptr<moodycamel::BlockingReaderWriterQueue<AttributePacket>> mQueueDpsimToInterface;
+				std::shared_ptr<FrameQueue> mQueueDpsimToInterface;
+				std::shared_ptr<PacketListQueue> mQueueReturnedFrames;
+				std::shared_ptr<moodycamel::ReaderWriterQueue<PoolSlotRef>> mQueueReturnedSlots;
 				std::shared_ptr<InterfaceWorker> mInterfaceWorker;
+				UInt mPoolSize;
+				UInt mNumAttributes;
 
 			public:
 				WriterThread(
-						std::shared_ptr<moodycamel::BlockingReaderWriterQueue<AttributePacket>> queueDpsimToInterface,
-				 		std::shared_ptr<InterfaceWorker> intf
+						std::shared_ptr<FrameQueue> queueDpsimToInterface,
+						std::shared_ptr<PacketListQueue> queueReturnedFrames,
+						std::shared_ptr<moodycamel::ReaderWriterQueue<PoolSlotRef>> queueReturnedSlots,
+				 		std::shared_ptr<InterfaceWorker> intf,
+						UInt poolSize,
+						UInt numAttributes
 					) :
 					mQueueDpsimToInterface(queueDpsimToInterface),
-					mInterfaceWorker(intf) {};
+					mQueueReturnedFrames(queueReturnedFrames),
+					mQueueReturnedSlots(queueReturnedSlots),
+					mInterfaceWorker(intf),
+					mPoolSize(poolSize),
+					mNumAttributes(numAttributes) {};
 				void operator() () const;
 		};
  
 		class ReaderThread {
 			private:
-				std::shared_ptr<moodycamel::BlockingReaderWriterQueue<AttributePacket>> mQueueInterfaceToDpsim;
+				std::shared_ptr<FrameQueue> mQueueInterfaceToDpsim;
+				std::shared_ptr<PacketListQueue> mQueueReturnedFrames;
 				std::shared_ptr<InterfaceWorker> mInterfaceWorker;
 				std::atomic<bool>& mOpened;
 
 			public:
 				ReaderThread(
-						std::shared_ptr<moodycamel::BlockingReaderWriterQueue<AttributePacket>> queueInterfaceToDpsim,
+						std::shared_ptr<FrameQueue> queueInterfaceToDpsim,
+						std::shared_ptr<PacketListQueue> queueReturnedFrames,
 				 		std::shared_ptr<InterfaceWorker> intf,
 						std::atomic<bool>& opened
 					) :
 					mQueueInterfaceToDpsim(queueInterfaceToDpsim),
+					mQueueReturnedFrames(queueReturnedFrames),
 					mInterfaceWorker(intf),
 					mOpened(opened) {};
 				void operator() () const;
@@ -80,6 +80,9 @@ namespace DPsim
 		/// solution function for a right hand side
 		Matrix solve(Matrix& rightSideVector) override;
 
+		/// solution function for a block of right hand sides, solved in place
+		void solveBatch(Matrix& rightSideVectors) override;
+
 		protected:
 
 		/// Function to print matrix in MatrixMarket's coo format
@@ -0,0 +1,125 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <unordered_set>
+
+#include <dpsim/Config.h>
+#include <dpsim/Definitions.h>
+#include <dpsim-models/Attribute.h>
+#include <dpsim-models/Task.h>
+#include <dpsim-models/Solver/MNAInterface.h>
+#include <dpsim-models/Solver/MNALinearElementInterface.h>
+
+namespace DPsim {
+	/// \brief Bulk update of linear MNA elements from structure-of-arrays storage.
+	///
+	/// The coefficients and states of all phases of the collected elements are kept
+	/// in contiguous arrays. One pre-step task computes all history currents and
+	/// stamps them into a shared right vector, one post-step task derives all
+	/// voltages and currents from the solution and writes them back to the
+	/// interface attributes of the elements.
+	template <typename VarType>
+	class MnaLinearElements {
+	public:
+		///
+		MnaLinearElements(String name) : mName(name) { }
+
+		/// Take over the update of the component if it supports it.
+		/// Must be called after the MNA initialization of the component.
+		Bool add(CPS::MNAInterface::Ptr comp);
+		/// Check whether the update of the component has been taken over
+		Bool contains(const CPS::MNAInterface::Ptr& comp) const {
+			return mComponentSet.find(comp.get()) != mComponentSet.end();
+		}
+		/// Number of collected element phases
+		UInt size() const { return static_cast<UInt>(mNodes0.size()); }
+		/// Number of collected components
+		UInt numComponents() const { return static_cast<UInt>(mComponents.size()); }
+
+		/// Release all components, e.g. before they are initialized for another time step
+		void clear();
+		/// Create the storage and the shared right vector with the given number of rows
+		void initialize(Matrix::Index rows);
+		/// Reload the states from the interface attributes after they have been modified externally
+		void readInterfaceValues();
+		/// Reload the coefficients from the components, e.g. after a change of the time step
+		void updateCoefficients();
+		/// Compute history currents and stamp them into the shared right vector
+		void preStep();
+		/// Update voltages and currents from the solution and write them to the components
+		void postStep(const Matrix& leftVector);
+
+		/// Shared right vector contribution of all collected elements
+		const CPS::Attribute<Matrix>::Ptr& getRightVector() const { return mRightVector; }
+		/// Indices of the shared right vector that are stamped
+		const std::vector<UInt>& getRightVectorIndices() const { return mRightVectorIndices; }
+		/// Tasks replacing the pre- and post-step tasks of the collected components
+		CPS::Task::List getTasks(CPS::Attribute<Matrix>::Ptr leftVector);
+
+		class PreStep : public CPS::Task {
+		public:
+			PreStep(MnaLinearElements<VarType>& elements);
+			void execute(Real time, Int timeStepCount) override { mElements.preStep(); }
+
+		private:
+			MnaLinearElements<VarType>& mElements;
+		};
+
+		class PostStep : public CPS::Task {
+		public:
+			PostStep(MnaLinearElements<VarType>& elements, CPS::Attribute<Matrix>::Ptr leftVector);
+			void execute(Real time, Int timeStepCount) override { mElements.postStep(**mLeftVector); }
+
+		private:
+			MnaLinearElements<VarType>& mElements;
+			CPS::Attribute<Matrix>::Ptr mLeftVector;
+		};
+
+	private:
+		typedef typename CPS::MNALinearElementInterface<VarType>::LinearPhase LinearPhase;
+
+		///
+		String mName;
+		/// Collected components
+		CPS::MNAInterface::List mComponents;
+		/// Lookup of collected components
+		std::unordered_set<const CPS::MNAInterface*> mComponentSet;
+		/// Interface attributes of the collected components
+		std::vector<CPS::AttributeBase::Ptr> mInterfaceAttributes;
+		/// Phases reported by the components, converted to arrays by initialize
+		std::vector<LinearPhase> mPhases;
+
+		// #### Structure-of-arrays storage, imaginary parts are only used for Complex ####
+		/// Equivalent conductances
+		std::vector<Real> mCondRe, mCondIm;
+		/// Voltage coefficients of the history currents
+		std::vector<Real> mVoltFacRe, mVoltFacIm;
+		/// Current coefficients of the history currents
+		std::vector<Real> mCurrFacRe, mCurrFacIm;
+		/// Interface voltages
+		std::vector<Real> mVoltRe, mVoltIm;
+		/// Interface currents
+		std::vector<Real> mCurrRe, mCurrIm;
+		/// History currents
+		std::vector<Real> mEquivCurrRe, mEquivCurrIm;
+		/// Matrix node indices of terminal 0 and 1, -1 if grounded
+		std::vector<Int> mNodes0, mNodes1;
+		/// Interface attribute storage the states are written back to
+		std::vector<VarType*> mVoltPtrs, mCurrPtrs;
+
+		/// Offset of the imaginary parts in the system vectors
+		Matrix::Index mComplexOffset = 0;
+		/// Shared right vector contribution
+		CPS::Attribute<Matrix>::Ptr mRightVector;
+		/// Indices of the shared right vector that are stamped
+		std::vector<UInt> mRightVectorIndices;
+	};
+}
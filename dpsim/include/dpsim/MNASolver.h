@@ -17,6 +17,7 @@
 #include <dpsim/Config.h>
 #include <dpsim/Solver.h>
 #include <dpsim/DataLogger.h>
+#include <dpsim/MNALinearElements.h>
 #include <dpsim-models/AttributeList.h>
 #include <dpsim-models/Solver/MNASwitchInterface.h>
 #include <dpsim-models/Solver/MNAVariableCompInterface.h>
@@ -83,11 +84,23 @@ namespace DPsim {
 		Matrix mRightSideVector;
 		/// List of all right side vector contributions
 		std::vector<const Matrix*> mRightVectorStamps;
+		/// Indices of the right side vector contributions, used for sparse stamping
+		std::vector<const std::vector<UInt>*> mRightVectorStampIndices;
+		/// Compact right side vector contributions, which only hold the entries at their indices
+		std::vector<const Matrix*> mCompactRightVectorStamps;
+		/// Indices of the compact right side vector contributions
+		std::vector<const std::vector<UInt>*> mCompactRightVectorStampIndices;
+		/// Linear elements whose pre- and post-steps are executed in bulk
+		MnaLinearElements<VarType> mLinearElements;
 
 		// #### MNA specific attributes related to harmonics / additional frequencies ####
 		/// Source vector of known quantities
 		std::vector<Matrix> mRightSideVectorHarm;
 
+		// #### MNA specific attributes related to scenarios ####
+		/// Block of source vectors of the nominal system followed by one column per scenario
+		Matrix mScenarioBatch;
+
 		// #### MNA specific attributes related to system recomputation
 		/// Number of system matrix recomputations
 		Int mNumRecomputations = 0;
@@ -114,11 +127,11 @@ namespace DPsim {
 		std::shared_ptr<DataLogger> mRightVectorLog;
 
 		/// LU factorization measurements
-		std::vector<Real> mFactorizeTimes;
+		TimingStatistics mFactorizeTimes;
 		/// Right-hand side solution measurements
-		std::vector<Real> mSolveTimes;
+		TimingStatistics mSolveTimes;
 		/// LU refactorization measurements
-		std::vector<Real> mRecomputationTimes;
+		TimingStatistics mRecomputationTimes;
 
 		/// Constructor should not be called by users but by Simulation
 		MnaSolver(String name,
@@ -127,6 +140,14 @@ namespace DPsim {
 
 		/// Initialization of individual components
 		void initializeComponents();
+		/// Creates the storage of the linear elements that are updated in bulk
+		void initializeLinearElements();
+		/// Initialization of the MNA specific parts of components for the given time step
+		void initializeMNAComponents(Real timeStep);
+		/// Update the time step dependent coefficients of the components, returns false if a component does not support it
+		Bool updateMNAComponentsTimeStep(Real timeStep);
+		/// Collects the MNA tasks of the components, replacing those of linear elements updated in bulk
+		CPS::Task::List mnaComponentTasks();
 		/// Initialization of system matrices and source vector
 		virtual void initializeSystem();
 		/// Initialization of system matrices and source vector
@@ -147,6 +168,8 @@ namespace DPsim {
 
 		/// Create left and right side vector
 		void createEmptyVectors();
+		/// Create source vector offsets and solution vectors of the scenarios
+		void createEmptyScenarioVectors();
 		/// Create system matrix
 		virtual void createEmptySystemMatrix() = 0;
 		/// Sets all entries in the matrix with the given switch index to zero
@@ -159,6 +182,10 @@ namespace DPsim {
 		virtual void switchedMatrixStamp(std::size_t swIdx, Int freqIdx, CPS::MNAInterface::List& components, CPS::MNASwitchInterface::List& switches) { }
 		/// Checks whether the status of variable MNA elements have changed
 		Bool hasVariableComponentChanged();
+		/// Sums up the right side vector contributions of all components
+		void sumRightVectorStamps();
+		/// Sums up the right side vector contributions of all components for one frequency
+		void sumRightVectorStampsHarm(Int freqIdx);
 
 		// #### Methods to implement for system recomputation over time ####
 		/// Stamps components into the variable system matrix
@@ -193,6 +220,15 @@ namespace DPsim {
 		/// Solution vector of unknown quantities (parallel frequencies)
 		std::vector<CPS::Attribute<Matrix>::Ptr> mLeftSideVectorHarm;
 
+		/// Source vector offsets of the scenarios with respect to the nominal system, one column per scenario
+		CPS::Attribute<Matrix>::Ptr mScenarioRightSideOffsets;
+		/// Solution vectors of the scenarios, one column per scenario. The components
+		/// and their history terms follow the nominal scenario only, so each scenario
+		/// solution is the nominal solution plus the inverse system matrix applied to
+		/// its offset. This equals a separate simulation with the offset as current
+		/// injection only if the system has no history terms, e.g. a resistive network.
+		CPS::Attribute<Matrix>::Ptr mScenarioLeftSideVectors;
+
 		/// Destructor
 		virtual ~MnaSolver() {
 			if (mSystemMatrixRecomputation)
@@ -211,6 +247,16 @@ namespace DPsim {
 		Matrix& rightSideVector() { return mRightSideVector; }
 		///
 		virtual CPS::Task::List getTasks() override;
+		///
+		virtual const TimingStatistics* solveTimes() const override { return &mSolveTimes; }
+		///
+		virtual const TimingStatistics* recomputationTimes() const override { return &mRecomputationTimes; }
+		///
+		virtual UInt numVectorizedLinearElements() const override { return mLinearElements.numComponents(); }
+		///
+		virtual CPS::Attribute<Matrix>::Ptr scenarioRightSideOffsets() const override { return mScenarioRightSideOffsets; }
+		///
+		virtual CPS::Attribute<Matrix>::Ptr scenarioLeftSideVectors() const override { return mScenarioLeftSideVectors; }
 
 	};
 }
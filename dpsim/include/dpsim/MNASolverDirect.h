@@ -12,8 +12,12 @@
 #include <vector>
 #include <list>
 #include <unordered_map>
+#include <unordered_set>
 #include <bitset>
 #include <memory>
+#include <array>
+#include <thread>
+#include <atomic>
 
 #include <dpsim/Config.h>
 #include <dpsim/Solver.h>
@@ -65,6 +69,38 @@ namespace DPsim {
 		std::unordered_map< std::bitset<SWITCH_NUM>, std::vector<SparseMatrix> > mSwitchedMatrices;
 		/// Map of direct linear solvers related to the system matrices
 		std::unordered_map< std::bitset<SWITCH_NUM>, std::vector< std::shared_ptr< DirectLinearSolver> > > mDirectLinearSolvers;
+		/// Dimension of the switched system matrices
+		Int mSwitchedMatrixSize = 0;
+
+		// #### Data structures for lazily factorized switch states ####
+		/// Cached switch states ordered by their last use, most recent first
+		std::list< std::bitset<SWITCH_NUM> > mSwitchStateUsage;
+		/// Position of each cached switch state in the usage list
+		std::unordered_map< std::bitset<SWITCH_NUM>, std::list< std::bitset<SWITCH_NUM> >::iterator > mSwitchStateUsagePos;
+		/// System matrix stamps of all components except the switches, captured at initialization
+		SparseMatrix mSwitchedBaseMatrix;
+		/// Open and closed stamp of each switch, captured at initialization
+		std::vector< std::array<SparseMatrix, 2> > mSwitchStamps;
+		/// Switch state factorized in the background, handed over to the solver once ready
+		struct PrefactorizedState {
+			std::bitset<SWITCH_NUM> bit;
+			SparseMatrix matrix;
+			std::shared_ptr<DirectLinearSolver> solver;
+			Real factorizeTime = 0;
+			std::atomic<Bool> ready{false};
+		};
+		/// States the prefactorization thread factorizes in order
+		std::vector<PrefactorizedState> mPrefactorizedStates;
+		/// Number of prefactorized states already moved to the cache
+		std::size_t mNumAdoptedPrefactorizedStates = 0;
+		/// Thread factorizing predicted switch states in the background
+		std::thread mPrefactorizationThread;
+		/// Signals the prefactorization thread to stop
+		std::atomic<Bool> mStopPrefactorization{false};
+		/// Prefactorized states in the cache that no step has used yet
+		std::unordered_set< std::bitset<SWITCH_NUM> > mUnusedPrefactorizedStates;
+		/// Counters of the factorizations and evictions of switch states
+		SwitchFactorizationStatistics mSwitchFactorizationStatistics;
 
 		// #### Data structures for system recomputation over time ####
 		/// System matrix including all static elements
@@ -73,6 +109,40 @@ namespace DPsim {
 		SparseMatrix mVariableSystemMatrix;
 		/// LU factorization of variable system matrix
 		std::shared_ptr<DirectLinearSolver> mDirectLinearSolverVariableSystemMatrix;
+		/// Values of the base system matrix laid out in the frozen pattern of the variable system matrix
+		std::vector<Real> mBaseSystemMatrixValues;
+		/// Number of non-zeros of the frozen pattern
+		Eigen::Index mFrozenNonZeros = 0;
+
+		// #### Data structures for low-rank updates of the variable system matrix ####
+		// The buffers are sized for all candidate rows when the system is stamped,
+		// an update only uses their leading rows and columns.
+		/// System matrix the current factorization belongs to
+		SparseMatrix mFactorizedSystemMatrix;
+		/// Rows that switches and variable elements stamp into, only these rows can change
+		std::vector<Eigen::Index> mLowRankCandidateRows;
+		/// Rows of the current system matrix that differ from the factorized one
+		std::vector<Eigen::Index> mLowRankRows;
+		/// Number of rows that differ from the factorized system matrix
+		Eigen::Index mLowRankSize = 0;
+		/// Difference of the changed rows to the factorized system matrix, one row per entry of mLowRankRows
+		Matrix mLowRankUpdate;
+		/// Solutions of the factorized system for the unit vectors of the changed rows
+		Matrix mLowRankSolutions;
+		/// Capacitance matrix of the low-rank update, padded with the identity to keep its size
+		Matrix mLowRankCapacitanceMatrix;
+		/// LU factorization of the capacitance matrix
+		Eigen::PartialPivLU<Matrix> mLowRankCapacitance;
+		/// Unit vector of a changed row and the solution of the factorized system for it
+		Matrix mLowRankUnitVector;
+		Matrix mLowRankUnitSolution;
+		/// Projection of the solutions onto the changed rows and the coefficients of the correction
+		Matrix mLowRankProjection;
+		Matrix mLowRankCoefficients;
+		/// Number of low-rank updates since the last refactorization
+		UInt mNumLowRankUpdates = 0;
+		/// Low-rank update measurements, which are not counted as refactorizations
+		TimingStatistics mLowRankUpdateTimes;
 		/// LU factorization indicator
 		DirectLinearSolverImpl mImplementationInUse;
 		/// LU factorization configuration
@@ -95,6 +165,13 @@ namespace DPsim {
 		using MnaSolver<VarType>::mFrequencyParallel;
 		using MnaSolver<VarType>::mSLog;
 		using MnaSolver<VarType>::mSystemMatrixRecomputation;
+		using MnaSolver<VarType>::mFreezeSystemMatrixPattern;
+		using MnaSolver<VarType>::mLazySwitchFactorization;
+		using MnaSolver<VarType>::mSwitchFactorizationCacheSize;
+		using MnaSolver<VarType>::mLowRankSystemMatrixUpdates;
+		using MnaSolver<VarType>::mMaxLowRankUpdates;
+		using MnaSolver<VarType>::mNumScenarios;
+		using MnaSolver<VarType>::mScenarioBatch;
 		using MnaSolver<VarType>::hasVariableComponentChanged;
 		using MnaSolver<VarType>::mNumRecomputations;
 		using MnaSolver<VarType>::mSyncGen;
@@ -114,6 +191,24 @@ namespace DPsim {
 		void switchedMatrixEmpty(std::size_t swIdx, Int freqIdx) override;
 		/// Applies a component stamp to the matrix with the given switch index
 		void switchedMatrixStamp(std::size_t index, std::vector<std::shared_ptr<CPS::MNAInterface>>& comp) override;
+		/// Stamps the system matrix of a switch state, factorizes it and returns the factorization time
+		Real stampSwitchedSystem(const std::bitset<SWITCH_NUM>& bit, std::vector<std::shared_ptr<CPS::MNAInterface>>& comp,
+			SparseMatrix& sys, DirectLinearSolver& solver);
+		/// Factorizes a stamped switch state and returns the factorization time
+		Real factorizeSwitchedSystem(SparseMatrix& sys, DirectLinearSolver& solver);
+		/// Captures the component stamps and the open and closed stamp of each switch for lazy factorization
+		void captureSwitchedSystemStamps(std::vector<std::shared_ptr<CPS::MNAInterface>>& comp);
+		/// Stamps a switch state from the captured stamps, factorizes it and returns the factorization time
+		Real stampCapturedSwitchedSystem(const std::bitset<SWITCH_NUM>& bit, SparseMatrix& sys, DirectLinearSolver& solver);
+		/// Returns the linear solver for the given switch state, factorizing it on its first occurrence
+		std::shared_ptr<DirectLinearSolver> switchedSolver(const std::bitset<SWITCH_NUM>& bit);
+		/// Adds a factorized switch state to the cache unless it is already present
+		void cacheSwitchedSystem(const std::bitset<SWITCH_NUM>& bit, SparseMatrix& sys,
+			std::shared_ptr<DirectLinearSolver> solver, Real factorizeTime);
+		/// Moves the states the prefactorization thread has finished into the cache
+		void adoptPrefactorizedStates();
+		/// Marks a switch state as most recently used and evicts the least recently used states
+		void touchSwitchState(const std::bitset<SWITCH_NUM>& bit);
 
 		// #### Methods for system recomputation over time ####
 		/// Stamps components into the variable system matrix
@@ -124,6 +219,18 @@ namespace DPsim {
 		std::shared_ptr<CPS::Task> createSolveTaskRecomp() override;
 		/// Recomputes systems matrix
 		virtual void recomputeSystemMatrix(Real time);
+		/// Fixes the pattern of the variable system matrix to the union of all
+		/// static, switch and variable entries and lays out the base values in it
+		void freezeVariableSystemMatrixPattern();
+		/// Collects the rows switches and variable elements stamp into and sizes the low-rank buffers
+		void initializeLowRankCorrection();
+		/// Expresses the difference between the current and the factorized system matrix
+		/// as low-rank update and prepares the Sherman-Morrison-Woodbury correction
+		void updateLowRankCorrection();
+		/// Resets the low-rank correction after the system matrix has been factorized
+		void resetLowRankCorrection();
+		/// Corrects solutions of the factorized system to solutions of the current system matrix
+		void applyLowRankCorrection(Matrix& solutions);
 
 		// #### Scheduler Task Methods ####
 		/// Create a solve task for this solver implementation
@@ -138,6 +245,8 @@ namespace DPsim {
 		void solve(Real time, Int timeStepCount) override;
 		/// Solves system for multiple frequencies
 		void solveWithHarmonics(Real time, Int timeStepCount, Int freqIdx) override;
+		/// Solves the nominal system and all scenarios as one block of right hand sides
+		void solveScenarioBatch(DirectLinearSolver& solver);
 
 		/// Logging of the right-hand-side solution time
 		void logSolveTime();
@@ -145,6 +254,8 @@ namespace DPsim {
 		void logFactorizationTime();
 		/// Logging of the LU refactorization time
 		void logRecomputationTime();
+		/// Logging of the low-rank update time
+		void logLowRankUpdateTime();
 
 		/// Returns a pointer to an object of type DirectLinearSolver
 		std::shared_ptr<DirectLinearSolver> createDirectSolverImplementation(CPS::Logger::Log mSLog);
@@ -157,7 +268,7 @@ namespace DPsim {
 			CPS::Logger::Level logLevel = CPS::Logger::Level::info);
 
 		/// Destructor
-		virtual ~MnaSolverDirect() = default;
+		virtual ~MnaSolverDirect();
 
 		/// Sets the linear solver to "implementation" and creates an object
 		void setDirectLinearSolverImplementation(DirectLinearSolverImpl implementation);
@@ -168,6 +279,15 @@ namespace DPsim {
 		/// log LU decomposition times
 		void logLUTimes() override;
 
+		///
+		const TimingStatistics* lowRankUpdateTimes() const override { return &mLowRankUpdateTimes; }
+
+		///
+		const SwitchFactorizationStatistics* switchFactorizationStatistics() const override { return &mSwitchFactorizationStatistics; }
+
+		/// Factorizes the switch states predicted from the scheduled changes in a background thread
+		void prefactorizeSwitchStates(const std::vector<SwitchStateChange>& changes) override;
+
 		/// ### SynGen Interface ###
 		int mIter = 0;
 
@@ -182,10 +302,16 @@ namespace DPsim {
 					if (it->getRightVector()->get().size() != 0)
 						mAttributeDependencies.push_back(it->getRightVector());
 				}
+				if (solver.mLinearElements.numComponents() > 0)
+					mAttributeDependencies.push_back(solver.mLinearElements.getRightVector());
 				for (auto node : solver.mNodes) {
 					mModifiedAttributes.push_back(node->mVoltage);
 				}
 				mModifiedAttributes.push_back(solver.mLeftSideVector);
+				if (solver.mNumScenarios > 0) {
+					mAttributeDependencies.push_back(solver.mScenarioRightSideOffsets);
+					mModifiedAttributes.push_back(solver.mScenarioLeftSideVectors);
+				}
 			}
 
 			void execute(Real time, Int timeStepCount) {
@@ -237,10 +363,16 @@ namespace DPsim {
 					if (it->getRightVector()->get().size() != 0)
 						mAttributeDependencies.push_back(it->getRightVector());
 				}
+				if (solver.mLinearElements.numComponents() > 0)
+					mAttributeDependencies.push_back(solver.mLinearElements.getRightVector());
 				for (auto node : solver.mNodes) {
 					mModifiedAttributes.push_back(node->mVoltage);
 				}
 				mModifiedAttributes.push_back(solver.mLeftSideVector);
+				if (solver.mNumScenarios > 0) {
+					mAttributeDependencies.push_back(solver.mScenarioRightSideOffsets);
+					mModifiedAttributes.push_back(solver.mScenarioLeftSideVectors);
+				}
 			}
 
 			void execute(Real time, Int timeStepCount) {
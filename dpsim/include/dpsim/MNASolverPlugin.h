@@ -45,6 +45,8 @@ namespace DPsim {
 					if (it->getRightVector()->get().size() != 0)
 						mAttributeDependencies.push_back(it->getRightVector());
 				}
+				if (solver.mLinearElements.numComponents() > 0)
+					mAttributeDependencies.push_back(solver.mLinearElements.getRightVector());
 				for (auto node : solver.mNodes) {
 					mModifiedAttributes.push_back(node->mVoltage);
 				}
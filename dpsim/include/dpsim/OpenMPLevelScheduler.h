@@ -10,6 +10,7 @@
 
 #include <dpsim/Scheduler.h>
 
+#include <thread>
 #include <vector>
 
 namespace DPsim {
@@ -24,5 +25,11 @@ namespace DPsim {
 		Int mNumThreads;
 		String mOutMeasurementFile;
 		std::vector<CPS::Task::List> mLevels;
+		/// System thread that got the placement of each OpenMP thread number. The
+		/// runtime does not have to reuse its threads in the parallel region of every step.
+		std::vector<std::thread::id> mPlacedThreads;
+
+		/// Apply the thread placement if the calling thread did not get it yet
+		void placeThread();
 	};
 };
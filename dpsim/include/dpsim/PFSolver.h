@@ -10,9 +10,11 @@
 
 #include <cmath>
 #include <iterator>
+#include <set>
 
 #include <dpsim/Solver.h>
 #include <dpsim/Scheduler.h>
+#include <dpsim/DirectLinearSolver.h>
 #include "dpsim-models/SystemTopology.h"
 #include "dpsim-models/Components.h"
 
@@ -46,12 +48,29 @@ namespace DPsim {
         /// Admittance matrix
         CPS::SparseMatrixCompRow mY;
 
-        /// Jacobian matrix
-        CPS::Matrix mJ;
+        /// Jacobian matrix, its sparsity pattern follows the admittance matrix
+        SparseMatrix mJ;
+        /// Linear solver for the Jacobian
+        std::shared_ptr<DirectLinearSolver> mJacobianSolver;
+        /// Flag whether the sparsity pattern of the Jacobian has been analyzed
+        CPS::Bool mJacobianAnalyzed = false;
+        /// Flag whether the linear solver holds a factorization of the Jacobian
+        CPS::Bool mJacobianFactorized = false;
+        /// Number of numerical factorizations of the Jacobian
+        CPS::UInt mNumJacobianFactorizations = 0;
+        /// Start each solve from the solution of the previous time step
+        CPS::Bool mWarmStart = false;
+        /// Keep the factorized Jacobian across iterations and time steps while the mismatch contracts
+        CPS::Bool mJacobianReuse = false;
+        /// Level of the per time step log messages, lowered for the copies solving many time points or contingencies
+        CPS::Logger::Level mStepLogLevel = CPS::Logger::Level::info;
         /// Solution vector
         CPS::Vector mX;
 	    /// Vector of mismatch values
         CPS::Vector mF;
+        /// Right side and solution of the Jacobian system, sized with mX to avoid allocations in every iteration
+        CPS::Matrix mJacobianRightSide;
+        CPS::Matrix mJacobianSolution;
 
         /// System list
         CPS::SystemTopology mSystem;
@@ -73,6 +92,8 @@ namespace DPsim {
         std::vector<std::shared_ptr<CPS::SP::Ph1::AvVoltageSourceInverterDQ>> mAverageVoltageSourceInverters;
         /// Map providing determined base voltages for each node
         std::map<CPS::TopologicalNode::Ptr, CPS::Real> mBaseVoltageAtNode;
+        /// Components that are ignored when composing the injections, e.g. during a contingency
+        std::set<const CPS::IdentifiedObject*> mOutOfService;
 
         /// Solver tolerance
 		Real mTolerance = 1e-8;
@@ -91,25 +112,43 @@ namespace DPsim {
 
         /// Generate initial solution for current time step
         virtual void generateInitialSolution(Real time, bool keep_last_solution = false) = 0;
+        /// Compose the initial solution from the components without updating them
+        virtual void composeInitialSolution(bool keep_last_solution = false) = 0;
         /// Calculate mismatch
         virtual void calculateMismatch() = 0;
+        /// Create the sparsity pattern of the Jacobian
+        virtual void createJacobianPattern() = 0;
         /// Calculate the Jacobian
         virtual void calculateJacobian() = 0;
+        /// Refill matrices composed from the admittance matrix after its values changed, keeping the pattern
+        virtual void updateJacobianValues() { }
         /// Update solution in each iteration
         virtual void updateSolution() = 0;
         /// Set final solution
         virtual void setSolution() = 0;
+        /// Get the per-unit voltages of all nodes from the current solution
+        virtual void getSolutionVoltages(CPS::VectorComp& voltages) = 0;
+        /// Copy of the solver that can solve time points independently of this one
+        virtual std::shared_ptr<PFSolver> clone() const = 0;
+        /// Start the next solve from the given per-unit voltages, keeping the set points of PV and VD buses
+        virtual void applyStartingVoltages(const CPS::VectorComp& voltages) = 0;
 
         /// Initialization of the solver
         void initialize();
         /// Initialization of individual components
         void initializeComponents();
+        /// Create a direct linear solver, KLU if available
+        std::shared_ptr<DirectLinearSolver> createLinearSolver();
+        /// Create the linear solvers of the iteration, which are not shared between copies of the solver
+        virtual void createLinearSolvers();
         /// Assignment of matrix indices for nodes
         void assignMatrixNodeIndices();
         /// Set apparent base power of per-unit system
         void setBaseApparentPower();
         /// Determine bus type for all buses
         void determinePFBusType();
+        /// Update the bus counts and the aggregated PQ and PV index vector from the bus lists
+        void aggregateBusIndices();
         /// Determine base voltages for each node
         void determineNodeBaseVoltages();
 
@@ -119,8 +158,21 @@ namespace DPsim {
         CPS::Real G(int i, int j);
         /// Gets the imaginary part of admittance matrix element
         CPS::Real B(int i, int j);
+        /// Susceptance of the series branch between two buses, optionally neglecting its resistance
+        CPS::Real branchSusceptance(UInt k, UInt j, Bool neglectResistance);
+        /// \brief Compose the susceptance matrix -Im(Y) restricted to the given buses.
+        ///
+        /// Rows and columns follow the order of busIndices. Neglecting the
+        /// series resistances and the shunts gives the B' and B'' matrices of the
+        /// fast decoupled and the DC powerflow.
+        void composeSusceptanceMatrix(SparseMatrix& matrix, const std::vector<CPS::UInt>& busIndices,
+            Bool neglectResistance, Bool includeShunts);
+        /// Write the values of a matrix composed by composeSusceptanceMatrix again
+        /// without allocating, after values of the admittance matrix changed
+        void updateSusceptanceMatrix(SparseMatrix& matrix, const std::vector<CPS::UInt>& busIndices,
+            Bool neglectResistance, Bool includeShunts);
         /// Solves the powerflow problem
-        Bool solvePowerflow();
+        virtual Bool solvePowerflow();
         /// Check whether below tolerance
         CPS::Bool checkConvergence();
         /// Logging for integer vectors
@@ -147,6 +199,83 @@ namespace DPsim {
         void modifyPowerFlowBusComponent(CPS::String name, CPS::PowerflowBusType powerFlowBusType);
         /// set solver and component to initialization or simulation behaviour
 		void setSolverAndComponentBehaviour(Solver::Behaviour behaviour) override;
+        /// Start each time step from the converged solution of the previous one
+        void doWarmStart(Bool value) { mWarmStart = value; }
+        /// Reuse the Jacobian factorization as long as the mismatch contracts fast enough
+        void doJacobianReuse(Bool value) { mJacobianReuse = value; }
+
+        /// \brief Quasi-static time series power flow over the given time points.
+        ///
+        /// The time points are split into contiguous chunks that are solved in
+        /// parallel. Within a chunk, the points are solved in order so that warm
+        /// starts and the reused Jacobian carry over from one point to the next.
+        /// The node voltages are written to a binary file with the header
+        /// "DPSQSTS1", number of nodes and points (uint32), and the node names
+        /// (uint32 length and characters), followed by one record per time point:
+        /// time (double), iterations and convergence flag (uint32) and the
+        /// complex node voltages in V (pairs of double).
+        void solveTimeSeries(const std::vector<Real>& times, UInt numChunks, const CPS::String& outputFile);
+
+        /// Outage of a single component
+        struct Contingency {
+            enum class Type { Branch, Generator };
+            Type type;
+            /// Name of the line, transformer or generator
+            CPS::String name;
+        };
+
+        /// Operating limits checked for each contingency
+        struct ContingencyLimits {
+            /// Lower limit of the voltage magnitudes in per unit
+            CPS::Real minVoltage = 0.9;
+            /// Upper limit of the voltage magnitudes in per unit
+            CPS::Real maxVoltage = 1.1;
+            /// Apparent power ratings in VA by branch name, transformers default to their rated power
+            std::map<CPS::String, CPS::Real> branchRatings;
+        };
+
+        /// Post-contingency state and limit violations
+        struct ContingencyResult {
+            enum class Status { Converged, NotConverged, Islanded };
+            ///
+            Contingency contingency;
+            ///
+            Status status = Status::Converged;
+            ///
+            CPS::UInt iterations = 0;
+            /// Sum of the voltage violations in per unit and the overloads relative to the ratings
+            CPS::Real severity = 0;
+            /// Number of violated voltage and branch limits
+            CPS::UInt numViolations = 0;
+            /// Lowest voltage magnitude in per unit
+            CPS::Real minVoltage = 0;
+            CPS::String minVoltageNode;
+            /// Highest voltage magnitude in per unit
+            CPS::Real maxVoltage = 0;
+            CPS::String maxVoltageNode;
+            /// Highest branch loading relative to the rating
+            CPS::Real maxLoading = 0;
+            CPS::String maxLoadingBranch;
+        };
+
+        /// Single outages of all lines and transformers and of the generators at PV buses
+        std::vector<Contingency> listN1Contingencies();
+
+        /// \brief Contingency analysis around the operating point at the given time.
+        ///
+        /// The base case is solved first and serves as starting point of every
+        /// contingency. Branch outages only change the values of four entries of
+        /// the admittance matrix, so the sparsity pattern and with it the
+        /// symbolic analysis of the Jacobian are kept. A generator outage turns
+        /// its bus into a PQ bus unless another source controls the voltage.
+        /// The contingencies are distributed dynamically over the threads, each
+        /// of which works on its own copy of the solver. The results are ranked
+        /// with islanded and diverged cases first, then by severity.
+        std::vector<ContingencyResult> solveContingencies(Real time, const std::vector<Contingency>& contingencies,
+            UInt numThreads, const ContingencyLimits& limits);
+
+        /// Write ranked contingency results as CSV file
+        void writeContingencyReport(const std::vector<ContingencyResult>& results, const CPS::String& filename);
 
         class SolveTask : public CPS::Task {
 		public:
@@ -0,0 +1,45 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <dpsim/PFSolverPowerPolar.h>
+
+namespace DPsim {
+    /// Linear (DC) powerflow solver.
+    ///
+    /// Neglects losses, shunts and reactive power and assumes flat voltage
+    /// magnitudes, so the voltage angles follow from one solve with the
+    /// susceptance matrix of the branch reactances. The matrix is factorized
+    /// once. Slack and PV bus powers and branch flows are calculated from the
+    /// resulting voltages.
+    class PFSolverDC : public PFSolverPowerPolar {
+    protected:
+        /// Susceptance matrix for the voltage angles of PQ and PV buses
+        SparseMatrix mB;
+        /// Linear solver for mB
+        std::shared_ptr<DirectLinearSolver> mBSolver;
+
+        /// Compose the susceptance matrix, which replaces the Jacobian
+        void createJacobianPattern() override;
+        /// Refill the susceptance matrix from the admittance matrix
+        void updateJacobianValues() override;
+        /// Create the linear solver for the susceptance matrix
+        void createLinearSolvers() override;
+        /// Solves the linear powerflow problem
+        Bool solvePowerflow() override;
+        /// Copy of the solver that can solve time points independently of this one
+        std::shared_ptr<PFSolver> clone() const override { return std::make_shared<PFSolverDC>(*this); }
+
+    public:
+        /// Constructor to be used in simulation examples.
+        PFSolverDC(CPS::String name, const CPS::SystemTopology &system, CPS::Real timeStep, CPS::Logger::Level logLevel);
+        ///
+        virtual ~PFSolverDC() { };
+    };
+}
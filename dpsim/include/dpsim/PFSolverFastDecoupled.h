@@ -0,0 +1,56 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <dpsim/PFSolverPowerPolar.h>
+
+namespace DPsim {
+    /// Fast decoupled powerflow solver with constant B' and B'' matrices.
+    ///
+    /// Each iteration solves the active power mismatch for the voltage angles
+    /// with B' and then the reactive power mismatch for the voltage magnitudes
+    /// with B''. Both matrices only depend on the network and are factorized
+    /// once. The XB variant neglects the series resistances in B', the BX
+    /// variant in B''. Convergence is checked on the exact mismatch, so the
+    /// solution is the same as with Newton-Raphson.
+    class PFSolverFastDecoupled : public PFSolverPowerPolar {
+    public:
+        enum class Variant { XB, BX };
+
+    protected:
+        /// Neglect the series resistances in B' (XB) or B'' (BX)
+        Variant mVariant;
+        /// Susceptance matrix for the voltage angles of PQ and PV buses
+        SparseMatrix mBp;
+        /// Susceptance matrix for the voltage magnitudes of PQ buses
+        SparseMatrix mBpp;
+        /// Linear solver for B'
+        std::shared_ptr<DirectLinearSolver> mBpSolver;
+        /// Linear solver for B''
+        std::shared_ptr<DirectLinearSolver> mBppSolver;
+
+        /// Compose B' and B'', which replace the Jacobian
+        void createJacobianPattern() override;
+        /// Refill B' and B'' from the admittance matrix
+        void updateJacobianValues() override;
+        /// Create the linear solvers for B' and B''
+        void createLinearSolvers() override;
+        /// Solves the powerflow problem with alternating angle and magnitude updates
+        Bool solvePowerflow() override;
+        /// Copy of the solver that can solve time points independently of this one
+        std::shared_ptr<PFSolver> clone() const override { return std::make_shared<PFSolverFastDecoupled>(*this); }
+
+    public:
+        /// Constructor to be used in simulation examples.
+        PFSolverFastDecoupled(CPS::String name, const CPS::SystemTopology &system, CPS::Real timeStep,
+            CPS::Logger::Level logLevel, Variant variant = Variant::XB);
+        ///
+        virtual ~PFSolverFastDecoupled() { };
+    };
+}
@@ -33,12 +33,22 @@ namespace DPsim {
         // Core methods
         /// Generate initial solution for current time step
         void generateInitialSolution(Real time, bool keep_last_solution = false);
+        /// Compose the initial solution from the components without updating them
+        void composeInitialSolution(bool keep_last_solution = false);
+        /// Create the sparsity pattern of the Jacobian from the admittance matrix
+        void createJacobianPattern();
         /// Calculate the Jacobian
         void calculateJacobian();
         /// Update solution in each iteration
         void updateSolution();
         /// Set final solution
         void setSolution();
+        /// Get the per-unit voltages of all nodes from the current solution
+        void getSolutionVoltages(CPS::VectorComp& voltages);
+        /// Copy of the solver that can solve time points independently of this one
+        std::shared_ptr<PFSolver> clone() const { return std::make_shared<PFSolverPowerPolar>(*this); }
+        /// Start the next solve from the given per-unit voltages, keeping the set points of PV and VD buses
+        void applyStartingVoltages(const CPS::VectorComp& voltages);
         /// Calculate mismatch
         void calculateMismatch();
 
@@ -18,12 +18,39 @@
 #include <condition_variable>
 #include <deque>
 #include <mutex>
+#include <memory>
 #include <unordered_map>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+  #include <immintrin.h>
+#endif
 
 namespace DPsim {
 	// TODO extend / subclass
 	class SchedulingException {};
 
+	/// Hint to the CPU that the calling thread is busy waiting
+	inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+		_mm_pause();
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+		asm volatile("yield");
+#endif
+	}
+
+	/// Synchronization method of a barrier
+	enum class BarrierType {
+		/// All threads spin on a shared generation counter
+		Spin,
+		/// Threads sleep on a condition variable
+		Condition,
+		/// Threads spin for a limited time and then sleep on a futex
+		Hybrid,
+		/// Threads arrive at the nodes of a combining tree and spin on a sense flag
+		Tree
+	};
+
 	class Scheduler {
 	public:
 		/// Edges describe the dependency from the first task to a list of other tasks
@@ -32,6 +59,26 @@ namespace DPsim {
 		/// Time measurement for the task execution
 		typedef std::chrono::steady_clock::duration TaskTime;
 
+		/// Placement of the threads executing the tasks (only supported on Linux)
+		struct ThreadPlacement {
+			/// CPUs each thread may run on, thread i uses entry i modulo the number of entries.
+			/// Thread 0 is the simulation thread. No pinning if empty.
+			std::vector<std::vector<Int>> cpuSets;
+			/// SCHED_FIFO priority of the threads, 0 keeps the default policy.
+			/// The threads wait by spinning, so they should be pinned to separate CPUs.
+			Int priority = 0;
+			/// Allocate the schedule of each thread from the thread itself,
+			/// so the first-touch policy places it on the NUMA node of the thread
+			Bool numaLocal = false;
+			/// Lock all current and future pages of the process into memory
+			Bool lockMemory = false;
+
+			/// Parse a comma separated list of CPU sets, e.g. "0,1,2", "0-3,4-7" or "0+2,1+3"
+			static std::vector<std::vector<Int>> parseCpuSets(const String& list);
+			/// Throws std::invalid_argument if the CPU id does not fit into a cpu_set_t
+			static void checkCpu(Int cpu);
+		};
+
 		///
 		Scheduler(CPS::Logger::Level logLevel = CPS::Logger::Level::off) :
 			mRoot(std::make_shared<Root>()),
@@ -56,6 +103,15 @@ namespace DPsim {
 		/// and inserts a root task
 		void resolveDeps(CPS::Task::List& tasks, Edges& inEdges, Edges& outEdges);
 
+		/// Set the placement of the threads, must be called before createSchedule.
+		/// Throws std::invalid_argument for CPU ids out of range.
+		void setThreadPlacement(const ThreadPlacement& placement);
+		/// Set the synchronization method of the barriers between steps,
+		/// must be called before createSchedule. Ignored by schedulers without barriers.
+		virtual void setBarrierType(BarrierType type) { }
+		///
+		const ThreadPlacement& threadPlacement() const { return mPlacement; }
+
 		// Special attribute that can be returned in the modified attributes of a task
 		// to mark that this task has external side-effects (like logging / interfacing)
 		// and thus has to be executed even though it doesn't modify any attribute.
@@ -65,6 +121,8 @@ namespace DPsim {
 		TaskTime getAveragedMeasurement(CPS::Task::Ptr task) {
 			return getAveragedMeasurement(task.get());
 		}
+		/// Read measurement data from file to use it for the scheduling
+		static void readMeasurements(CPS::String filename, std::unordered_map<CPS::String, TaskTime::rep>& measurements);
 
 		/// Root task that has a dependency on the external attribute
 		/// which means that it should not be removed from the task graph
@@ -92,13 +150,16 @@ namespace DPsim {
 		void updateMeasurement(CPS::Task* task, TaskTime time);
 		/// Write measurement data to file
 		void writeMeasurements(CPS::String filename);
-		/// Read measurement data from file to use it for the scheduling
-		void readMeasurements(CPS::String filename, std::unordered_map<CPS::String, TaskTime::rep>& measurements);
 		///
 		TaskTime getAveragedMeasurement(CPS::Task* task);
 
+		/// Apply the thread placement to the calling thread, which executes the tasks of the given thread index
+		void applyThreadPlacement(Int thread);
+
 		///
 		CPS::Task::Ptr mRoot;
+		/// Placement of the threads
+		ThreadPlacement mPlacement;
 		/// Log level
 		CPS::Logger::Level mLogLevel;
 		/// Logger
@@ -120,27 +181,31 @@ namespace DPsim {
 		/// Limit sets the number of threads that need to reach the barrier
 		/// to release it.
 		Barrier(Int limit, Bool useCondition = false) :
-			mLimit(limit), mCount(0), mGeneration(0), mUseCondition(useCondition) {}
+			Barrier(limit, useCondition ? BarrierType::Condition : BarrierType::Spin) {}
+		///
+		Barrier(Int limit, BarrierType type);
+
+		/// Change the synchronization method, must not be called while threads are waiting
+		void setType(BarrierType type) { mType = type; }
+		///
+		BarrierType type() const { return mType; }
+		/// Time the hybrid barrier spins before the thread is put to sleep
+		void setSpinTime(std::chrono::nanoseconds spinTime) { mSpinTime = spinTime; }
 
 		/// Blocks until |limit| calls have been made, at which point all threads
 		/// return. Provides synchronization, i.e. all writes from before this call
 		/// are visible in all threads after this call.
-		void wait() {
-			if (mUseCondition) {
-				std::unique_lock<std::mutex> lk(mMutex);
-				Int gen = mGeneration;
-				mCount++;
-				if (mCount == mLimit) {
-					mCount = 0;
-					mGeneration++;
-					lk.unlock();
-					mCondition.notify_all();
-				} else {
-					// necessary because of spurious wakeups
-					while (gen == mGeneration)
-						mCondition.wait(lk);
-				}
-			} else {
+		/// The tree barrier uses the thread index (between 0 and limit-1) to select
+		/// its leaf, without index the leaves are assigned in order of arrival.
+		void wait(Int thread = -1) {
+			switch (mType) {
+			case BarrierType::Condition:
+				waitCondition();
+				break;
+			case BarrierType::Tree:
+				arriveTree(thread, true);
+				break;
+			default: {
 				Int gen = mGeneration.load(std::memory_order_acquire);
 				// We need at least one release from each thread to ensure that
 				// every write from before the wait() is visible in every other thread,
@@ -148,19 +213,26 @@ namespace DPsim {
 				// (This generates the same code on x86.)
 				if (mCount.fetch_add(1, std::memory_order_acq_rel) == mLimit-1) {
 					mCount.store(0, std::memory_order_relaxed);
-					mGeneration.fetch_add(1, std::memory_order_release);
+					release();
+				} else if (mType == BarrierType::Hybrid) {
+					waitHybrid(gen);
 				} else {
-					while (mGeneration.load(std::memory_order_acquire) == gen);
+					while (mGeneration.load(std::memory_order_acquire) == gen)
+						cpuRelax();
 				}
 			}
+			}
 		}
 
 		/// Increases the barrier counter like wait does, but does not wait for it to
 		/// reach the limit (so this does not provide any synchronization with
 		/// other threads). Can be used to eliminate unnecessary waits if
 		/// multiple barriers are used in sequence.
-		void signal() {
-			if (mUseCondition) {
+		/// The tree barrier requires the thread index here, as leaves assigned
+		/// in order of arrival could mix the arrivals of consecutive generations.
+		void signal(Int thread = -1) {
+			switch (mType) {
+			case BarrierType::Condition: {
 				std::unique_lock<std::mutex> lk(mMutex);
 				mCount++;
 				if (mCount == mLimit) {
@@ -169,23 +241,75 @@ namespace DPsim {
 					lk.unlock();
 					mCondition.notify_all();
 				}
-			} else {
+				break;
+			}
+			case BarrierType::Tree:
+				if (thread < 0)
+					throw SchedulingException();
+				arriveTree(thread, false);
+				break;
+			default:
 				// No release here, as this call does not provide any synchronization anyway.
 				if (mCount.fetch_add(1, std::memory_order_acquire) == mLimit-1) {
 					mCount.store(0, std::memory_order_relaxed);
-					mGeneration.fetch_add(1, std::memory_order_release);
+					release();
 				}
 			}
 		}
 
 	private:
+		/// Start the next generation and wake up sleeping threads
+		void release() {
+			if (mType == BarrierType::Hybrid) {
+				// Sequentially consistent, so either the sleeper sees the new
+				// generation or the releasing thread sees the sleeper
+				mGeneration.fetch_add(1);
+				if (mSleepers.load() > 0)
+					wakeSleepers();
+			} else {
+				mGeneration.fetch_add(1, std::memory_order_release);
+			}
+		}
+		///
+		void waitCondition();
+		/// Spin until the generation changes or the spin time is exceeded, then sleep
+		void waitHybrid(Int gen);
+		///
+		void wakeSleepers();
+		/// Arrive at the leaf of the thread and propagate to the root if the node is complete
+		void arriveTree(Int thread, Bool wait);
+
 		/// Barrier limit which has to be reached before the barrier is released.
 		Int mLimit;
+		///
+		BarrierType mType;
 		/// Barrier counter which is tested against limit
-		std::atomic<Int> mCount;
-		/// Allows multiple use of the barrier
-		std::atomic<Int> mGeneration;
-		Bool mUseCondition;
+		alignas(64) std::atomic<Int> mCount;
+		/// Allows multiple use of the barrier, on its own cache line as all waiting threads read it
+		alignas(64) std::atomic<Int> mGeneration;
+		/// Number of threads sleeping in the hybrid barrier
+		alignas(64) std::atomic<Int> mSleepers;
+		///
+		std::chrono::nanoseconds mSpinTime = std::chrono::microseconds(50);
+
+		/// Node of the combining tree, padded so that every node has its own cache line
+		struct alignas(64) TreeNode {
+			std::atomic<Int> count { 0 };
+			Int expected = 0;
+			Int parent = -1;
+		};
+		/// Flag of a thread, padded to avoid false sharing
+		struct alignas(64) TreeSense {
+			Bool sense = false;
+		};
+		/// Number of threads or children arriving at each node
+		static constexpr Int TREE_FAN_IN = 4;
+		std::unique_ptr<TreeNode[]> mTreeNodes;
+		std::unique_ptr<TreeSense[]> mTreeSenses;
+		/// Assigns leaves to threads calling wait without index
+		alignas(64) std::atomic<UInt> mTreeTickets;
+		/// Global sense, flipped by the last thread reaching the root
+		alignas(64) std::atomic<Bool> mTreeSense;
 
 		std::mutex mMutex;
 		std::condition_variable mCondition;
@@ -194,14 +318,20 @@ namespace DPsim {
 	class BarrierTask : public CPS::Task {
 	public:
 		typedef std::shared_ptr<BarrierTask> Ptr;
+		/// The thread index is passed to the barriers, it is required for tree barriers
+		BarrierTask(Int thread = -1) : mThread(thread) {}
 		void addBarrier(Barrier* b);
 		void execute(Real time, Int timeStepCount);
 
 	private:
 		std::vector<Barrier*> mBarriers;
+		/// Index of the thread executing this task
+		Int mThread;
 	};
 
-	class Counter {
+	/// Counter of finished steps, padded so that counters of different tasks
+	/// do not share a cache line
+	class alignas(64) Counter {
 	public:
 		Counter() : mValue(0) {}
 
@@ -210,7 +340,8 @@ namespace DPsim {
 		}
 
 		void wait(Int value) {
-			while (mValue.load(std::memory_order_acquire) != value);
+			while (mValue.load(std::memory_order_acquire) != value)
+				cpuRelax();
 		}
 
 	private:
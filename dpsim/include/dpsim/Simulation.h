@@ -8,6 +8,7 @@
 #include <dpsim/Config.h>
 #include <dpsim/DataLogger.h>
 #include <dpsim/Solver.h>
+#include <dpsim/PFSolver.h>
 #include <dpsim/Scheduler.h>
 #include <dpsim/Event.h>
 #include <dpsim-models/Definitions.h>
@@ -76,7 +77,9 @@ namespace DPsim {
 		/// Simulation log level
 		CPS::Logger::Level mLogLevel;
 		/// (Real) time needed for the timesteps
-		std::vector<Real> mStepTimes;
+		TimingStatistics mStepTimes;
+		/// Heap allocations during the timesteps (only counted with WITH_ALLOCATION_COUNTER)
+		std::size_t mStepAllocations = 0;
 
 		// #### Solver Settings ####
 		///
@@ -95,6 +98,24 @@ namespace DPsim {
 		Bool mInitFromNodesAndTerminals = true;
 		/// Enable recomputation of system matrix during simulation
 		Bool mSystemMatrixRecomputation = false;
+		/// Store the right vector contributions of the components compactly at their indices
+		Bool mSparseRightVectorStamping = false;
+		/// Keep the sparsity pattern of the variable system matrix fixed during recomputation
+		Bool mFreezeSystemMatrixPattern = false;
+		/// Factorize switch state dependent system matrices when they first occur
+		Bool mLazySwitchFactorization = false;
+		/// Maximum number of cached switch states, each with its system matrix and factorization (0 for no limit)
+		UInt mSwitchFactorizationCacheSize = 0;
+		/// Factorize switch states predicted from scheduled switch events in the background
+		Bool mSwitchPrefactorization = false;
+		/// Apply changes of the variable system matrix as low-rank correction to the existing factorization
+		Bool mLowRankSystemMatrixUpdates = false;
+		/// Number of accumulated low-rank updates after which the system matrix is refactorized
+		UInt mMaxLowRankUpdates = 10;
+		/// Number of scenarios solved together with the nominal system
+		UInt mNumScenarios = 0;
+		/// Update supported linear elements in bulk from contiguous storage
+		Bool mVectorizeLinearElements = false;
 
 		/// If tearing components exist, the Diakoptics
 		/// solver is selected automatically.
@@ -113,6 +134,18 @@ namespace DPsim {
 		Real mSteadStIniTimeLimit = 10;
 		/// steady state initialization accuracy limit
 		Real mSteadStIniAccLimit = 0.0001;
+		/// steady state initialization time step, the simulation time step is used if zero
+		Real mSteadStIniTimeStep = 0;
+		/// Activates Anderson acceleration of the steady state initialization
+		Bool mSteadStIniAcceleration = false;
+		/// Log the solution and source vectors of every steady state initialization step
+		Bool mSteadStIniLogging = false;
+
+		// #### Powerflow ####
+		/// Start each powerflow from the solution of the previous time step
+		Bool mPowerflowWarmStart = false;
+		/// Reuse the powerflow Jacobian factorization while the mismatch contracts
+		Bool mPowerflowJacobianReuse = false;
 
 		// #### Task dependencies und scheduling ####
 		/// Scheduler used for task scheduling
@@ -121,6 +154,18 @@ namespace DPsim {
 		CPS::Task::List mTasks;
 		/// Task dependencies as incoming / outgoing edges
 		Scheduler::Edges mTaskInEdges, mTaskOutEdges;
+		/// Merge small tasks of the dependency graph before scheduling
+		Bool mTaskFusion = false;
+		/// Tasks with a lower estimated execution time are fused with their siblings
+		Real mTaskFusionMinTaskTime = 10e-6;
+		/// Minimum number of tasks kept from a group of siblings, 0 for the number of hardware threads
+		UInt mTaskFusionParallelism = 0;
+		/// Measurement file of a previous run providing the task execution times
+		String mTaskFusionMeasurementFile;
+		/// Placement of the scheduler threads, only applied if set explicitly
+		Scheduler::ThreadPlacement mThreadPlacement;
+		///
+		Bool mThreadPlacementSet = false;
 
 		/// Vector of Interfaces
 		std::vector<Interface::Ptr> mInterfaces;
@@ -193,10 +238,50 @@ namespace DPsim {
 		void setScheduler(const std::shared_ptr<Scheduler> &scheduler) {
 			mScheduler = scheduler;
 		}
+		/// Merge chains and sibling groups of small tasks into fused tasks before scheduling
+		void doTaskFusion(Bool value) { mTaskFusion = value; }
+		/// Set the execution time in seconds below which sibling tasks are fused
+		void setTaskFusionMinTaskTime(Real value) { mTaskFusionMinTaskTime = value; }
+		/// Set the minimum number of tasks kept from a group of siblings, usually the number of threads
+		void setTaskFusionParallelism(UInt value) { mTaskFusionParallelism = value; }
+		/// Use the task execution times of a previous run, as written by the schedulers, as cost estimates
+		void setTaskFusionMeasurementFile(String filename) { mTaskFusionMeasurementFile = filename; }
+		/// Set core affinity, real-time priority and memory placement of the scheduler threads
+		void setThreadPlacement(const Scheduler::ThreadPlacement& placement) {
+			mThreadPlacement = placement;
+			mThreadPlacementSet = true;
+		}
 		/// Compute phasors of different frequencies in parallel
 		void doFrequencyParallelization(Bool value) { mFreqParallel = value; }
 		///
 		void doSystemMatrixRecomputation(Bool value) { mSystemMatrixRecomputation = value; }
+		/// Components store their right side vector contributions only at the entries they
+		/// stamp into instead of as full-length vectors, which are then added up at these entries.
+		/// The right_vector attributes of the components hold the compact contributions.
+		void doSparseRightVectorStamping(Bool value) { mSparseRightVectorStamping = value; }
+		/// Restamp the variable system matrix in place on a pattern that is fixed at initialization
+		void doFreezeSystemMatrixPattern(Bool value) { mFreezeSystemMatrixPattern = value; }
+		/// Factorize the system matrix of a switch state the first time it occurs
+		/// instead of precomputing all switch combinations. Not supported when
+		/// computing frequencies in parallel, all combinations are factorized then.
+		void doLazySwitchFactorization(Bool value) { mLazySwitchFactorization = value; }
+		/// Limit the number of cached switch states, least recently used are evicted first.
+		/// The limit counts states, each holding a system matrix and its factorization,
+		/// so the memory per state grows with the size of the system.
+		void setSwitchFactorizationCacheSize(UInt size) { mSwitchFactorizationCacheSize = size; }
+		/// Factorize the switch states resulting from scheduled switch events in a background thread
+		void doSwitchPrefactorization(Bool value) { mSwitchPrefactorization = value; }
+		/// Handle switch and variable element changes with a Sherman-Morrison-Woodbury
+		/// correction instead of refactorizing the system matrix (requires system matrix recomputation)
+		void doLowRankSystemMatrixUpdates(Bool value) { mLowRankSystemMatrixUpdates = value; }
+		/// Set number of accumulated low-rank updates after which the system matrix is refactorized
+		void setMaxLowRankUpdates(UInt value) { mMaxLowRankUpdates = value; }
+		/// Solve additional source vector scenarios with the nominal system matrix in one blocked solve per step.
+		/// The offsets of the scenarios are set with setScenarioRightSideOffsets after the initialization.
+		void setNumberOfScenarios(UInt value) { mNumScenarios = value; }
+		/// Keep the states of inductors and capacitors in contiguous arrays and update them
+		/// with one pre-step and one post-step task per solver instead of per component tasks
+		void doVectorizeLinearElements(Bool value) { mVectorizeLinearElements = value; }
 
 		// #### Initialization ####
 		/// activate steady state initialization
@@ -205,6 +290,18 @@ namespace DPsim {
 		void setSteadStIniTimeLimit(Real v) { mSteadStIniTimeLimit = v; }
 		/// set steady state initialization accuracy limit
 		void setSteadStIniAccLimit(Real v) { mSteadStIniAccLimit = v; }
+		/// set steady state initialization time step, which may be larger than the simulation time step
+		void setSteadStIniTimeStep(Real v) { mSteadStIniTimeStep = v; }
+		/// activate Anderson acceleration of the steady state initialization
+		void doSteadStIniAcceleration(Bool f) { mSteadStIniAcceleration = f; }
+		/// activate logging of the steady state initialization steps
+		void doSteadStIniLogging(Bool f) { mSteadStIniLogging = f; }
+
+		// #### Powerflow ####
+		/// start each powerflow from the converged solution of the previous time step
+		void doPowerflowWarmStart(Bool f) { mPowerflowWarmStart = f; }
+		/// reuse the Jacobian factorization across iterations and time steps (dishonest Newton)
+		void doPowerflowJacobianReuse(Bool f) { mPowerflowJacobianReuse = f; }
 
 		// #### Simulation Control ####
 		/// Create solver instances etc.
@@ -217,6 +314,13 @@ namespace DPsim {
 		Real next();
 		/// Run simulation until total time is elapsed.
 		void run();
+		/// Solve the powerflow for all time steps as quasi-static time series,
+		/// split into chunks solved in parallel, and write the node voltages to a binary file
+		void runPowerflowTimeSeries(String outputFile, UInt numChunks = 1);
+		/// Solve all N-1 contingencies of the powerflow at the current time on several threads
+		/// and write the ranked violation report as CSV file, if a file name is given
+		std::vector<PFSolver::ContingencyResult> runPowerflowContingencies(String reportFile, UInt numThreads = 1,
+			const PFSolver::ContingencyLimits& limits = PFSolver::ContingencyLimits());
 		/// Solve system A * x = z for x and current time
 		virtual Real step();
 		/// Synchronize simulation with remotes by exchanging intial state over interfaces
@@ -232,6 +336,9 @@ namespace DPsim {
 		void addLogger(DataLogger::Ptr logger) {
 			mLoggers.push_back(logger);
 		}
+		/// Set the number of recent step time measurements that are kept,
+		/// TimingStatistics::DEFAULT_CAPACITY (65536) by default
+		void setStepTimesCapacity(UInt capacity) { mStepTimes = TimingStatistics(capacity); }
 		/// Write step time measurements to log file
 		void logStepTimes(String logName);
 
@@ -257,7 +364,43 @@ namespace DPsim {
 		Real timeStep() const { return **mTimeStep; }
 		DataLogger::List& loggers() { return mLoggers; }
 		std::shared_ptr<Scheduler> scheduler() { return mScheduler; }
-		std::vector<Real>& stepTimes() { return mStepTimes; }
+		/// DEPRECATED: Only use for compatibility, returns a copy of the most recent step times.
+		/// Use stepTimeStatistics() instead, which covers all steps.
+		std::vector<Real> stepTimes() const { return mStepTimes.samples(); }
+		/// Statistics of the step times, percentiles cover all steps while only the
+		/// most recent samples are kept (see setStepTimesCapacity)
+		const TimingStatistics& stepTimeStatistics() const { return mStepTimes; }
+		/// Get solve time measurements of a solver (nullptr if not available).
+		/// Solvers keep the most recent TimingStatistics::DEFAULT_CAPACITY samples.
+		const TimingStatistics* solveTimes(UInt solverIdx = 0) const {
+			return solverIdx < mSolvers.size() ? mSolvers[solverIdx]->solveTimes() : nullptr;
+		}
+		/// Get refactorization time measurements of a solver (nullptr if not available)
+		const TimingStatistics* recomputationTimes(UInt solverIdx = 0) const {
+			return solverIdx < mSolvers.size() ? mSolvers[solverIdx]->recomputationTimes() : nullptr;
+		}
+		/// Get low-rank update time measurements of a solver (nullptr if not available)
+		const TimingStatistics* lowRankUpdateTimes(UInt solverIdx = 0) const {
+			return solverIdx < mSolvers.size() ? mSolvers[solverIdx]->lowRankUpdateTimes() : nullptr;
+		}
+		/// Get the number of linear elements a solver updates in bulk (see doVectorizeLinearElements)
+		UInt numVectorizedLinearElements(UInt solverIdx = 0) const {
+			return solverIdx < mSolvers.size() ? mSolvers[solverIdx]->numVectorizedLinearElements() : 0;
+		}
+		/// Get the counters of the lazily factorized switch states of a solver (nullptr if not available)
+		const SwitchFactorizationStatistics* switchFactorizationStatistics(UInt solverIdx = 0) const {
+			return solverIdx < mSolvers.size() ? mSolvers[solverIdx]->switchFactorizationStatistics() : nullptr;
+		}
+		std::size_t stepAllocations() const { return mStepAllocations; }
+
+		// #### Scenarios ####
+		/// Set the source vector offsets of the scenarios, one column per scenario.
+		/// The simulation has to be initialized. Each scenario solution is the nominal
+		/// solution plus the inverse system matrix applied to the offset, because all
+		/// scenarios share the component states of the nominal system.
+		void setScenarioRightSideOffsets(const Matrix& offsets, UInt solverIdx = 0);
+		/// Get the solution vectors of the scenarios of the last step, one column per scenario
+		const Matrix& scenarioLeftSideVectors(UInt solverIdx = 0) const;
 
 		// #### Set component attributes during simulation ####
 		/// CHECK: Can these be deleted? getIdObjAttribute + "**attr =" should suffice
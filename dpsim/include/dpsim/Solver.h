@@ -15,6 +15,8 @@
 #include <dpsim/Definitions.h>
 #include <dpsim/Config.h>
 #include <dpsim/DirectLinearSolverConfiguration.h>
+#include <dpsim/Event.h>
+#include <dpsim/TimingStatistics.h>
 #include <dpsim-models/Logger.h>
 #include <dpsim-models/SystemTopology.h>
 #include <dpsim-models/Task.h>
@@ -26,6 +28,18 @@ namespace DPsim {
 		UInt systemIndex;
 	};
 
+	/// Counters of the lazily factorized switch states
+	struct SwitchFactorizationStatistics {
+		/// States factorized when they occurred for the first time
+		UInt onDemand = 0;
+		/// States factorized in the background before they occurred
+		UInt prefactorized = 0;
+		/// Prefactorized states that were used by a step
+		UInt prefactorizationHits = 0;
+		/// Factorizations evicted from the cache of least recently used states
+		UInt evictions = 0;
+	};
+
 	/// Base class for more specific solvers such as MNA, ODE or IDA.
 	class Solver {
 	public:
@@ -53,6 +67,15 @@ namespace DPsim {
 		Real mSteadStIniAccLimit = 0.0001;
 		/// Activates steady state initialization
 		Bool mSteadyStateInit = false;
+		/// steady state initialization time step, the simulation time step is used if zero or
+		/// if a component does not support a change of the time step
+		Real mSteadStIniTimeStep = 0;
+		/// Activates Anderson acceleration of the steady state initialization
+		Bool mSteadStIniAcceleration = false;
+		/// Number of previous steps used by the Anderson acceleration
+		UInt mSteadStIniAccelerationDepth = 5;
+		/// Log the solution and source vectors of every steady state initialization step
+		Bool mSteadStIniLogging = false;
 		/// Determines if solver is in initialization phase, which requires different behavior
 		Bool mIsInInitialization = false;
 		/// Activates powerflow initialization
@@ -60,6 +83,22 @@ namespace DPsim {
 		Bool mInitFromNodesAndTerminals = true;
 		/// Enable recomputation of system matrix during simulation
 		Bool mSystemMatrixRecomputation = false;
+		/// Store the right vector contributions of the components compactly at their indices
+		Bool mSparseRightVectorStamping = false;
+		/// Keep the sparsity pattern of the variable system matrix fixed during recomputation
+		Bool mFreezeSystemMatrixPattern = false;
+		/// Factorize switch state dependent system matrices when they first occur instead of up front
+		Bool mLazySwitchFactorization = false;
+		/// Maximum number of cached switch states, each with its system matrix and factorization (0 for no limit)
+		UInt mSwitchFactorizationCacheSize = 0;
+		/// Apply changes of the variable system matrix as low-rank correction to the existing factorization
+		Bool mLowRankSystemMatrixUpdates = false;
+		/// Number of accumulated low-rank updates after which the system matrix is refactorized
+		UInt mMaxLowRankUpdates = 10;
+		/// Number of scenarios solved together with the nominal system
+		UInt mNumScenarios = 0;
+		/// Update supported linear elements in bulk from contiguous storage instead of per component tasks
+		Bool mVectorizeLinearElements = false;
 
 		/// Solver behaviour initialization or simulation
         Behaviour mBehaviour = Solver::Behaviour::Simulation;
@@ -76,8 +115,9 @@ namespace DPsim {
 
 		// #### Solver settings ####
 		/// Solver types:
-		/// Modified Nodal Analysis, Differential Algebraic, Newton Raphson
-		enum class Type { MNA, DAE, NRP };
+		/// Modified Nodal Analysis, Differential Algebraic, Newton Raphson,
+		/// Fast Decoupled (XB and BX variants), linear DC powerflow
+		enum class Type { MNA, DAE, NRP, FDXB, FDBX, DCPF };
 		///
 		void setTimeStep(Real timeStep) {
 			mTimeStep = timeStep;
@@ -90,6 +130,22 @@ namespace DPsim {
 		virtual void setSystem(const CPS::SystemTopology &system) {}
 		///
 		void doSystemMatrixRecomputation(Bool value) { mSystemMatrixRecomputation = value; }
+		///
+		void doSparseRightVectorStamping(Bool value) { mSparseRightVectorStamping = value; }
+		///
+		void doFreezeSystemMatrixPattern(Bool value) { mFreezeSystemMatrixPattern = value; }
+		///
+		void doLazySwitchFactorization(Bool value) { mLazySwitchFactorization = value; }
+		///
+		void setSwitchFactorizationCacheSize(UInt size) { mSwitchFactorizationCacheSize = size; }
+		///
+		void doLowRankSystemMatrixUpdates(Bool value) { mLowRankSystemMatrixUpdates = value; }
+		///
+		void setMaxLowRankUpdates(UInt value) { mMaxLowRankUpdates = value; }
+		///
+		void setNumberOfScenarios(UInt value) { mNumScenarios = value; }
+		///
+		void doVectorizeLinearElements(Bool value) { mVectorizeLinearElements = value; }
 
 		// #### Initialization ####
 		///
@@ -100,6 +156,14 @@ namespace DPsim {
 		void setSteadStIniTimeLimit(Real v) { mSteadStIniTimeLimit = v; }
 		/// set steady state initialization accuracy limit
 		void setSteadStIniAccLimit(Real v) { mSteadStIniAccLimit = v; }
+		/// set steady state initialization time step
+		void setSteadStIniTimeStep(Real v) { mSteadStIniTimeStep = v; }
+		/// activate Anderson acceleration of the steady state initialization
+		void doSteadStIniAcceleration(Bool f) { mSteadStIniAcceleration = f; }
+		/// set number of previous steps used by the Anderson acceleration
+		void setSteadStIniAccelerationDepth(UInt v) { mSteadStIniAccelerationDepth = v; }
+		/// activate logging of the steady state initialization steps
+		void doSteadStIniLogging(Bool f) { mSteadStIniLogging = f; }
 		/// set solver and component to initialization or simulation behaviour
 		virtual void setSolverAndComponentBehaviour(Solver::Behaviour behaviour) {}
 		/// activate powerflow initialization
@@ -114,6 +178,25 @@ namespace DPsim {
 		{
 			// no default implementation for all types of solvers
 		}
+		/// Get solve time measurements, if applicable
+		virtual const TimingStatistics* solveTimes() const { return nullptr; }
+		/// Get refactorization time measurements, if applicable
+		virtual const TimingStatistics* recomputationTimes() const { return nullptr; }
+		/// Get measurements of low-rank updates applied instead of refactorizations, if applicable
+		virtual const TimingStatistics* lowRankUpdateTimes() const { return nullptr; }
+		/// Get the number of components whose companion models are updated in bulk, if applicable
+		virtual UInt numVectorizedLinearElements() const { return 0; }
+		/// Get the counters of the lazily factorized switch states, if applicable
+		virtual const SwitchFactorizationStatistics* switchFactorizationStatistics() const { return nullptr; }
+		/// Get the source vector offsets of the scenarios, if applicable
+		virtual CPS::Attribute<Matrix>::Ptr scenarioRightSideOffsets() const { return nullptr; }
+		/// Get the solution vectors of the scenarios, if applicable
+		virtual CPS::Attribute<Matrix>::Ptr scenarioLeftSideVectors() const { return nullptr; }
+		/// prepare system states for scheduled switch state changes, if applicable
+		virtual void prefactorizeSwitchStates(const std::vector<SwitchStateChange>& changes)
+		{
+			// only solvers with switch state dependent factorizations make use of this
+		}
 
 		// #### Simulation ####
 		/// Get tasks for scheduler
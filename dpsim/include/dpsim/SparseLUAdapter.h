@@ -24,6 +24,17 @@ namespace DPsim
 	class SparseLUAdapter : public DirectLinearSolver
     {
         Eigen::SparseLU<CPS::SparseMatrixRow, Eigen::COLAMDOrdering<int> > LUFactorizedSparse;
+		/// Work matrix of the forward substitution
+		Matrix mWork;
+		/// Buffer for permuting solutions, which Eigen cannot do in place without allocating
+		Matrix mPermutationBuffer;
+
+		/// Forward and backward substitution of right hand sides that are already permuted by the row permutation
+		void substitute(Matrix& solution);
+		/// Forward substitution with the supernodal lower factor using the preallocated work matrix
+		void solveLowerInPlace(Matrix& solution);
+		/// Leading columns of the permutation buffer, which is only reallocated to grow
+		Eigen::Block<Matrix, Eigen::Dynamic, Eigen::Dynamic, true> permutationBuffer(Eigen::Index rows, Eigen::Index cols);
 
         public:
 		/// Constructor with logging
@@ -46,5 +57,11 @@ namespace DPsim
 
 		/// solution function for a right hand side
 		Matrix solve(Matrix& rightSideVector) override;
+
+		/// solution function writing into a preallocated solution vector
+		void solveInPlace(const Matrix& rightSideVector, Matrix& solution) override;
+
+		/// solution function for a block of right hand sides, overwritten with the solutions
+		void solveBatch(Matrix& rightSideVectors) override;
     };
 }
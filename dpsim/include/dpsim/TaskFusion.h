@@ -0,0 +1,86 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <dpsim/Scheduler.h>
+
+#include <unordered_map>
+#include <vector>
+
+namespace DPsim {
+	/// Task executing several tasks of the dependency graph in a fixed order
+	class FusedTask : public CPS::Task {
+	public:
+		typedef std::shared_ptr<FusedTask> Ptr;
+
+		/// The tasks have to be given in a valid execution order
+		FusedTask(const CPS::Task::List& tasks);
+
+		void execute(Real time, Int timeStepCount) override {
+			for (auto& task : mTasks)
+				task->execute(time, timeStepCount);
+		}
+
+		///
+		const CPS::Task::List& tasks() const { return mTasks; }
+
+	private:
+		CPS::Task::List mTasks;
+	};
+
+	/// \brief Graph optimization pass merging small tasks into fused tasks.
+	///
+	/// Runs on the graph produced by Scheduler::resolveDeps and before
+	/// Scheduler::createSchedule, so it can be combined with every scheduler.
+	/// Chains of tasks with a single successor and predecessor are always merged,
+	/// as this does not remove any parallelism. Sibling tasks with the same
+	/// predecessors and successors are packed into groups whose estimated cost
+	/// reaches the minimum task time, keeping at least as many groups as given
+	/// by the parallelism.
+	class TaskFusion {
+	public:
+		/// Measured execution times by task name, as written by the schedulers
+		typedef std::unordered_map<String, Scheduler::TaskTime::rep> Measurements;
+
+		TaskFusion(Scheduler::TaskTime minTaskTime = std::chrono::microseconds(10),
+			UInt parallelism = 1,
+			CPS::Logger::Level logLevel = CPS::Logger::Level::info);
+
+		/// Use the averaged execution times of a previous run as cost estimates
+		void readMeasurements(String filename);
+		/// Use the given execution times as cost estimates
+		void setMeasurements(const Measurements& measurements) { mMeasurements = measurements; }
+
+		/// Replace groups of tasks by fused tasks and update the edges accordingly.
+		/// The root task inserted by resolveDeps is never fused.
+		void apply(CPS::Task::List& tasks, Scheduler::Edges& inEdges, Scheduler::Edges& outEdges);
+
+	private:
+		/// Estimated cost of a task, tasks without measurement are treated as negligible
+		Scheduler::TaskTime::rep cost(const CPS::Task::Ptr& task);
+		/// Replace the given tasks by one fused task
+		CPS::Task::Ptr fuse(const CPS::Task::List& group, CPS::Task::List& tasks,
+			Scheduler::Edges& inEdges, Scheduler::Edges& outEdges);
+		/// Merge tasks with a single successor that has no other predecessor
+		UInt fuseChains(CPS::Task::List& tasks, Scheduler::Edges& inEdges, Scheduler::Edges& outEdges);
+		/// Pack tasks with identical predecessors and successors into groups
+		UInt fuseSiblings(CPS::Task::List& tasks, Scheduler::Edges& inEdges, Scheduler::Edges& outEdges);
+
+		///
+		Scheduler::TaskTime mMinTaskTime;
+		///
+		UInt mParallelism;
+		///
+		Measurements mMeasurements;
+		/// Cost estimates of fused tasks
+		std::unordered_map<CPS::Task*, Scheduler::TaskTime::rep> mFusedCosts;
+		///
+		CPS::Logger::Log mSLog;
+	};
+}
@@ -21,6 +21,7 @@ namespace DPsim {
 
 		void step(Real time, Int timeStepCount);
 		virtual void stop();
+		void setBarrierType(BarrierType type) { mStartBarrier.setType(type); }
 
 	protected:
 		void finishSchedule(const Edges& inEdges);
@@ -30,10 +31,14 @@ namespace DPsim {
 
 	private:
 		void doStep(Int scheduleIdx);
+		/// Create the schedule entries of a thread
+		void allocateSchedule(Int thread);
 		static void threadFunction(ThreadScheduler* sched, Int idx);
 
 		String mOutMeasurementFile;
 		Barrier mStartBarrier;
+		/// Released when all threads have applied their placement and allocated their schedule
+		Barrier mSetupBarrier;
 
 		std::vector<std::thread> mThreads;
 
@@ -0,0 +1,81 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <dpsim/Definitions.h>
+
+namespace DPsim {
+
+	/// Bounded collection of timing measurements in seconds.
+	///
+	/// All memory is allocated on construction, so adding a measurement in the
+	/// simulation loop never allocates. Only the most recent measurements are
+	/// kept in a ring buffer. Count, minimum, maximum and mean are computed
+	/// over all measurements. Percentiles are estimated from a log-linear
+	/// (HDR-style) histogram with nanosecond resolution and a relative error
+	/// of at most 1/32. The number of kept measurements is fixed per instance,
+	/// DEFAULT_CAPACITY unless another capacity is passed to the constructor.
+	class TimingStatistics {
+	public:
+		/// Default number of recent measurements that are kept
+		static constexpr UInt DEFAULT_CAPACITY = 1 << 16;
+
+		TimingStatistics(UInt capacity = DEFAULT_CAPACITY);
+
+		/// Add a measurement in seconds
+		void add(Real time);
+		/// Discard all measurements
+		void reset();
+
+		/// Number of measurements since the last reset
+		std::uint64_t count() const { return mCount; }
+		/// Check if no measurement has been added since the last reset
+		Bool empty() const { return mCount == 0; }
+		/// Number of recent measurements that are kept
+		UInt capacity() const { return static_cast<UInt>(mSamples.size()); }
+
+		Real sum() const { return mSum; }
+		Real min() const { return mCount ? mMin : 0; }
+		Real max() const { return mCount ? mMax : 0; }
+		Real mean() const { return mCount ? mSum / mCount : 0; }
+		/// Estimated p-th percentile (0 <= p <= 100) of all measurements
+		Real percentile(Real p) const;
+
+		/// Most recent measurement (zero if there is none)
+		Real last() const;
+		/// Recent measurements in chronological order
+		std::vector<Real> samples() const;
+
+	private:
+		/// log2 of the number of linear sub-buckets per power of two
+		static constexpr UInt SUB_BUCKET_BITS = 5;
+		static constexpr UInt SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+		/// Measurements above 2^MAX_EXPONENT ns (about 36 minutes) are clamped
+		static constexpr UInt MAX_EXPONENT = 41;
+		static constexpr UInt NUM_BUCKETS = (MAX_EXPONENT - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+		static UInt bucketIndex(std::uint64_t nanoseconds);
+		static std::uint64_t bucketUpperBound(UInt index);
+
+		std::vector<Real> mSamples;
+		/// Position of the next measurement in the ring buffer
+		UInt mNext = 0;
+
+		/// 64 bit, so that per step measurements of long real-time runs do not overflow
+		std::uint64_t mCount = 0;
+		Real mSum = 0;
+		Real mMin = 0;
+		Real mMax = 0;
+		std::array<std::uint64_t, NUM_BUCKETS> mHistogram;
+	};
+}
@@ -107,6 +107,7 @@ public:
 	} solver;
 	DPsim::DirectLinearSolverImpl directImpl;
 	String solverPluginName;
+	Scheduler::ThreadPlacement threadPlacement;
 
 	DPsim::Timer::StartClock::time_point startTime;
 
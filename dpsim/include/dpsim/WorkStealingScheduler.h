@@ -0,0 +1,92 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <dpsim/Scheduler.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace DPsim {
+	/// Scheduler which distributes the tasks dynamically among the threads.
+	///
+	/// Every task has an atomic counter of unfinished predecessors. A thread
+	/// which finishes a task puts the successors that became ready into its own
+	/// queue. Idle threads steal tasks from the queues of the other threads, so
+	/// the load is balanced even if task durations vary from step to step.
+	/// Threads are only synchronized at the start and end of each step.
+	class WorkStealingScheduler : public Scheduler {
+	public:
+		WorkStealingScheduler(Int threads = 1, String outMeasurementFile = String(), Bool pinThreads = false, Bool useConditionVariable = false);
+		virtual ~WorkStealingScheduler();
+
+		void createSchedule(const CPS::Task::List& tasks, const Edges& inEdges, const Edges& outEdges);
+		void step(Real time, Int timeStepCount);
+		void stop();
+		void setBarrierType(BarrierType type) {
+			mStartBarrier.setType(type);
+			mEndBarrier.setType(type);
+		}
+
+	private:
+		/// Fixed-size double-ended queue of task indices. The owning thread
+		/// takes the most recently added task, other threads steal the oldest one.
+		class alignas(64) TaskQueue {
+		public:
+			void reserve(UInt capacity) { mTasks.resize(capacity); }
+			/// Only called between steps, when the queue is empty and no other thread accesses it
+			void reset() { mHead = 0; mTail = 0; }
+			void push(UInt task);
+			Bool pop(UInt& task);
+			Bool steal(UInt& task);
+
+		private:
+			void lock() { while (mLock.test_and_set(std::memory_order_acquire)); }
+			void unlock() { mLock.clear(std::memory_order_release); }
+
+			std::vector<UInt> mTasks;
+			/// Positions of the oldest and after the newest task (modulo capacity).
+			/// They are reset in every step, so they stay below the number of tasks and do not wrap around.
+			UInt mHead = 0;
+			UInt mTail = 0;
+			std::atomic_flag mLock = ATOMIC_FLAG_INIT;
+		};
+
+		void doStep(Int thread);
+		void runTask(Int thread, UInt task);
+		static void threadFunction(WorkStealingScheduler* sched, Int idx);
+
+		Int mNumThreads;
+		String mOutMeasurementFile;
+		Bool mPinThreads;
+		Barrier mStartBarrier;
+		Barrier mEndBarrier;
+		std::vector<std::thread> mThreads;
+
+		/// Tasks to execute in topological order
+		std::vector<CPS::Task*> mTasks;
+		/// Indices of the successors of each task
+		std::vector<std::vector<UInt>> mSuccessors;
+		/// Number of predecessors of each task
+		std::vector<Int> mNumPredecessors;
+		/// Tasks without predecessors
+		std::vector<UInt> mInitialTasks;
+		/// Number of unfinished predecessors of each task in the current step
+		std::unique_ptr<std::atomic<Int>[]> mPendingPredecessors;
+		/// Number of unfinished tasks in the current step
+		alignas(64) std::atomic<UInt> mRemainingTasks { 0 };
+		std::unique_ptr<TaskQueue[]> mQueues;
+
+		Bool mJoining = false;
+		Real mTime = 0;
+		Int mTimeStepCount = 0;
+	};
+}
@@ -0,0 +1,236 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/AdaptiveListScheduler.h>
+
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+
+using namespace CPS;
+using namespace DPsim;
+
+/// Number of steps after a rebuild before the step time is used as reference
+static const UInt REFERENCE_STEPS = 10;
+
+AdaptiveListScheduler::AdaptiveListScheduler(Int threads, UInt rebalanceInterval, Real regressionThreshold,
+	Real smoothing, String inMeasurementFile, String outMeasurementFile, Bool useConditionVariable) :
+	mNumThreads(threads), mRebalanceInterval(rebalanceInterval), mRegressionThreshold(regressionThreshold),
+	mSmoothing(smoothing), mInMeasurementFile(inMeasurementFile), mOutMeasurementFile(outMeasurementFile),
+	mStartBarrier(threads, useConditionVariable), mEndBarrier(threads, useConditionVariable) {
+	if (threads < 1 || smoothing <= 0 || smoothing > 1)
+		throw SchedulingException();
+	// The reference has to be taken before the interval rebuilds the schedule anyway
+	mReferenceSteps = rebalanceInterval > 0
+		? std::min(REFERENCE_STEPS, std::max<UInt>(rebalanceInterval / 2, 1))
+		: REFERENCE_STEPS;
+}
+
+AdaptiveListScheduler::~AdaptiveListScheduler() {
+	// Threads are usually joined by stop(), but the simulation might not have been stopped
+	if (!mThreads.empty())
+		stop();
+}
+
+void AdaptiveListScheduler::createSchedule(const Task::List& tasks, const Edges& inEdges, const Edges& outEdges) {
+	// Threads of a previous schedule would access the replaced task states
+	joinThreads();
+	mStepsSinceRebalance = 0;
+	mReferenceStepTime = 0;
+
+	Task::List ordered;
+	Scheduler::topologicalSort(tasks, inEdges, outEdges, ordered);
+
+	std::unordered_map<Task::Ptr, UInt> indices;
+	for (UInt i = 0; i < ordered.size(); ++i)
+		indices[ordered[i]] = i;
+
+	mTasks.clear();
+	mPredecessors.assign(ordered.size(), {});
+	mSuccessors.assign(ordered.size(), {});
+	for (UInt i = 0; i < ordered.size(); ++i) {
+		mTasks.push_back(ordered[i].get());
+		// Edges to dropped tasks and the root task are not relevant for the step
+		if (outEdges.find(ordered[i]) == outEdges.end())
+			continue;
+		for (auto& after : outEdges.at(ordered[i])) {
+			auto it = indices.find(after);
+			if (it == indices.end())
+				continue;
+			if (std::find(mSuccessors[i].begin(), mSuccessors[i].end(), it->second) != mSuccessors[i].end())
+				continue;
+			mSuccessors[i].push_back(it->second);
+			mPredecessors[it->second].push_back(i);
+		}
+	}
+
+	mStates = std::make_unique<TaskState[]>(ordered.size());
+	if (!mInMeasurementFile.empty()) {
+		std::unordered_map<String, TaskTime::rep> measurements;
+		readMeasurements(mInMeasurementFile, measurements);
+		for (UInt i = 0; i < ordered.size(); ++i) {
+			auto it = measurements.find(ordered[i]->toString());
+			if (it != measurements.end())
+				mStates[i].duration = std::max<Real>(static_cast<Real>(it->second), 1);
+		}
+	}
+
+	if (!mOutMeasurementFile.empty())
+		Scheduler::initMeasurements(ordered);
+
+	buildSchedule(mSchedules[0]);
+	mActiveSchedule.store(&mSchedules[0], std::memory_order_release);
+
+	SPDLOG_LOGGER_INFO(mSLog, "Adaptive list schedule with {} tasks on {} threads, rebalance interval {} steps",
+		mTasks.size(), mNumThreads, mRebalanceInterval);
+
+	for (Int i = 1; i < mNumThreads; i++)
+		mThreads.emplace_back(threadFunction, this, i);
+	applyThreadPlacement(0);
+}
+
+void AdaptiveListScheduler::buildSchedule(Schedule& schedule) {
+	UInt numTasks = static_cast<UInt>(mTasks.size());
+
+	// Upward rank: duration of the task plus the longest path to the end of the step.
+	// Durations are at least 1 ns, so every task ranks strictly higher than its successors.
+	std::vector<Real> durations(numTasks), ranks(numTasks, 0);
+	for (UInt i = 0; i < numTasks; ++i)
+		durations[i] = std::max<Real>(mStates[i].duration, 1);
+	for (UInt i = numTasks; i-- > 0;) {
+		Real maxSucc = 0;
+		for (UInt after : mSuccessors[i])
+			maxSucc = std::max(maxSucc, ranks[after]);
+		ranks[i] = durations[i] + maxSucc;
+	}
+
+	std::vector<UInt> order(numTasks);
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(),
+		[&ranks](UInt a, UInt b) { return ranks[a] > ranks[b]; });
+
+	// Assign each task to the thread where it finishes earliest
+	schedule.assign(mNumThreads, {});
+	std::vector<Real> available(mNumThreads, 0), finish(numTasks, 0);
+	for (UInt task : order) {
+		Real ready = 0;
+		for (UInt before : mPredecessors[task])
+			ready = std::max(ready, finish[before]);
+
+		Int best = 0;
+		Real bestFinish = std::max(available[0], ready) + durations[task];
+		for (Int thread = 1; thread < mNumThreads; ++thread) {
+			Real threadFinish = std::max(available[thread], ready) + durations[task];
+			if (threadFinish < bestFinish) {
+				best = thread;
+				bestFinish = threadFinish;
+			}
+		}
+		schedule[best].push_back(task);
+		available[best] = bestFinish;
+		finish[task] = bestFinish;
+	}
+
+	SPDLOG_LOGGER_DEBUG(mSLog, "Schedule rebuilt, estimated step time {} ns",
+		*std::max_element(available.begin(), available.end()));
+}
+
+void AdaptiveListScheduler::rebalance() {
+	// All threads wait at the start barrier, so the inactive buffer is not in use
+	Schedule* inactive = mActiveSchedule.load(std::memory_order_relaxed) == &mSchedules[0]
+		? &mSchedules[1] : &mSchedules[0];
+	buildSchedule(*inactive);
+	mActiveSchedule.store(inactive, std::memory_order_release);
+
+	++mNumRebalances;
+	mStepsSinceRebalance = 0;
+	mReferenceStepTime = 0;
+}
+
+void AdaptiveListScheduler::step(Real time, Int timeStepCount) {
+	mTime = time;
+	mTimeStepCount = timeStepCount;
+	++mStepIndex;
+
+	auto start = std::chrono::steady_clock::now();
+	mStartBarrier.wait(0);
+	doStep(0);
+	mEndBarrier.wait(0);
+	Real stepTime = std::chrono::duration<Real, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+	++mStepsSinceRebalance;
+	mStepTime = mStepsSinceRebalance == 1 ? stepTime : mSmoothing * stepTime + (1 - mSmoothing) * mStepTime;
+	if (mStepsSinceRebalance == mReferenceSteps)
+		mReferenceStepTime = mStepTime;
+
+	Bool intervalReached = mRebalanceInterval > 0 && mStepsSinceRebalance >= mRebalanceInterval;
+	Bool regression = mReferenceStepTime > 0 && mStepTime > (1 + mRegressionThreshold) * mReferenceStepTime;
+	if (intervalReached || regression) {
+		if (regression)
+			SPDLOG_LOGGER_DEBUG(mSLog, "Step time regressed from {} ns to {} ns", mReferenceStepTime, mStepTime);
+		rebalance();
+	}
+}
+
+void AdaptiveListScheduler::stop() {
+	if (!mThreads.empty()) {
+		joinThreads();
+		SPDLOG_LOGGER_INFO(mSLog, "Schedule rebuilt {} times", mNumRebalances);
+	}
+	if (!mOutMeasurementFile.empty()) {
+		writeMeasurements(mOutMeasurementFile);
+	}
+}
+
+void AdaptiveListScheduler::joinThreads() {
+	if (mThreads.empty())
+		return;
+	mJoining = true;
+	mStartBarrier.wait(0);
+	for (auto& thread : mThreads)
+		thread.join();
+	mThreads.clear();
+	mJoining = false;
+}
+
+void AdaptiveListScheduler::threadFunction(AdaptiveListScheduler* sched, Int idx) {
+	sched->applyThreadPlacement(idx);
+
+	while (true) {
+		sched->mStartBarrier.wait(idx);
+		if (sched->mJoining)
+			return;
+
+		sched->doStep(idx);
+		sched->mEndBarrier.wait(idx);
+	}
+}
+
+void AdaptiveListScheduler::doStep(Int thread) {
+	const Schedule& schedule = *mActiveSchedule.load(std::memory_order_acquire);
+
+	for (UInt task : schedule[thread]) {
+		for (UInt before : mPredecessors[task]) {
+			while (mStates[before].finishedStep.load(std::memory_order_acquire) != mStepIndex)
+				cpuRelax();
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		mTasks[task]->execute(mTime, mTimeStepCount);
+		auto end = std::chrono::steady_clock::now();
+
+		// Only the executing thread updates the estimate, the schedule is
+		// rebuilt after the end barrier
+		Real duration = std::chrono::duration<Real, std::nano>(end - start).count();
+		mStates[task].duration = mSmoothing * duration + (1 - mSmoothing) * mStates[task].duration;
+		if (!mOutMeasurementFile.empty())
+			updateMeasurement(mTasks[task], end - start);
+
+		mStates[task].finishedStep.store(mStepIndex, std::memory_order_release);
+	}
+}
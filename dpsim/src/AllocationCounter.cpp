@@ -0,0 +1,154 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/AllocationCounter.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <new>
+
+using namespace DPsim;
+
+#ifdef WITH_ALLOCATION_COUNTER
+
+static std::atomic<std::size_t> sAllocations(0);
+
+#ifdef __GLIBC__
+
+// Interpose the C allocation functions so that allocations of Eigen,
+// which bypasses operator new, are counted as well. The aligned variants
+// are used by aligned operator new and by libraries with SIMD buffers.
+extern "C" {
+	void* __libc_malloc(std::size_t size);
+	void* __libc_calloc(std::size_t num, std::size_t size);
+	void* __libc_realloc(void* ptr, std::size_t size);
+	void* __libc_memalign(std::size_t alignment, std::size_t size);
+	void* __libc_valloc(std::size_t size);
+	void* __libc_pvalloc(std::size_t size);
+
+	void* malloc(std::size_t size) noexcept {
+		sAllocations.fetch_add(1, std::memory_order_relaxed);
+		return __libc_malloc(size);
+	}
+
+	void* calloc(std::size_t num, std::size_t size) noexcept {
+		sAllocations.fetch_add(1, std::memory_order_relaxed);
+		return __libc_calloc(num, size);
+	}
+
+	void* realloc(void* ptr, std::size_t size) noexcept {
+		sAllocations.fetch_add(1, std::memory_order_relaxed);
+		return __libc_realloc(ptr, size);
+	}
+
+	void* memalign(std::size_t alignment, std::size_t size) noexcept {
+		sAllocations.fetch_add(1, std::memory_order_relaxed);
+		return __libc_memalign(alignment, size);
+	}
+
+	void* aligned_alloc(std::size_t alignment, std::size_t size) noexcept {
+		sAllocations.fetch_add(1, std::memory_order_relaxed);
+		return __libc_memalign(alignment, size);
+	}
+
+	int posix_memalign(void** ptr, std::size_t alignment, std::size_t size) noexcept {
+		// The alignment has to be a power of two multiple of sizeof(void*)
+		if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0)
+			return EINVAL;
+		sAllocations.fetch_add(1, std::memory_order_relaxed);
+		void* result = __libc_memalign(alignment, size);
+		if (!result)
+			return ENOMEM;
+		*ptr = result;
+		return 0;
+	}
+
+	void* valloc(std::size_t size) noexcept {
+		sAllocations.fetch_add(1, std::memory_order_relaxed);
+		return __libc_valloc(size);
+	}
+
+	void* pvalloc(std::size_t size) noexcept {
+		sAllocations.fetch_add(1, std::memory_order_relaxed);
+		return __libc_pvalloc(size);
+	}
+}
+
+#else
+
+void* operator new(std::size_t size) {
+	sAllocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* ptr = std::malloc(size ? size : 1))
+		return ptr;
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+	return ::operator new(size);
+}
+
+void operator delete(void* ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+	std::free(ptr);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+	sAllocations.fetch_add(1, std::memory_order_relaxed);
+	// The size passed to aligned_alloc has to be a multiple of the alignment
+	std::size_t align = static_cast<std::size_t>(alignment);
+	std::size_t alignedSize = size ? (size + align - 1) / align * align : align;
+	if (void* ptr = std::aligned_alloc(align, alignedSize))
+		return ptr;
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+	return ::operator new(size, alignment);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept {
+	std::free(ptr);
+}
+
+#endif
+
+std::size_t AllocationCounter::count() {
+	return sAllocations.load(std::memory_order_relaxed);
+}
+
+#else
+
+std::size_t AllocationCounter::count() {
+	return 0;
+}
+
+#endif
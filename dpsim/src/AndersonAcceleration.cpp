@@ -0,0 +1,143 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/AndersonAcceleration.h>
+
+#include <cmath>
+
+using namespace CPS;
+using namespace DPsim;
+
+/// The history is discarded if the residual grows by more than this factor
+static const Real RESTART_FACTOR = 2;
+
+void AndersonAcceleration::setAttributes(const std::vector<AttributeBase::Ptr>& attributes) {
+	mAttributes.clear();
+	Matrix::Index size = 0;
+	for (auto& attr : attributes) {
+		auto ptr = attr.getPtr();
+		StateAttribute state;
+		if ((state.real = std::dynamic_pointer_cast<Attribute<Real>>(ptr)))
+			size += 1;
+		else if ((state.complex = std::dynamic_pointer_cast<Attribute<Complex>>(ptr)))
+			size += 2;
+		else if ((state.matrix = std::dynamic_pointer_cast<Attribute<Matrix>>(ptr)))
+			size += state.matrix->get().size();
+		else if ((state.matrixComp = std::dynamic_pointer_cast<Attribute<MatrixComp>>(ptr)))
+			size += 2 * state.matrixComp->get().size();
+		else
+			continue;
+		mAttributes.push_back(state);
+	}
+
+	// All work storage is sized here, so the iterations only reallocate inside the least squares solver
+	mState = Matrix::Zero(size, 1);
+	mResult = Matrix::Zero(size, 1);
+	mResidual = Matrix::Zero(size, 1);
+	mPrevResult = Matrix::Zero(size, 1);
+	mPrevResidual = Matrix::Zero(size, 1);
+	mExtrapolated = Matrix::Zero(size, 1);
+	mGamma = Matrix::Zero(mDepth, 1);
+	mQR = Eigen::ColPivHouseholderQR<Matrix>(size, mDepth);
+	gather(mState);
+	reset();
+}
+
+void AndersonAcceleration::reset() {
+	mResultDiffs = Matrix::Zero(mState.rows(), mDepth);
+	mResidualDiffs = Matrix::Zero(mState.rows(), mDepth);
+	mNumDiffs = 0;
+	mNextDiff = 0;
+	mPrevResidualNorm = -1;
+}
+
+void AndersonAcceleration::update() {
+	if (mState.rows() == 0)
+		return;
+
+	gather(mResult);
+	mResidual = mResult - mState;
+	Real residualNorm = mResidual.norm();
+
+	// Restart if the extrapolation made things worse or produced invalid values
+	if (!std::isfinite(residualNorm) || (mPrevResidualNorm >= 0 && residualNorm > RESTART_FACTOR * mPrevResidualNorm)) {
+		mNumDiffs = 0;
+		mNextDiff = 0;
+		mPrevResidualNorm = -1;
+	}
+
+	if (mPrevResidualNorm >= 0 && mDepth > 0) {
+		mResultDiffs.col(mNextDiff) = mResult - mPrevResult;
+		mResidualDiffs.col(mNextDiff) = mResidual - mPrevResidual;
+		mNextDiff = (mNextDiff + 1) % mDepth;
+		if (mNumDiffs < mDepth)
+			++mNumDiffs;
+	}
+	mPrevResult = mResult;
+	mPrevResidual = mResidual;
+	mPrevResidualNorm = std::isfinite(residualNorm) ? residualNorm : -1;
+
+	mState = mResult;
+	if (mNumDiffs == 0)
+		return;
+
+	// Combination of the previous iterates minimizing the residual in the least squares sense
+	mQR.compute(mResidualDiffs.leftCols(mNumDiffs));
+	mGamma.topRows(mNumDiffs) = mQR.solve(mResidual);
+	mExtrapolated = mResult;
+	mExtrapolated.noalias() -= mResultDiffs.leftCols(mNumDiffs) * mGamma.topRows(mNumDiffs);
+	if (!mExtrapolated.allFinite())
+		return;
+
+	mState = mExtrapolated;
+	scatter(mState);
+}
+
+void AndersonAcceleration::gather(Matrix& state) const {
+	Matrix::Index idx = 0;
+	for (auto& attr : mAttributes) {
+		if (attr.real) {
+			state(idx++, 0) = attr.real->get();
+		} else if (attr.complex) {
+			state(idx++, 0) = attr.complex->get().real();
+			state(idx++, 0) = attr.complex->get().imag();
+		} else if (attr.matrix) {
+			const Matrix& value = attr.matrix->get();
+			for (Matrix::Index i = 0; i < value.size(); ++i)
+				state(idx++, 0) = value(i);
+		} else {
+			const MatrixComp& value = attr.matrixComp->get();
+			for (Matrix::Index i = 0; i < value.size(); ++i) {
+				state(idx++, 0) = value(i).real();
+				state(idx++, 0) = value(i).imag();
+			}
+		}
+	}
+}
+
+void AndersonAcceleration::scatter(const Matrix& state) {
+	Matrix::Index idx = 0;
+	for (auto& attr : mAttributes) {
+		if (attr.real) {
+			attr.real->get() = state(idx++, 0);
+		} else if (attr.complex) {
+			attr.complex->get() = Complex(state(idx, 0), state(idx + 1, 0));
+			idx += 2;
+		} else if (attr.matrix) {
+			Matrix& value = attr.matrix->get();
+			for (Matrix::Index i = 0; i < value.size(); ++i)
+				value(i) = state(idx++, 0);
+		} else {
+			MatrixComp& value = attr.matrixComp->get();
+			for (Matrix::Index i = 0; i < value.size(); ++i) {
+				value(i) = Complex(state(idx, 0), state(idx + 1, 0));
+				idx += 2;
+			}
+		}
+	}
+}
@@ -6,28 +6,53 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  *********************************************************************************/
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <iomanip>
+#include <limits>
 
 #include <dpsim/DataLogger.h>
 #include <dpsim-models/Logger.h>
 
 using namespace DPsim;
 
+namespace {
+	/// Convert a value to little-endian byte order in place
+	template<typename T>
+	void toLittleEndian(T& value) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+		auto bytes = reinterpret_cast<unsigned char*>(&value);
+		std::reverse(bytes, bytes + sizeof(T));
+#else
+		(void) value;
+#endif
+	}
+
+	template<typename T>
+	void writeLittleEndian(std::ofstream& file, T value) {
+		toLittleEndian(value);
+		file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+}
+
 DataLogger::DataLogger(Bool enabled) :
 	mLogFile(),
 	mEnabled(enabled),
-	mDownsampling(1) {
+	mDownsampling(1),
+	mFormat(Format::CSV) {
 	mLogFile.setstate(std::ios_base::badbit);
 }
 
-DataLogger::DataLogger(String name, Bool enabled, UInt downsampling) :
+DataLogger::DataLogger(String name, Bool enabled, UInt downsampling, Format format) :
 	mName(name),
 	mEnabled(enabled),
-	mDownsampling(downsampling) {
+	mDownsampling(downsampling),
+	mFormat(format) {
 	if (!mEnabled)
 		return;
 
-	mFilename = CPS::Logger::logDir() + "/" + name + ".csv";
+	mFilename = CPS::Logger::logDir() + "/" + name + (mFormat == Format::Binary ? ".bin" : ".csv");
 
 	if (mFilename.has_parent_path() && !fs::exists(mFilename.parent_path()))
 		fs::create_directory(mFilename.parent_path());
@@ -35,8 +60,21 @@ DataLogger::DataLogger(String name, Bool enabled, UInt downsampling) :
 	open();
 }
 
+DataLogger::~DataLogger() {
+	if (mLogFile.is_open())
+		close();
+}
+
 void DataLogger::open() {
-	mLogFile = std::ofstream(mFilename, std::ios_base::out|std::ios_base::trunc);
+	auto mode = std::ios_base::out|std::ios_base::trunc;
+	if (mFormat == Format::Binary)
+		mode |= std::ios_base::binary;
+
+	mLogFile = std::ofstream(mFilename, mode);
+	mNumColumns = 0;
+	mBufferFill = 0;
+	mDroppedRows = 0;
+	mStalledRows = 0;
 	if (!mLogFile.is_open()) {
 		// TODO: replace by exception
 		std::cerr << "Cannot open log file " << mFilename << std::endl;
@@ -45,23 +83,190 @@ void DataLogger::open() {
 }
 
 void DataLogger::close() {
+	stopWriter();
+	flushBuffer();
 	mLogFile.close();
+
+	if (mDroppedRows > 0)
+		std::cerr << "Dropped " << mDroppedRows << " rows of log " << mFilename << " because the writer thread fell behind" << std::endl;
+	if (mStalledRows > 0)
+		std::cerr << mStalledRows << " rows of log " << mFilename << " had to wait for the writer thread" << std::endl;
 }
 
 void DataLogger::setColumnNames(std::vector<String> names) {
-	if (mLogFile.tellp() == std::ofstream::pos_type(0)) {
+	if (mNumColumns == 0)
+		writeHeader(names);
+}
+
+void DataLogger::writeHeader(const std::vector<String>& names) {
+	mNumColumns = static_cast<UInt>(names.size()) + 1;
+
+	if (mFormat == Format::Binary) {
+		writeBinaryHeader(names);
+	} else {
 		mLogFile << std::right << std::setw(14) << "time";
 		for (auto name : names) {
 			mLogFile << ", " << std::right << std::setw(13) << name;
 		}
 		mLogFile << '\n';
 	}
+
+	if (mAsync)
+		startWriter();
+}
+
+void DataLogger::writeBinaryHeader(const std::vector<String>& names) {
+	const char magic[8] = { 'D', 'P', 'S', 'I', 'M', 'L', 'O', 'G' };
+	const std::uint32_t version = 1;
+
+	std::vector<String> columns { "time" };
+	columns.insert(columns.end(), names.begin(), names.end());
+
+	std::uint64_t headerSize = sizeof(magic) + 2 * sizeof(std::uint32_t) + sizeof(std::uint64_t);
+	for (auto& column : columns)
+		headerSize += sizeof(std::uint32_t) + column.size();
+	// Align the data to simplify memory mapping
+	const std::uint64_t alignment = 64;
+	std::uint64_t padding = (alignment - headerSize % alignment) % alignment;
+	headerSize += padding;
+
+	mLogFile.write(magic, sizeof(magic));
+	writeLittleEndian(mLogFile, version);
+	writeLittleEndian(mLogFile, static_cast<std::uint32_t>(mNumColumns));
+	writeLittleEndian(mLogFile, headerSize);
+	for (auto& column : columns) {
+		writeLittleEndian(mLogFile, static_cast<std::uint32_t>(column.size()));
+		mLogFile.write(column.data(), column.size());
+	}
+	for (std::uint64_t i = 0; i < padding; ++i)
+		mLogFile.put('\0');
+
+	// Keep at least one row in the buffer
+	std::size_t bufferRows = std::max<std::size_t>(BUFFER_SIZE / (sizeof(Real) * mNumColumns), 1);
+	mBuffer.resize(bufferRows * mNumColumns);
+	mBufferFill = 0;
+}
+
+Real* DataLogger::beginRow() {
+	if (!mAsync) {
+		if (mBufferFill + mNumColumns > mBuffer.size())
+			flushBuffer();
+		return mBuffer.data() + mBufferFill;
+	}
+
+	// The writer thread still uses the slot of the row that was put into the
+	// ring mAsyncCapacity rows ago
+	if (mRowsProduced - mRowsConsumed.load(std::memory_order_acquire) >= mAsyncCapacity) {
+		if (!mBlockOnFullQueue) {
+			++mDroppedRows;
+			return nullptr;
+		}
+		++mStalledRows;
+		while (mRowsProduced - mRowsConsumed.load(std::memory_order_acquire) >= mAsyncCapacity)
+			std::this_thread::yield();
+	}
+	return mRing.data() + (mRowsProduced % mAsyncCapacity) * mNumColumns;
+}
+
+void DataLogger::endRow() {
+	if (!mAsync) {
+		mBufferFill += mNumColumns;
+		return;
+	}
+
+	// The queue has been sized for all slots of the ring, so this does not allocate
+	mRowQueue->try_enqueue(mRowsProduced % mAsyncCapacity);
+	++mRowsProduced;
+}
+
+void DataLogger::logRow(Real time, const Real* data, Int size) {
+	// Columns are named by index if there was no header yet
+	if (mNumColumns == 0) {
+		std::vector<String> names;
+		for (Int i = 0; i < size; ++i)
+			names.push_back("value" + std::to_string(i));
+		writeHeader(names);
+	}
+
+	Real* row = beginRow();
+	if (!row)
+		return;
+
+	row[0] = time;
+	Int columns = std::min<Int>(size, mNumColumns - 1);
+	std::copy(data, data + columns, row + 1);
+	std::fill(row + columns + 1, row + mNumColumns, std::numeric_limits<Real>::quiet_NaN());
+	endRow();
+}
+
+void DataLogger::writeRow(const Real* row) {
+	if (mFormat == Format::Binary) {
+		if (mBufferFill + mNumColumns > mBuffer.size())
+			flushBuffer();
+		std::copy(row, row + mNumColumns, mBuffer.data() + mBufferFill);
+		mBufferFill += mNumColumns;
+		return;
+	}
+
+	mLogFile << std::scientific << std::right << std::setw(14) << row[0];
+	for (UInt i = 1; i < mNumColumns; ++i)
+		mLogFile << ", " << std::right << std::setw(13) << row[i];
+	mLogFile << '\n';
+}
+
+void DataLogger::flushBuffer() {
+	if (mBufferFill == 0)
+		return;
+
+	for (std::size_t i = 0; i < mBufferFill; ++i)
+		toLittleEndian(mBuffer[i]);
+	mLogFile.write(reinterpret_cast<const char*>(mBuffer.data()), mBufferFill * sizeof(Real));
+	mBufferFill = 0;
+}
+
+void DataLogger::startWriter() {
+	mRing.resize(static_cast<std::size_t>(mAsyncCapacity) * mNumColumns);
+	// One additional element for the stop signal
+	mRowQueue = std::make_unique<moodycamel::ReaderWriterQueue<std::size_t>>(mAsyncCapacity + 1);
+	mRowsProduced = 0;
+	mRowsConsumed = 0;
+
+	// The writer polls the queue, so that enqueuing a row never has to wake it up
+	mWriterThread = std::thread([this]() {
+		std::size_t slot = 0;
+		auto sleep = MIN_WRITER_SLEEP;
+		while (true) {
+			if (!mRowQueue->try_dequeue(slot)) {
+				std::this_thread::sleep_for(sleep);
+				sleep = std::min(2 * sleep, MAX_WRITER_SLEEP);
+				continue;
+			}
+			sleep = MIN_WRITER_SLEEP;
+			if (slot == STOP_WRITER)
+				break;
+			writeRow(mRing.data() + slot * mNumColumns);
+			mRowsConsumed.fetch_add(1, std::memory_order_release);
+		}
+	});
+}
+
+void DataLogger::stopWriter() {
+	if (!mWriterThread.joinable())
+		return;
+
+	mRowQueue->enqueue(STOP_WRITER);
+	mWriterThread.join();
 }
 
 void DataLogger::logDataLine(Real time, Real data) {
 	if (!mEnabled)
 		return;
 
+	if (useRows()) {
+		logRow(time, &data, 1);
+		return;
+	}
+
 	mLogFile << std::scientific << std::right << std::setw(14) << time;
 	mLogFile << ", " << std::right << std::setw(13) << data;
 	mLogFile << '\n';
@@ -71,6 +276,11 @@ void DataLogger::logDataLine(Real time, const Matrix& data) {
 	if (!mEnabled)
 		return;
 
+	if (useRows()) {
+		logRow(time, data.data(), static_cast<Int>(data.rows()));
+		return;
+	}
+
 	mLogFile << std::scientific << std::right << std::setw(14) << time;
 	for (Int i = 0; i < data.rows(); ++i) {
 		mLogFile << ", " << std::right << std::setw(13) << data(i, 0);
@@ -81,6 +291,12 @@ void DataLogger::logDataLine(Real time, const Matrix& data) {
 void DataLogger::logDataLine(Real time, const MatrixComp& data) {
 	if (!mEnabled)
 		return;
+
+	// Real and imaginary parts are written as separate columns
+	if (useRows()) {
+		logRow(time, reinterpret_cast<const Real*>(data.data()), 2 * static_cast<Int>(data.rows()));
+		return;
+	}
 	mLogFile << std::scientific << std::right << std::setw(14) << time;
 	for (Int i = 0; i < data.rows(); ++i) {
 		mLogFile << ", " << std::right << std::setw(13) << data(i, 0);
@@ -89,7 +305,7 @@ void DataLogger::logDataLine(Real time, const MatrixComp& data) {
 }
 
 void DataLogger::logPhasorNodeValues(Real time, const Matrix& data, Int freqNum) {
-	if (mLogFile.tellp() == std::ofstream::pos_type(0)) {
+	if (mNumColumns == 0) {
 		std::vector<String> names;
 
 		Int harmonicOffset = data.rows() / freqNum;
@@ -115,7 +331,7 @@ void DataLogger::logPhasorNodeValues(Real time, const Matrix& data, Int freqNum)
 }
 
 void DataLogger::logEMTNodeValues(Real time, const Matrix& data) {
-	if (mLogFile.tellp() == std::ofstream::pos_type(0)) {
+	if (mNumColumns == 0) {
 		std::vector<String> names;
 		for (Int i = 0; i < data.rows(); ++i) {
 			std::stringstream name;
@@ -131,19 +347,61 @@ void DataLogger::log(Real time, Int timeStepCount) {
 	if (!mEnabled || !(timeStepCount % mDownsampling == 0))
 		return;
 
-	if (mLogFile.tellp() == std::ofstream::pos_type(0)) {
+	if (useRows()) {
+		logAttributeRow(time);
+		return;
+	}
+
+	if (mNumColumns == 0) {
+		mNumColumns = static_cast<UInt>(mAttributes.size()) + 1;
 		mLogFile << std::right << std::setw(14) << "time";
 		for (auto it : mAttributes)
 			mLogFile << ", " << std::right << std::setw(13) << it.first;
 		mLogFile << '\n';
+		compileAccessPlan();
 	}
 
+	// Real columns are gathered through the access plan, all others are formatted by the attribute
+	mAccessPlan.gather(mPlanValues.data());
 	mLogFile << std::scientific << std::right << std::setw(14) << time;
-	for (auto it : mAttributes)
-		mLogFile << ", " << std::right << std::setw(13) << it.second->toString();
+	UInt column = 0;
+	for (const auto& it : mAttributes) {
+		mLogFile << ", " << std::right << std::setw(13)
+			<< (it.second->getType() == typeid(Real) ? std::to_string(mPlanValues[column]) : it.second->toString());
+		column++;
+	}
 	mLogFile << '\n';
 }
 
+void DataLogger::compileAccessPlan() {
+	mAccessPlan.clear();
+	for (const auto& it : mAttributes)
+		mAccessPlan.add(it.second);
+	mAccessPlan.compile();
+	mPlanValues.assign(mAttributes.size(), 0);
+}
+
+void DataLogger::logAttributeRow(Real time) {
+	if (mNumColumns == 0) {
+		std::vector<String> names;
+		for (const auto& it : mAttributes) {
+			names.push_back(it.first);
+			if (it.second->getType() != typeid(Real))
+				std::cerr << "Attribute " << it.first << " is not real and cannot be written to log " << mFilename << std::endl;
+		}
+		compileAccessPlan();
+		writeHeader(names);
+	}
+
+	Real* row = beginRow();
+	if (!row)
+		return;
+
+	row[0] = time;
+	mAccessPlan.gather(row + 1);
+	endRow();
+}
+
 void DataLogger::Step::execute(Real time, Int timeStepCount) {
 	mLogger.log(time, timeStepCount);
 }
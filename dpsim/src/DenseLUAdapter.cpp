@@ -41,4 +41,21 @@ namespace DPsim
     {
         return LUFactorized.solve(mRightHandSideVector);
     }
+
+    void DenseLUAdapter::solveInPlace(const Matrix& rightSideVector, Matrix& solution)
+    {
+		/* permutation and substitutions in the solution, without temporaries as long as
+		 * the solution is not the right hand side itself */
+        solution = LUFactorized.permutationP() * rightSideVector;
+        LUFactorized.matrixLU().triangularView<Eigen::UnitLower>().solveInPlace(solution);
+        LUFactorized.matrixLU().triangularView<Eigen::Upper>().solveInPlace(solution);
+    }
+
+    void DenseLUAdapter::solveBatch(Matrix& rightSideVectors)
+    {
+        mPermutationBuffer = LUFactorized.permutationP() * rightSideVectors;
+        rightSideVectors = mPermutationBuffer;
+        LUFactorized.matrixLU().triangularView<Eigen::UnitLower>().solveInPlace(rightSideVectors);
+        LUFactorized.matrixLU().triangularView<Eigen::Upper>().solveInPlace(rightSideVectors);
+    }
 }
@@ -32,3 +32,19 @@ void EventQueue::handleEvents(Real currentTime) {
 		}
 	}
 }
+
+std::vector<SwitchStateChange> EventQueue::getSwitchStateChanges() const {
+	std::vector<SwitchStateChange> changes;
+	auto events = mEvents;
+
+	while (!events.empty()) {
+		auto e = events.top();
+		if (auto swEvent = std::dynamic_pointer_cast<SwitchEvent>(e))
+			changes.push_back(swEvent->switchStateChange());
+		else if (auto swEvent3Ph = std::dynamic_pointer_cast<SwitchEvent3Ph>(e))
+			changes.push_back(swEvent3Ph->switchStateChange());
+		events.pop();
+	}
+
+	return changes;
+}
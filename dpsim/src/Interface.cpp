@@ -3,27 +3,92 @@
 #include <dpsim/Interface.h>
 #include <dpsim/InterfaceWorker.h>
 
+#include <algorithm>
+
 using namespace CPS;
 
 namespace DPsim {
 
     void Interface::open() {
         mInterfaceWorker->open();
+        initExportPool();
+        initImportBitmap();
         mOpened = true;
 
         if (!mImportAttrsDpsim.empty()) {
-            mInterfaceReaderThread = std::thread(Interface::ReaderThread(mQueueInterfaceToDpsim, mInterfaceWorker, mOpened));
+            mInterfaceReaderThread = std::thread(Interface::ReaderThread(mQueueInterfaceToDpsim, mQueueReturnedImportFrames, mInterfaceWorker, mOpened));
         }
         if (!mExportAttrsDpsim.empty()) {
-            mInterfaceWriterThread = std::thread(Interface::WriterThread(mQueueDpsimToInterface, mInterfaceWorker));
+            mInterfaceWriterThread = std::thread(Interface::WriterThread(mQueueDpsimToInterface, mQueueReturnedExportFrames, mQueueReturnedSlots,
+                mInterfaceWorker, mExportPoolSize, static_cast<UInt>(mExportAttrsDpsim.size())));
+        }
+    }
+
+    void Interface::initExportPool() {
+        UInt numSlots = mExportPoolSize * static_cast<UInt>(mExportAttrsDpsim.size());
+
+        mExportPool.assign(mExportAttrsDpsim.size(), {});
+        mExportPoolFree.assign(mExportAttrsDpsim.size(), {});
+        for (UInt i = 0; i < mExportAttrsDpsim.size(); i++) {
+            mExportPool[i].reserve(mExportPoolSize);
+            mExportPoolFree[i].reserve(mExportPoolSize);
+            for (UInt slot = 0; slot < mExportPoolSize; slot++) {
+                mExportPool[i].push_back(std::get<0>(mExportAttrsDpsim[i])->cloneValueOntoNewAttribute());
+                mExportPoolFree[i].push_back(mExportPoolSize - 1 - slot);
+            }
+        }
+
+        //Size all queues for the whole pool so that the export path does not have to grow them during the simulation
+        mQueueDpsimToInterface = std::make_shared<FrameQueue>(mExportPoolSize + 1);
+        mQueueReturnedExportFrames = std::make_shared<PacketListQueue>(mExportPoolSize);
+        mQueueReturnedSlots = std::make_shared<moodycamel::ReaderWriterQueue<PoolSlotRef>>(numSlots);
+
+        for (UInt frame = 0; frame < mExportPoolSize; frame++) {
+            PacketList packets;
+            packets.reserve(mExportAttrsDpsim.size());
+            mQueueReturnedExportFrames->enqueue(std::move(packets));
+        }
+    }
+
+    void Interface::initImportBitmap() {
+        mImportReceived.assign((mImportAttrsDpsim.size() + 63) / 64, 0);
+        mNumBlockingImports = 0;
+        mNumSyncImports = 0;
+        for (const auto& [_attr, _seqId, blockOnRead, syncOnStart] : mImportAttrsDpsim) {
+            if (blockOnRead)
+                mNumBlockingImports++;
+            if (syncOnStart)
+                mNumSyncImports++;
+        }
+    }
+
+    void Interface::reclaimExportSlots() {
+        if (!mQueueReturnedSlots)
+            return;
+
+        PoolSlotRef slotRef;
+        while (mQueueReturnedSlots->try_dequeue(slotRef)) {
+            mExportPoolFree[slotRef.first].push_back(slotRef.second);
+        }
+    }
+
+    void Interface::setExportPoolSize(UInt size) {
+        if (mOpened) {
+            SPDLOG_LOGGER_ERROR(mLog, "Cannot modify interface configuration after simulation start!");
+            std::exit(1);
         }
+
+        mExportPoolSize = size;
+    }
+
+    UInt Interface::exportQueueDepth() const {
+        return static_cast<UInt>(mQueueDpsimToInterface->size_approx());
     }
 
     void Interface::close() {
 	    mOpened = false;
-        mQueueDpsimToInterface->emplace(AttributePacket {
-            nullptr,
-            0,
+        mQueueDpsimToInterface->emplace(AttributeFrame {
+            {},
             0,
             AttributePacketFlags::PACKET_CLOSE_INTERFACE
         });
@@ -96,99 +161,170 @@ namespace DPsim {
     }
 
     void Interface::popDpsimAttrsFromQueue(bool isSync) {
-        AttributePacket receivedPacket = {
-            nullptr,
-            0,
-            0,
-            AttributePacketFlags::PACKET_NO_FLAGS
-        };
-        UInt currentSequenceId = mNextSequenceInterfaceToDpsim;
-
-        //Wait for and dequeue all attributes that read should block on
-        //The std::find_if will look for all attributes that have not been updated in the current while loop (i. e. whose sequence ID is lower than the next expected sequence ID)
-        while (std::find_if(
-                mImportAttrsDpsim.cbegin(),
-                mImportAttrsDpsim.cend(),
-                [currentSequenceId, isSync](auto attrTuple) {
-                    auto &[_attr, seqId, blockOnRead, syncOnStart] = attrTuple;
-                    if (isSync) {
-                        return syncOnStart && seqId < currentSequenceId;
-                    } else {
-                        return blockOnRead && seqId < currentSequenceId;
-                    }
-                }) != mImportAttrsDpsim.cend()) {
-            mQueueInterfaceToDpsim->wait_dequeue(receivedPacket);
-            if (!std::get<0>(mImportAttrsDpsim[receivedPacket.attributeId])->copyValue(receivedPacket.value)) {
-                SPDLOG_LOGGER_WARN(mLog, "Failed to copy received value onto attribute in Interface!");
-            }
-            std::get<1>(mImportAttrsDpsim[receivedPacket.attributeId]) = receivedPacket.sequenceId;
-            mNextSequenceInterfaceToDpsim = receivedPacket.sequenceId + 1;
+        AttributeFrame receivedFrame;
+        UInt pending = isSync ? mNumSyncImports : mNumBlockingImports;
+        std::fill(mImportReceived.begin(), mImportReceived.end(), 0);
+
+        //Wait for and dequeue frames until every attribute that read should block on has been updated once
+        while (pending > 0) {
+            mQueueInterfaceToDpsim->wait_dequeue(receivedFrame);
+            pending -= applyImportFrame(receivedFrame, isSync);
         }
 
-        //Fetch all remaining queue packets
-        while (mQueueInterfaceToDpsim->try_dequeue(receivedPacket)) {
-            if (!std::get<0>(mImportAttrsDpsim[receivedPacket.attributeId])->copyValue(receivedPacket.value)) {
+        //Fetch all remaining queue frames
+        while (mQueueInterfaceToDpsim->try_dequeue(receivedFrame)) {
+            applyImportFrame(receivedFrame, isSync);
+        }
+    }
+
+    UInt Interface::applyImportFrame(AttributeFrame& frame, bool isSync) {
+        UInt updated = 0;
+        for (const auto& packet : frame.packets) {
+            auto& [attr, seqId, blockOnRead, syncOnStart] = mImportAttrsDpsim[packet.attributeId];
+            if (!attr->copyValue(packet.value)) {
                 SPDLOG_LOGGER_WARN(mLog, "Failed to copy received value onto attribute in Interface!");
             }
-            std::get<1>(mImportAttrsDpsim[receivedPacket.attributeId]) = receivedPacket.sequenceId;
-            mNextSequenceInterfaceToDpsim = receivedPacket.sequenceId + 1;
+            seqId = packet.sequenceId;
+            mNextSequenceInterfaceToDpsim = packet.sequenceId + 1;
+
+            uint64_t& word = mImportReceived[packet.attributeId / 64];
+            uint64_t bit = uint64_t(1) << (packet.attributeId % 64);
+            if (!(word & bit)) {
+                word |= bit;
+                if (isSync ? syncOnStart : blockOnRead)
+                    updated++;
+            }
         }
+
+        //Hand the emptied packet list back to the reader thread
+        frame.packets.clear();
+        mQueueReturnedImportFrames->enqueue(std::move(frame.packets));
+        frame.packets = PacketList();
+        return updated;
     }
 
     void Interface::pushDpsimAttrsToQueue() {
+        reclaimExportSlots();
+
+        AttributeFrame frame {
+            {},
+            mCurrentFrameDpsimToInterface++,
+            AttributePacketFlags::PACKET_NO_FLAGS
+        };
+        if (!mQueueReturnedExportFrames->try_dequeue(frame.packets)) {
+            frame.packets.reserve(mExportAttrsDpsim.size());
+            mExportPoolExhaustions++;
+        }
+
         for (UInt i = 0; i < mExportAttrsDpsim.size(); i++) {
-            mQueueDpsimToInterface->emplace(AttributePacket {
-                std::get<0>(mExportAttrsDpsim[i])->cloneValueOntoNewAttribute(),
+            auto& attr = std::get<0>(mExportAttrsDpsim[i]);
+            CPS::AttributeBase::Ptr value;
+            UInt poolSlot = POOL_SLOT_NONE;
+
+            //Copy the value into a free pooled packet, only allocate if the writer thread still holds all of them
+            if (i < mExportPoolFree.size() && !mExportPoolFree[i].empty()) {
+                poolSlot = mExportPoolFree[i].back();
+                mExportPoolFree[i].pop_back();
+                value = mExportPool[i][poolSlot];
+                value->copyValue(attr);
+            } else {
+                value = attr->cloneValueOntoNewAttribute();
+                mExportPoolExhaustions++;
+            }
+
+            frame.packets.push_back(AttributePacket {
+                value,
                 i,
                 std::get<1>(mExportAttrsDpsim[i]),
-                AttributePacketFlags::PACKET_NO_FLAGS
+                AttributePacketFlags::PACKET_NO_FLAGS,
+                poolSlot
             });
             std::get<1>(mExportAttrsDpsim[i]) = mCurrentSequenceDpsimToInterface;
             mCurrentSequenceDpsimToInterface++;
         }
+
+        mQueueDpsimToInterface->enqueue(std::move(frame));
+        mMaxExportQueueDepth = std::max(mMaxExportQueueDepth, exportQueueDepth());
     }
 
     void Interface::WriterThread::operator() () const {
         bool interfaceClosed = false;
+        UInt capacity = mPoolSize * mNumAttributes;
         std::vector<Interface::AttributePacket> attrsToWrite;
-        while (!interfaceClosed) {
-            AttributePacket nextPacket = {
-                nullptr,
-                0,
-                0,
-                AttributePacketFlags::PACKET_NO_FLAGS
-            };
+        attrsToWrite.reserve(capacity);
+        //Pooled slots handed to the worker in the current call, and one bit per slot the worker kept in the list
+        std::vector<UInt> slotsPending;
+        slotsPending.reserve(capacity);
+        std::vector<uint64_t> slotsRetained((capacity + 63) / 64, 0);
 
-            //Wait for at least one packet
-            mQueueDpsimToInterface->wait_dequeue(nextPacket);
-            if (nextPacket.flags & AttributePacketFlags::PACKET_CLOSE_INTERFACE) {
+        auto takeFrame = [&](AttributeFrame& frame) {
+            if (frame.flags & AttributePacketFlags::PACKET_CLOSE_INTERFACE) {
                 interfaceClosed = true;
-            } else {
-                attrsToWrite.push_back(nextPacket);
+                return;
             }
+            attrsToWrite.insert(attrsToWrite.end(), frame.packets.cbegin(), frame.packets.cend());
+            frame.packets.clear();
+            mQueueReturnedFrames->enqueue(std::move(frame.packets));
+            frame.packets = PacketList();
+        };
 
-            //See if there are more packets
-            while(mQueueDpsimToInterface->try_dequeue(nextPacket)) {
-                if (nextPacket.flags & AttributePacketFlags::PACKET_CLOSE_INTERFACE) {
-                    interfaceClosed = true;
-                } else {
-                    attrsToWrite.push_back(nextPacket);
-                }
+        AttributeFrame nextFrame;
+        while (!interfaceClosed) {
+            //Wait for at least one frame
+            mQueueDpsimToInterface->wait_dequeue(nextFrame);
+            takeFrame(nextFrame);
+
+            //See if there are more frames
+            while (mQueueDpsimToInterface->try_dequeue(nextFrame)) {
+                takeFrame(nextFrame);
+            }
+
+            //The worker may keep packets for later calls, so only packets it dropped from the list can be returned to the pool
+            for (const auto& packet : attrsToWrite) {
+                if (packet.poolSlot != POOL_SLOT_NONE)
+                    slotsPending.push_back(packet.attributeId * mPoolSize + packet.poolSlot);
             }
             mInterfaceWorker->writeValuesToEnv(attrsToWrite);
+            for (const auto& packet : attrsToWrite) {
+                if (packet.poolSlot != POOL_SLOT_NONE) {
+                    UInt slot = packet.attributeId * mPoolSize + packet.poolSlot;
+                    slotsRetained[slot / 64] |= uint64_t(1) << (slot % 64);
+                }
+            }
+            for (UInt slot : slotsPending) {
+                uint64_t bit = uint64_t(1) << (slot % 64);
+                if (!(slotsRetained[slot / 64] & bit))
+                    mQueueReturnedSlots->enqueue(PoolSlotRef(slot / mPoolSize, slot % mPoolSize));
+            }
+            for (const auto& packet : attrsToWrite) {
+                if (packet.poolSlot != POOL_SLOT_NONE) {
+                    UInt slot = packet.attributeId * mPoolSize + packet.poolSlot;
+                    slotsRetained[slot / 64] &= ~(uint64_t(1) << (slot % 64));
+                }
+            }
+            slotsPending.clear();
         }
     }
 
     void Interface::ReaderThread::operator() () const {
-        std::vector<Interface::AttributePacket>  attrsRead;
+        PacketList attrsRead;
+        UInt frameSequence = 1;
         while (mOpened) {
+            //Reuse a packet list the dpsim-thread has already processed if there is one
+            if (attrsRead.capacity() == 0)
+                mQueueReturnedFrames->try_dequeue(attrsRead);
+
             mInterfaceWorker->readValuesFromEnv(attrsRead);
-            for (const auto &packet : attrsRead) {
-                mQueueInterfaceToDpsim->enqueue(packet);
-            }
-            attrsRead.clear();
+            if (attrsRead.empty())
+                continue;
+
+            mQueueInterfaceToDpsim->enqueue(AttributeFrame {
+                std::move(attrsRead),
+                frameSequence++,
+                AttributePacketFlags::PACKET_NO_FLAGS
+            });
+            attrsRead = PacketList();
         }
     }
 
 }
-
@@ -160,20 +160,23 @@ void KLUAdapter::partialRefactorize(SparseMatrix &systemMatrix,
 Matrix KLUAdapter::solve(Matrix &rightSideVector)
 {
     Matrix x = rightSideVector;
+    solveBatch(x);
+    return x;
+}
 
+void KLUAdapter::solveBatch(Matrix &rightSideVectors)
+{
     /* number of right hands sides
-     * usually one, KLU can handle multiple right hand sides */
-    Int rhsCols = Eigen::internal::convert_index<Int>(rightSideVector.cols());
+     * KLU processes multiple right hand sides in blocks */
+    Int rhsCols = Eigen::internal::convert_index<Int>(rightSideVectors.cols());
 
     /* leading dimension, also called "n" */
-    Int rhsRows = Eigen::internal::convert_index<Int>(rightSideVector.rows());
+    Int rhsRows = Eigen::internal::convert_index<Int>(rightSideVectors.rows());
 
 	/* tsolve refers to transpose solve. Input matrix is stored in compressed row format,
 	 * KLU operates on compressed column format. This way, the transpose of the matrix is factored.
 	 * This has to be taken into account only here during right-hand solving. */
-    klu_tsolve(mSymbolic, mNumeric, rhsRows, rhsCols, x.const_cast_derived().data(), &mCommon);
-
-    return x;
+    klu_tsolve(mSymbolic, mNumeric, rhsRows, rhsCols, rightSideVectors.data(), &mCommon);
 }
 
 void KLUAdapter::printMatrixMarket(SparseMatrix &matrix, int counter) const
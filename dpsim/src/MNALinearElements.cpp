@@ -0,0 +1,245 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <algorithm>
+#include <type_traits>
+
+#include <dpsim/MNALinearElements.h>
+#include <dpsim-models/SimPowerComp.h>
+
+using namespace DPsim;
+using namespace CPS;
+
+namespace DPsim {
+
+template <typename VarType>
+Bool MnaLinearElements<VarType>::add(MNAInterface::Ptr comp) {
+	auto linearComp = std::dynamic_pointer_cast<MNALinearElementInterface<VarType>>(comp);
+	auto powerComp = std::dynamic_pointer_cast<SimPowerComp<VarType>>(comp);
+	if (!linearComp || !powerComp || contains(comp))
+		return false;
+
+	if (!linearComp->mnaLinearPhases(mPhases))
+		return false;
+
+	mComponents.push_back(comp);
+	mComponentSet.insert(comp.get());
+	mInterfaceAttributes.push_back(powerComp->mIntfVoltage);
+	mInterfaceAttributes.push_back(powerComp->mIntfCurrent);
+	return true;
+}
+
+template <typename VarType>
+void MnaLinearElements<VarType>::clear() {
+	mComponents.clear();
+	mComponentSet.clear();
+	mInterfaceAttributes.clear();
+	mPhases.clear();
+	mNodes0.clear();
+	mNodes1.clear();
+}
+
+template <typename VarType>
+void MnaLinearElements<VarType>::initialize(Matrix::Index rows) {
+	constexpr Bool isComplex = std::is_same<VarType, Complex>::value;
+	std::size_t size = mPhases.size();
+
+	mCondRe.resize(size); mVoltFacRe.resize(size); mCurrFacRe.resize(size);
+	mVoltRe.resize(size); mCurrRe.resize(size); mEquivCurrRe.assign(size, 0.);
+	if constexpr (isComplex) {
+		mCondIm.resize(size); mVoltFacIm.resize(size); mCurrFacIm.resize(size);
+		mVoltIm.resize(size); mCurrIm.resize(size); mEquivCurrIm.assign(size, 0.);
+	}
+	mNodes0.resize(size); mNodes1.resize(size);
+	mVoltPtrs.resize(size); mCurrPtrs.resize(size);
+
+	for (std::size_t k = 0; k < size; ++k) {
+		const LinearPhase& phase = mPhases[k];
+		mCondRe[k] = std::real(phase.conductance);
+		mVoltFacRe[k] = std::real(phase.voltageFactor);
+		mCurrFacRe[k] = std::real(phase.currentFactor);
+		mVoltRe[k] = std::real(*phase.voltage);
+		mCurrRe[k] = std::real(*phase.current);
+		if constexpr (isComplex) {
+			mCondIm[k] = std::imag(phase.conductance);
+			mVoltFacIm[k] = std::imag(phase.voltageFactor);
+			mCurrFacIm[k] = std::imag(phase.currentFactor);
+			mVoltIm[k] = std::imag(*phase.voltage);
+			mCurrIm[k] = std::imag(*phase.current);
+		}
+		mNodes0[k] = phase.node0;
+		mNodes1[k] = phase.node1;
+		mVoltPtrs[k] = phase.voltage;
+		mCurrPtrs[k] = phase.current;
+	}
+	mPhases.clear();
+
+	// Same layout as used by Math::setVectorElement for a single frequency
+	mComplexOffset = isComplex ? rows / 2 : 0;
+
+	mRightVectorIndices.clear();
+	for (std::size_t k = 0; k < size; ++k) {
+		for (Int node : { mNodes0[k], mNodes1[k] }) {
+			if (node < 0)
+				continue;
+			mRightVectorIndices.push_back(static_cast<UInt>(node));
+			if constexpr (isComplex)
+				mRightVectorIndices.push_back(static_cast<UInt>(node + mComplexOffset));
+		}
+	}
+	std::sort(mRightVectorIndices.begin(), mRightVectorIndices.end());
+	mRightVectorIndices.erase(std::unique(mRightVectorIndices.begin(), mRightVectorIndices.end()), mRightVectorIndices.end());
+
+	mRightVector = AttributeStatic<Matrix>::make(Matrix::Zero(rows, 1));
+}
+
+template <typename VarType>
+void MnaLinearElements<VarType>::readInterfaceValues() {
+	for (std::size_t k = 0; k < mNodes0.size(); ++k) {
+		mVoltRe[k] = std::real(*mVoltPtrs[k]);
+		mCurrRe[k] = std::real(*mCurrPtrs[k]);
+		if constexpr (std::is_same<VarType, Complex>::value) {
+			mVoltIm[k] = std::imag(*mVoltPtrs[k]);
+			mCurrIm[k] = std::imag(*mCurrPtrs[k]);
+		}
+	}
+}
+
+template <typename VarType>
+void MnaLinearElements<VarType>::updateCoefficients() {
+	// The components report their phases in the same order as when they were added
+	std::vector<LinearPhase> phases;
+	for (auto& comp : mComponents)
+		std::dynamic_pointer_cast<MNALinearElementInterface<VarType>>(comp)->mnaLinearPhases(phases);
+
+	for (std::size_t k = 0; k < phases.size(); ++k) {
+		mCondRe[k] = std::real(phases[k].conductance);
+		mVoltFacRe[k] = std::real(phases[k].voltageFactor);
+		mCurrFacRe[k] = std::real(phases[k].currentFactor);
+		if constexpr (std::is_same<VarType, Complex>::value) {
+			mCondIm[k] = std::imag(phases[k].conductance);
+			mVoltFacIm[k] = std::imag(phases[k].voltageFactor);
+			mCurrFacIm[k] = std::imag(phases[k].currentFactor);
+		}
+	}
+}
+
+template <typename VarType>
+void MnaLinearElements<VarType>::preStep() {
+	constexpr Bool isComplex = std::is_same<VarType, Complex>::value;
+	const std::size_t size = mNodes0.size();
+
+	// History currents J = a v + b i
+	if constexpr (isComplex) {
+		for (std::size_t k = 0; k < size; ++k) {
+			mEquivCurrRe[k] = mVoltFacRe[k] * mVoltRe[k] - mVoltFacIm[k] * mVoltIm[k]
+				+ mCurrFacRe[k] * mCurrRe[k] - mCurrFacIm[k] * mCurrIm[k];
+			mEquivCurrIm[k] = mVoltFacRe[k] * mVoltIm[k] + mVoltFacIm[k] * mVoltRe[k]
+				+ mCurrFacRe[k] * mCurrIm[k] + mCurrFacIm[k] * mCurrRe[k];
+		}
+	} else {
+		for (std::size_t k = 0; k < size; ++k)
+			mEquivCurrRe[k] = mVoltFacRe[k] * mVoltRe[k] + mCurrFacRe[k] * mCurrRe[k];
+	}
+
+	// Several elements can share a node, so the stamps are accumulated
+	Matrix& rightVector = **mRightVector;
+	for (auto idx : mRightVectorIndices)
+		rightVector(idx, 0) = 0.;
+
+	for (std::size_t k = 0; k < size; ++k) {
+		if (mNodes0[k] >= 0) {
+			rightVector(mNodes0[k], 0) += mEquivCurrRe[k];
+			if constexpr (isComplex)
+				rightVector(mNodes0[k] + mComplexOffset, 0) += mEquivCurrIm[k];
+		}
+		if (mNodes1[k] >= 0) {
+			rightVector(mNodes1[k], 0) -= mEquivCurrRe[k];
+			if constexpr (isComplex)
+				rightVector(mNodes1[k] + mComplexOffset, 0) -= mEquivCurrIm[k];
+		}
+	}
+}
+
+template <typename VarType>
+void MnaLinearElements<VarType>::postStep(const Matrix& leftVector) {
+	constexpr Bool isComplex = std::is_same<VarType, Complex>::value;
+	const std::size_t size = mNodes0.size();
+
+	// Voltages v = x(node 1) - x(node 0)
+	for (std::size_t k = 0; k < size; ++k) {
+		Real re = 0., im = 0.;
+		if (mNodes1[k] >= 0) {
+			re = leftVector(mNodes1[k], 0);
+			if constexpr (isComplex)
+				im = leftVector(mNodes1[k] + mComplexOffset, 0);
+		}
+		if (mNodes0[k] >= 0) {
+			re -= leftVector(mNodes0[k], 0);
+			if constexpr (isComplex)
+				im -= leftVector(mNodes0[k] + mComplexOffset, 0);
+		}
+		mVoltRe[k] = re;
+		if constexpr (isComplex)
+			mVoltIm[k] = im;
+	}
+
+	// Currents i = G v + J
+	if constexpr (isComplex) {
+		for (std::size_t k = 0; k < size; ++k) {
+			mCurrRe[k] = mCondRe[k] * mVoltRe[k] - mCondIm[k] * mVoltIm[k] + mEquivCurrRe[k];
+			mCurrIm[k] = mCondRe[k] * mVoltIm[k] + mCondIm[k] * mVoltRe[k] + mEquivCurrIm[k];
+		}
+	} else {
+		for (std::size_t k = 0; k < size; ++k)
+			mCurrRe[k] = mCondRe[k] * mVoltRe[k] + mEquivCurrRe[k];
+	}
+
+	// Write back to the interface attributes of the components
+	for (std::size_t k = 0; k < size; ++k) {
+		if constexpr (isComplex) {
+			*mVoltPtrs[k] = Complex(mVoltRe[k], mVoltIm[k]);
+			*mCurrPtrs[k] = Complex(mCurrRe[k], mCurrIm[k]);
+		} else {
+			*mVoltPtrs[k] = mVoltRe[k];
+			*mCurrPtrs[k] = mCurrRe[k];
+		}
+	}
+}
+
+template <typename VarType>
+Task::List MnaLinearElements<VarType>::getTasks(Attribute<Matrix>::Ptr leftVector) {
+	if (mComponents.empty())
+		return Task::List();
+
+	return Task::List({
+		std::make_shared<PreStep>(*this),
+		std::make_shared<PostStep>(*this, leftVector)
+	});
+}
+
+template <typename VarType>
+MnaLinearElements<VarType>::PreStep::PreStep(MnaLinearElements<VarType>& elements) :
+	Task(elements.mName + ".LinearElements.MnaPreStep"), mElements(elements) {
+	for (auto& attr : elements.mInterfaceAttributes)
+		mPrevStepDependencies.push_back(attr);
+	mModifiedAttributes.push_back(elements.mRightVector);
+}
+
+template <typename VarType>
+MnaLinearElements<VarType>::PostStep::PostStep(MnaLinearElements<VarType>& elements, Attribute<Matrix>::Ptr leftVector) :
+	Task(elements.mName + ".LinearElements.MnaPostStep"), mElements(elements), mLeftVector(leftVector) {
+	mAttributeDependencies.push_back(leftVector);
+	for (auto& attr : elements.mInterfaceAttributes)
+		mModifiedAttributes.push_back(attr);
+}
+
+}
+
+template class DPsim::MnaLinearElements<Real>;
+template class DPsim::MnaLinearElements<Complex>;
@@ -9,6 +9,8 @@
 
 #include <dpsim/MNASolver.h>
 #include <dpsim/SequentialScheduler.h>
+#include <dpsim/AndersonAcceleration.h>
+#include <algorithm>
 #include <memory>
 
 using namespace DPsim;
@@ -19,7 +21,10 @@ namespace DPsim {
 
 template <typename VarType>
 MnaSolver<VarType>::MnaSolver(String name, CPS::Domain domain, CPS::Logger::Level logLevel) :
-	Solver(name, logLevel), mDomain(domain) {
+	Solver(name, logLevel), mDomain(domain),
+	mLinearElements(name),
+	mScenarioRightSideOffsets(AttributeStatic<Matrix>::make()),
+	mScenarioLeftSideVectors(AttributeStatic<Matrix>::make()) {
 
 	// Raw source and solution vector logging
 	mLeftVectorLog = std::make_shared<DataLogger>(name + "_LeftVector", logLevel == CPS::Logger::Level::trace);
@@ -41,6 +46,10 @@ void MnaSolver<VarType>::initialize() {
 	// Best case we have some kind of sub-attributes for attribute vectors / tensor attributes...
 	if (mFrequencyParallel) {
 		SPDLOG_LOGGER_INFO(mSLog, "Computing network harmonics in parallel.");
+		if (mLazySwitchFactorization) {
+			SPDLOG_LOGGER_WARN(mSLog, "Lazy switch factorization is not supported with parallel frequencies, all switch states are factorized up front.");
+			mLazySwitchFactorization = false;
+		}
 		for(Int freq = 0; freq < mSystem.mFrequencies.size(); ++freq) {
 			mLeftSideVectorHarm.push_back(AttributeStatic<Matrix>::make());
 		}
@@ -66,6 +75,8 @@ void MnaSolver<VarType>::initialize() {
 
 	SPDLOG_LOGGER_INFO(mSLog, "-- Create empty MNA system matrices and vectors");
 	createEmptyVectors();
+	if (mNumScenarios > 0 && !mFrequencyParallel)
+		createEmptyScenarioVectors();
 	createEmptySystemMatrix();
 
 	// Initialize components from powerflow solution and
@@ -118,16 +129,7 @@ void MnaSolver<Real>::initializeComponents() {
 		comp->initialize(mSystem.mSystemOmega, mTimeStep);
 
 	// Initialize MNA specific parts of components.
-	for (auto comp : allMNAComps) {
-		comp->mnaInitialize(mSystem.mSystemOmega, mTimeStep, mLeftSideVector);
-		const Matrix& stamp = comp->getRightVector()->get();
-		if (stamp.size() != 0) {
-			mRightVectorStamps.push_back(&stamp);
-		}
-	}
-
-	for (auto comp : mMNAIntfSwitches)
-		comp->mnaInitialize(mSystem.mSystemOmega, mTimeStep, mLeftSideVector);
+	initializeMNAComponents(mTimeStep);
 }
 
 template <>
@@ -156,9 +158,14 @@ void MnaSolver<Complex>::initializeComponents() {
 		// Initialize MNA specific parts of components.
 		for (auto comp : mMNAComponents) {
 			// Initialize MNA specific parts of components.
+			// The stamps of all frequencies are kept dense, the sparse summation
+			// only gathers them at the right vector indices
 			comp->mnaInitializeHarm(mSystem.mSystemOmega, mTimeStep, mLeftSideVectorHarm);
 			const Matrix& stamp = comp->getRightVector()->get();
-			if (stamp.size() != 0) mRightVectorStamps.push_back(&stamp);
+			if (stamp.size() != 0) {
+				mRightVectorStamps.push_back(&stamp);
+				mRightVectorStampIndices.push_back(&comp->getRightVectorIndices());
+			}
 		}
 		// Initialize nodes
 		for (UInt nodeIdx = 0; nodeIdx < mNodes.size(); ++nodeIdx) {
@@ -167,17 +174,88 @@ void MnaSolver<Complex>::initializeComponents() {
 	}
 	else {
 		// Initialize MNA specific parts of components.
-		for (auto comp : allMNAComps) {
-			comp->mnaInitialize(mSystem.mSystemOmega, mTimeStep, mLeftSideVector);
-			const Matrix& stamp = comp->getRightVector()->get();
-			if (stamp.size() != 0) {
-				mRightVectorStamps.push_back(&stamp);
-			}
+		initializeMNAComponents(mTimeStep);
+	}
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::initializeMNAComponents(Real timeStep) {
+	CPS::MNAInterface::List allMNAComps;
+	allMNAComps.insert(allMNAComps.end(), mMNAComponents.begin(), mMNAComponents.end());
+	allMNAComps.insert(allMNAComps.end(), mMNAIntfVariableComps.begin(), mMNAIntfVariableComps.end());
+
+	for (auto comp : allMNAComps) {
+		comp->mnaInitialize(mSystem.mSystemOmega, timeStep, mLeftSideVector);
+		comp->mnaSetSparseRightVectorStamping(mSparseRightVectorStamping);
+		if (mVectorizeLinearElements && mLinearElements.add(comp))
+			continue;
+		const Matrix& stamp = comp->getRightVector()->get();
+		if (stamp.size() == 0)
+			continue;
+		if (comp->hasCompactRightVector()) {
+			mCompactRightVectorStamps.push_back(&comp->getCompactRightVector()->get());
+			mCompactRightVectorStampIndices.push_back(&comp->getRightVectorIndices());
+		} else {
+			mRightVectorStamps.push_back(&stamp);
+			mRightVectorStampIndices.push_back(&comp->getRightVectorIndices());
 		}
+	}
+
+	initializeLinearElements();
+
+	// Switches that are variable components have been initialized above, initializing
+	// them again would reset their right vector mode after it was registered
+	for (auto comp : mMNAIntfSwitches) {
+		if (std::find(mMNAIntfVariableComps.begin(), mMNAIntfVariableComps.end(), comp) == mMNAIntfVariableComps.end())
+			comp->mnaInitialize(mSystem.mSystemOmega, timeStep, mLeftSideVector);
+	}
+}
+
+template <typename VarType>
+Bool MnaSolver<VarType>::updateMNAComponentsTimeStep(Real timeStep) {
+	CPS::MNAInterface::List allMNAComps;
+	allMNAComps.insert(allMNAComps.end(), mMNAComponents.begin(), mMNAComponents.end());
+	allMNAComps.insert(allMNAComps.end(), mMNAIntfVariableComps.begin(), mMNAIntfVariableComps.end());
+	allMNAComps.insert(allMNAComps.end(), mMNAIntfSwitches.begin(), mMNAIntfSwitches.end());
+
+	Bool supported = true;
+	for (auto comp : allMNAComps) {
+		if (!comp->mnaUpdateTimeStep(mSystem.mSystemOmega, timeStep)) {
+			auto idObj = std::dynamic_pointer_cast<IdentifiedObject>(comp);
+			SPDLOG_LOGGER_WARN(mSLog, "Component {} does not support a change of the time step", idObj ? idObj->name() : "");
+			supported = false;
+		}
+	}
+	mLinearElements.updateCoefficients();
+	return supported;
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::initializeLinearElements() {
+	if (mLinearElements.numComponents() == 0)
+		return;
+
+	mLinearElements.initialize(mRightSideVector.rows());
+	mRightVectorStamps.push_back(&mLinearElements.getRightVector()->get());
+	mRightVectorStampIndices.push_back(&mLinearElements.getRightVectorIndices());
+
+	SPDLOG_LOGGER_INFO(mSLog, "-- Update {:d} linear elements with {:d} phases in bulk",
+		mLinearElements.numComponents(), mLinearElements.size());
+}
 
-		for (auto comp : mMNAIntfSwitches)
-			comp->mnaInitialize(mSystem.mSystemOmega, mTimeStep, mLeftSideVector);
+template <typename VarType>
+Task::List MnaSolver<VarType>::mnaComponentTasks() {
+	Task::List l;
+
+	for (auto comp : mMNAComponents) {
+		if (mLinearElements.contains(comp))
+			continue;
+		for (auto task : comp->mnaTasks())
+			l.push_back(task);
 	}
+	for (auto task : mLinearElements.getTasks(mLeftSideVector))
+		l.push_back(task);
+	return l;
 }
 
 template <typename VarType>
@@ -221,17 +299,22 @@ void MnaSolver<VarType>::initializeSystemWithParallelFrequencies() {
 
 template <typename VarType>
 void MnaSolver<VarType>::initializeSystemWithPrecomputedMatrices() {
-	// iterate over all possible switch state combinations
-	for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++) {
-		switchedMatrixEmpty(i);
-	}
-
-	if (mSwitches.size() < 1) {
+	if (mLazySwitchFactorization) {
+		// Only the initial switch state is factorized here, other combinations
+		// are factorized by the solver implementation when they first occur
+		if (mSwitches.size() > 0)
+			updateSwitchStatus();
+		switchedMatrixEmpty(mCurrentSwitchStatus.to_ullong());
+		switchedMatrixStamp(mCurrentSwitchStatus.to_ullong(), mMNAComponents);
+	}
+	else if (mSwitches.size() < 1) {
+		switchedMatrixEmpty(0);
 		switchedMatrixStamp(0, mMNAComponents);
 	}
 	else {
 		// Generate switching state dependent system matrices
 		for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++) {
+			switchedMatrixEmpty(i);
 			switchedMatrixStamp(i, mMNAComponents);
 		}
 		updateSwitchStatus();
@@ -291,6 +374,46 @@ Bool MnaSolver<VarType>::hasVariableComponentChanged() {
 	return false;
 }
 
+template <typename VarType>
+void MnaSolver<VarType>::sumRightVectorStamps() {
+	mRightSideVector.setZero();
+
+	for (std::size_t i = 0; i < mCompactRightVectorStamps.size(); ++i) {
+		const Matrix& stamp = *mCompactRightVectorStamps[i];
+		const std::vector<UInt>& indices = *mCompactRightVectorStampIndices[i];
+		for (std::size_t k = 0; k < indices.size(); ++k)
+			mRightSideVector(indices[k], 0) += stamp(k, 0);
+	}
+
+	if (mSparseRightVectorStamping) {
+		// Gather only the entries each dense contribution declared during initialization
+		for (std::size_t i = 0; i < mRightVectorStamps.size(); ++i) {
+			const Matrix& stamp = *mRightVectorStamps[i];
+			for (auto idx : *mRightVectorStampIndices[i])
+				mRightSideVector(idx, 0) += stamp(idx, 0);
+		}
+	} else {
+		for (auto stamp : mRightVectorStamps)
+			mRightSideVector += *stamp;
+	}
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::sumRightVectorStampsHarm(Int freqIdx) {
+	mRightSideVectorHarm[freqIdx].setZero();
+
+	if (mSparseRightVectorStamping) {
+		for (std::size_t i = 0; i < mRightVectorStamps.size(); ++i) {
+			const Matrix& stamp = *mRightVectorStamps[i];
+			for (auto idx : *mRightVectorStampIndices[i])
+				mRightSideVectorHarm[freqIdx](idx, 0) += stamp(idx, freqIdx);
+		}
+	} else {
+		for (auto stamp : mRightVectorStamps)
+			mRightSideVectorHarm[freqIdx] += stamp->col(freqIdx);
+	}
+}
+
 template <typename VarType>
 void MnaSolver<VarType>::updateSwitchStatus() {
 	for (UInt i = 0; i < mSwitches.size(); ++i) {
@@ -390,6 +513,16 @@ void MnaSolver<Complex>::createEmptyVectors() {
 	}
 }
 
+template <typename VarType>
+void MnaSolver<VarType>::createEmptyScenarioVectors() {
+	SPDLOG_LOGGER_INFO(mSLog, "Number of scenarios solved with nominal system: {:d}", mNumScenarios);
+	// Keep offsets that have been set before the initialization if they fit
+	if ((**mScenarioRightSideOffsets).rows() != mRightSideVector.rows() || (**mScenarioRightSideOffsets).cols() != mNumScenarios)
+		**mScenarioRightSideOffsets = Matrix::Zero(mRightSideVector.rows(), mNumScenarios);
+	**mScenarioLeftSideVectors = Matrix::Zero(mRightSideVector.rows(), mNumScenarios);
+	mScenarioBatch = Matrix::Zero(mRightSideVector.rows(), mNumScenarios + 1);
+}
+
 template <typename VarType>
 void MnaSolver<VarType>::collectVirtualNodes() {
 	// We have not added virtual nodes yet so the list has only network nodes
@@ -447,20 +580,26 @@ template <typename VarType>
 void MnaSolver<VarType>::steadyStateInitialization() {
 	SPDLOG_LOGGER_INFO(mSLog, "--- Run steady-state initialization ---");
 
-	DataLogger initLeftVectorLog(mName + "_InitLeftVector", mLogLevel != CPS::Logger::Level::off);
-	DataLogger initRightVectorLog(mName + "_InitRightVector", mLogLevel != CPS::Logger::Level::off);
+	DataLogger initLeftVectorLog(mName + "_InitLeftVector", mSteadStIniLogging && mLogLevel != CPS::Logger::Level::off);
+	DataLogger initRightVectorLog(mName + "_InitRightVector", mSteadStIniLogging && mLogLevel != CPS::Logger::Level::off);
 
 	TopologicalPowerComp::Behaviour initBehaviourPowerComps = TopologicalPowerComp::Behaviour::Initialization;
 	SimSignalComp::Behaviour initBehaviourSignalComps = SimSignalComp::Behaviour::Initialization;
 
-	// TODO: enable use of timestep distinct from simulation timestep
-	Real initTimeStep = mTimeStep;
+	Real initTimeStep = mSteadStIniTimeStep > 0 ? mSteadStIniTimeStep : mTimeStep;
+
+	// Only the coefficients of the companion models depend on the time step,
+	// the states of the components from the power flow initialization are kept
+	if (initTimeStep != mTimeStep && !updateMNAComponentsTimeStep(initTimeStep)) {
+		SPDLOG_LOGGER_WARN(mSLog, "Use the simulation time step for steady-state initialization");
+		updateMNAComponentsTimeStep(mTimeStep);
+		initTimeStep = mTimeStep;
+	}
 
 	Int timeStepCount = 0;
 	Real time = 0;
 	Real maxDiff = 1.0;
 	Real max = 1.0;
-	Matrix diff = Matrix::Zero(2 * mNumNodes, 1);
 	Matrix prevLeftSideVector = Matrix::Zero(2 * mNumNodes, 1);
 
 	SPDLOG_LOGGER_INFO(mSLog, "Time step is {:f}s for steady-state initialization", initTimeStep);
@@ -485,11 +624,8 @@ void MnaSolver<VarType>::steadyStateInitialization() {
 		for (auto task : node->mnaTasks())
 			tasks.push_back(task);
 	}
-	for (auto comp : mMNAComponents) {
-		for (auto task : comp->mnaTasks()) {
-			tasks.push_back(task);
-		}
-	}
+	for (auto task : mnaComponentTasks())
+		tasks.push_back(task);
 	// TODO signal components should be moved out of MNA solver
 	for (auto comp : mSimSignalComps) {
 		for (auto task : comp->getTasks()) {
@@ -501,19 +637,42 @@ void MnaSolver<VarType>::steadyStateInitialization() {
 	sched.resolveDeps(tasks, inEdges, outEdges);
 	sched.createSchedule(tasks, inEdges, outEdges);
 
+	// The values carried over from one step to the next are the state of the iteration
+	AndersonAcceleration acceleration(mSteadStIniAccelerationDepth);
+	if (mSteadStIniAcceleration) {
+		std::vector<CPS::AttributeBase::Ptr> states;
+		for (auto& task : tasks) {
+			for (auto& attr : task->getPrevStepDependencies()) {
+				auto it = std::find_if(states.begin(), states.end(),
+					[&attr](const CPS::AttributeBase::Ptr& other) { return other.getPtr() == attr.getPtr(); });
+				if (it == states.end())
+					states.push_back(attr);
+			}
+		}
+		acceleration.setAttributes(states);
+		SPDLOG_LOGGER_INFO(mSLog, "Accelerate steady-state initialization with {:d} state variables", acceleration.size());
+	}
+
 	while (time < mSteadStIniTimeLimit) {
 		// Reset source vector
 		mRightSideVector.setZero();
 
 		sched.step(time, timeStepCount);
 
-		if (mDomain == CPS::Domain::EMT) {
-			initLeftVectorLog.logEMTNodeValues(time, leftSideVector());
-			initRightVectorLog.logEMTNodeValues(time, rightSideVector());
+		if (mSteadStIniAcceleration) {
+			acceleration.update();
+			mLinearElements.readInterfaceValues();
 		}
-		else {
-			initLeftVectorLog.logPhasorNodeValues(time, leftSideVector());
-			initRightVectorLog.logPhasorNodeValues(time, rightSideVector());
+
+		if (mSteadStIniLogging) {
+			if (mDomain == CPS::Domain::EMT) {
+				initLeftVectorLog.logEMTNodeValues(time, leftSideVector());
+				initRightVectorLog.logEMTNodeValues(time, rightSideVector());
+			}
+			else {
+				initLeftVectorLog.logPhasorNodeValues(time, leftSideVector());
+				initRightVectorLog.logPhasorNodeValues(time, rightSideVector());
+			}
 		}
 
 		// Calculate new simulation time
@@ -521,16 +680,18 @@ void MnaSolver<VarType>::steadyStateInitialization() {
 		++timeStepCount;
 
 		// Calculate difference
-		diff = prevLeftSideVector - **mLeftSideVector;
+		maxDiff = (prevLeftSideVector - **mLeftSideVector).lpNorm<Eigen::Infinity>();
 		prevLeftSideVector = **mLeftSideVector;
-		maxDiff = diff.lpNorm<Eigen::Infinity>();
 		max = (**mLeftSideVector).lpNorm<Eigen::Infinity>();
 		// If difference is smaller than some epsilon, break
 		if ((maxDiff / max) < mSteadStIniAccLimit)
 			break;
 	}
 
-	SPDLOG_LOGGER_INFO(mSLog, "Max difference: {:f} or {:f}% at time {:f}", maxDiff, maxDiff / max, time);
+	SPDLOG_LOGGER_INFO(mSLog, "Max difference: {:f} or {:f}% at time {:f} after {:d} steps", maxDiff, maxDiff / max, time, timeStepCount);
+
+	if (initTimeStep != mTimeStep)
+		updateMNAComponentsTimeStep(mTimeStep);
 
 	// Reset system for actual simulation
 	mRightSideVector.setZero();
@@ -542,11 +703,8 @@ template <typename VarType>
 Task::List MnaSolver<VarType>::getTasks() {
 	Task::List l;
 
-	for (auto comp : mMNAComponents) {
-		for (auto task : comp->mnaTasks()) {
-			l.push_back(task);
-		}
-	}
+	for (auto task : mnaComponentTasks())
+		l.push_back(task);
 	for (auto comp : mMNAIntfSwitches) {
 		for (auto task : comp->mnaTasks()) {
 			l.push_back(task);
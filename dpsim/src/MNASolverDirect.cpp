@@ -9,6 +9,9 @@
 #include <dpsim/MNASolverDirect.h>
 #include <dpsim/SequentialScheduler.h>
 
+#include <algorithm>
+#include <type_traits>
+
 using namespace DPsim;
 using namespace CPS;
 
@@ -20,9 +23,22 @@ MnaSolverDirect<VarType>::MnaSolverDirect(String name, CPS::Domain domain, CPS::
 }
 
 
+template <typename VarType>
+MnaSolverDirect<VarType>::~MnaSolverDirect() {
+	mStopPrefactorization = true;
+	if (mPrefactorizationThread.joinable())
+		mPrefactorizationThread.join();
+}
+
 template <typename VarType>
 void MnaSolverDirect<VarType>::switchedMatrixEmpty(std::size_t index) {
-	mSwitchedMatrices[std::bitset<SWITCH_NUM>(index)][0].setZero();
+	auto bit = std::bitset<SWITCH_NUM>(index);
+	// Matrices are only allocated for the switch states that occur
+	if (mLazySwitchFactorization && mSwitchedMatrices[bit].empty()) {
+		mSwitchedMatrices[bit].push_back(SparseMatrix(mSwitchedMatrixSize, mSwitchedMatrixSize));
+		mDirectLinearSolvers[bit].push_back(createDirectSolverImplementation(mSLog));
+	}
+	mSwitchedMatrices[bit][0].setZero();
 }
 
 template <typename VarType>
@@ -34,20 +50,205 @@ template <typename VarType>
 void MnaSolverDirect<VarType>::switchedMatrixStamp(std::size_t index, std::vector<std::shared_ptr<CPS::MNAInterface>>& comp)
 {
 	auto bit = std::bitset<SWITCH_NUM>(index);
-	auto& sys = mSwitchedMatrices[bit][0];
+	mFactorizeTimes.add(stampSwitchedSystem(bit, comp, mSwitchedMatrices[bit][0], *mDirectLinearSolvers[bit][0]));
+	if (mLazySwitchFactorization) {
+		captureSwitchedSystemStamps(comp);
+		touchSwitchState(bit);
+	}
+}
+
+template <typename VarType>
+Real MnaSolverDirect<VarType>::stampSwitchedSystem(const std::bitset<SWITCH_NUM>& bit, std::vector<std::shared_ptr<CPS::MNAInterface>>& comp,
+	SparseMatrix& sys, DirectLinearSolver& solver)
+{
 	for (auto component : comp) {
 		component->mnaApplySystemMatrixStamp(sys);
 	}
 	for (UInt i = 0; i < mSwitches.size(); ++i)
 		mSwitches[i]->mnaApplySwitchSystemMatrixStamp(bit[i], sys, 0);
 
+	return factorizeSwitchedSystem(sys, solver);
+}
+
+template <typename VarType>
+Real MnaSolverDirect<VarType>::factorizeSwitchedSystem(SparseMatrix& sys, DirectLinearSolver& solver) {
 	// Compute LU-factorization for system matrix
-	mDirectLinearSolvers[bit][0]->preprocessing(sys, mListVariableSystemMatrixEntries);
+	solver.preprocessing(sys, mListVariableSystemMatrixEntries);
 	auto start = std::chrono::steady_clock::now();
-	mDirectLinearSolvers[bit][0]->factorize(sys);
+	solver.factorize(sys);
 	auto end = std::chrono::steady_clock::now();
 	std::chrono::duration<Real> diff = end-start;
-	mFactorizeTimes.push_back(diff.count());
+	return diff.count();
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::captureSwitchedSystemStamps(std::vector<std::shared_ptr<CPS::MNAInterface>>& comp) {
+	mSwitchedBaseMatrix = SparseMatrix(mSwitchedMatrixSize, mSwitchedMatrixSize);
+	for (auto component : comp)
+		component->mnaApplySystemMatrixStamp(mSwitchedBaseMatrix);
+
+	mSwitchStamps.resize(mSwitches.size());
+	for (UInt i = 0; i < mSwitches.size(); ++i) {
+		for (Bool closed : { false, true }) {
+			SparseMatrix& stamp = mSwitchStamps[i][closed];
+			stamp = SparseMatrix(mSwitchedMatrixSize, mSwitchedMatrixSize);
+			mSwitches[i]->mnaApplySwitchSystemMatrixStamp(closed, stamp, 0);
+		}
+	}
+}
+
+template <typename VarType>
+Real MnaSolverDirect<VarType>::stampCapturedSwitchedSystem(const std::bitset<SWITCH_NUM>& bit,
+	SparseMatrix& sys, DirectLinearSolver& solver) {
+	// The components are stamped in the same order as in stampSwitchedSystem
+	sys = mSwitchedBaseMatrix;
+	for (UInt i = 0; i < mSwitchStamps.size(); ++i)
+		sys += mSwitchStamps[i][bit[i]];
+	return factorizeSwitchedSystem(sys, solver);
+}
+
+template <typename VarType>
+std::shared_ptr<DirectLinearSolver> MnaSolverDirect<VarType>::switchedSolver(const std::bitset<SWITCH_NUM>& bit) {
+	if (!mLazySwitchFactorization)
+		return mDirectLinearSolvers[bit][0];
+
+	adoptPrefactorizedStates();
+	auto it = mDirectLinearSolvers.find(bit);
+	if (it != mDirectLinearSolvers.end()) {
+		if (!mUnusedPrefactorizedStates.empty() && mUnusedPrefactorizedStates.erase(bit) > 0)
+			++mSwitchFactorizationStatistics.prefactorizationHits;
+		touchSwitchState(bit);
+		return it->second[0];
+	}
+
+	// First occurrence of this switch state
+	SPDLOG_LOGGER_INFO(mSLog, "Factorizing system matrix for switch status {:s}", bit.to_string());
+	++mSwitchFactorizationStatistics.onDemand;
+	SparseMatrix sys;
+	auto solver = createDirectSolverImplementation(mSLog);
+	Real factorizeTime = stampCapturedSwitchedSystem(bit, sys, *solver);
+	cacheSwitchedSystem(bit, sys, solver, factorizeTime);
+	return mDirectLinearSolvers[bit][0];
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::cacheSwitchedSystem(const std::bitset<SWITCH_NUM>& bit, SparseMatrix& sys,
+	std::shared_ptr<DirectLinearSolver> solver, Real factorizeTime) {
+	// A prefactorized state might have been factorized on demand in the meantime, keep the first one
+	if (mDirectLinearSolvers.find(bit) == mDirectLinearSolvers.end()) {
+		mSwitchedMatrices[bit].push_back(std::move(sys));
+		mDirectLinearSolvers[bit].push_back(solver);
+		mFactorizeTimes.add(factorizeTime);
+	}
+	touchSwitchState(bit);
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::adoptPrefactorizedStates() {
+	// Only this thread accesses the cache, the prefactorization thread hands over
+	// each state by setting its ready flag after the factorization is complete
+	while (mNumAdoptedPrefactorizedStates < mPrefactorizedStates.size()) {
+		PrefactorizedState& state = mPrefactorizedStates[mNumAdoptedPrefactorizedStates];
+		if (!state.ready.load(std::memory_order_acquire))
+			return;
+		if (mDirectLinearSolvers.find(state.bit) == mDirectLinearSolvers.end()) {
+			++mSwitchFactorizationStatistics.prefactorized;
+			mUnusedPrefactorizedStates.insert(state.bit);
+		}
+		cacheSwitchedSystem(state.bit, state.matrix, state.solver, state.factorizeTime);
+		state.solver.reset();
+		++mNumAdoptedPrefactorizedStates;
+	}
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::touchSwitchState(const std::bitset<SWITCH_NUM>& bit) {
+	auto pos = mSwitchStateUsagePos.find(bit);
+	if (pos != mSwitchStateUsagePos.end()) {
+		mSwitchStateUsage.splice(mSwitchStateUsage.begin(), mSwitchStateUsage, pos->second);
+		return;
+	}
+
+	mSwitchStateUsage.push_front(bit);
+	mSwitchStateUsagePos[bit] = mSwitchStateUsage.begin();
+
+	// Evict least recently used states, the state just added is kept in any case
+	while (mSwitchFactorizationCacheSize > 0 && mSwitchStateUsage.size() > std::max<UInt>(mSwitchFactorizationCacheSize, 1)) {
+		auto evicted = mSwitchStateUsage.back();
+		SPDLOG_LOGGER_DEBUG(mSLog, "Evicting factorization for switch status {:s}", evicted.to_string());
+		mSwitchStateUsage.pop_back();
+		mSwitchStateUsagePos.erase(evicted);
+		mSwitchedMatrices.erase(evicted);
+		mDirectLinearSolvers.erase(evicted);
+		mUnusedPrefactorizedStates.erase(evicted);
+		++mSwitchFactorizationStatistics.evictions;
+	}
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::prefactorizeSwitchStates(const std::vector<SwitchStateChange>& changes) {
+	if (!mLazySwitchFactorization || mSystemMatrixRecomputation || mFrequencyParallel || mSwitches.empty())
+		return;
+
+	// Find the state attribute of each switch to match the scheduled changes
+	std::vector<const CPS::AttributeBase*> switchStates;
+	for (auto sw : mSwitches) {
+		if (auto sw1Ph = std::dynamic_pointer_cast<CPS::Base::Ph1::Switch>(sw))
+			switchStates.push_back(sw1Ph->mIsClosed.getPtr().get());
+		else if (auto sw3Ph = std::dynamic_pointer_cast<CPS::Base::Ph3::Switch>(sw))
+			switchStates.push_back(sw3Ph->mSwitchClosed.getPtr().get());
+		else
+			switchStates.push_back(nullptr);
+	}
+
+	// Replay the changes on the current switch status, changes at the same
+	// time step result in a single new state
+	std::vector<std::bitset<SWITCH_NUM>> predictedStates;
+	auto status = mCurrentSwitchStatus;
+	for (std::size_t idx = 0; idx < changes.size();) {
+		Real time = changes[idx].time;
+		for (; idx < changes.size() && changes[idx].time - time < this->mTimeStep / 2; ++idx) {
+			for (UInt sw = 0; sw < mSwitches.size(); ++sw) {
+				if (switchStates[sw] == changes[idx].isClosed.getPtr().get())
+					status.set(sw, changes[idx].closed);
+			}
+		}
+		if (status != mCurrentSwitchStatus &&
+			mDirectLinearSolvers.find(status) == mDirectLinearSolvers.end() &&
+			std::find(predictedStates.begin(), predictedStates.end(), status) == predictedStates.end())
+			predictedStates.push_back(status);
+	}
+
+	// Do not prefactorize more states than the cache can hold next to the current one
+	if (mSwitchFactorizationCacheSize > 0 && predictedStates.size() >= mSwitchFactorizationCacheSize)
+		predictedStates.resize(mSwitchFactorizationCacheSize - 1);
+	if (predictedStates.empty())
+		return;
+
+	// Finish a previous prefactorization before its states are replaced
+	if (mPrefactorizationThread.joinable()) {
+		mStopPrefactorization = true;
+		mPrefactorizationThread.join();
+		mStopPrefactorization = false;
+		adoptPrefactorizedStates();
+	}
+
+	SPDLOG_LOGGER_INFO(mSLog, "Prefactorizing {} predicted switch states", predictedStates.size());
+	mPrefactorizedStates = std::vector<PrefactorizedState>(predictedStates.size());
+	for (std::size_t k = 0; k < predictedStates.size(); ++k)
+		mPrefactorizedStates[k].bit = predictedStates[k];
+	mNumAdoptedPrefactorizedStates = 0;
+
+	// The thread only reads the stamps captured at initialization, not the components
+	mPrefactorizationThread = std::thread([this]() {
+		for (auto& state : mPrefactorizedStates) {
+			if (mStopPrefactorization)
+				return;
+			state.solver = createDirectSolverImplementation(mSLog);
+			state.factorizeTime = stampCapturedSwitchedSystem(state.bit, state.matrix, *state.solver);
+			state.ready.store(true, std::memory_order_release);
+		}
+	});
 }
 
 template <typename VarType>
@@ -86,6 +287,11 @@ void MnaSolverDirect<VarType>::stampVariableSystemMatrix() {
 	/* TODO: find replacement for flush() */
 	mSLog->flush();
 
+	if (mFreezeSystemMatrixPattern) {
+		freezeVariableSystemMatrixPattern();
+		SPDLOG_LOGGER_INFO(mSLog, "Frozen pattern of variable system matrix with {} non-zeros", mFrozenNonZeros);
+	}
+
 	// Calculate factorization of current matrix
 	mDirectLinearSolverVariableSystemMatrix->preprocessing(mVariableSystemMatrix, mListVariableSystemMatrixEntries);
 
@@ -93,18 +299,19 @@ void MnaSolverDirect<VarType>::stampVariableSystemMatrix() {
 	mDirectLinearSolverVariableSystemMatrix->factorize(mVariableSystemMatrix);
 	auto end = std::chrono::steady_clock::now();
 	std::chrono::duration<Real> diff = end-start;
-	mFactorizeTimes.push_back(diff.count());
+	mFactorizeTimes.add(diff.count());
+
+	if (mLowRankSystemMatrixUpdates) {
+		initializeLowRankCorrection();
+		resetLowRankCorrection();
+	}
 }
 
 template <typename VarType>
 void MnaSolverDirect<VarType>::solveWithSystemMatrixRecomputation(Real time, Int timeStepCount) {
-	// Reset source vector
-	mRightSideVector.setZero();
-
 	// Add together the right side vector (computed by the components'
 	// pre-step tasks)
-	for (auto stamp : mRightVectorStamps)
-		mRightSideVector += *stamp;
+	MnaSolver<VarType>::sumRightVectorStamps();
 
 	// Get switch and variable comp status and update system matrix and lu factorization accordingly
 	if (hasVariableComponentChanged())
@@ -112,10 +319,21 @@ void MnaSolverDirect<VarType>::solveWithSystemMatrixRecomputation(Real time, Int
 
 	// Calculate new solution vector
 	auto start = std::chrono::steady_clock::now();
-	**mLeftSideVector = mDirectLinearSolverVariableSystemMatrix->solve(mRightSideVector);
+	if (mNumScenarios > 0) {
+		solveScenarioBatch(*mDirectLinearSolverVariableSystemMatrix);
+		if (mLowRankSize > 0) {
+			applyLowRankCorrection(mScenarioBatch);
+			**mLeftSideVector = mScenarioBatch.col(0);
+			**this->mScenarioLeftSideVectors = mScenarioBatch.rightCols(mNumScenarios);
+		}
+	} else {
+		mDirectLinearSolverVariableSystemMatrix->solveInPlace(mRightSideVector, **mLeftSideVector);
+		if (mLowRankSize > 0)
+			applyLowRankCorrection(**mLeftSideVector);
+	}
 	auto end = std::chrono::steady_clock::now();
 	std::chrono::duration<Real> diff = end-start;
-	mSolveTimes.push_back(diff.count());
+	mSolveTimes.add(diff.count());
 
 	// TODO split into separate task? (dependent on x, updating all v attributes)
 	for (UInt nodeIdx = 0; nodeIdx < mNumNetNodes; ++nodeIdx)
@@ -124,10 +342,39 @@ void MnaSolverDirect<VarType>::solveWithSystemMatrixRecomputation(Real time, Int
 	// Components' states will be updated by the post-step tasks
 }
 
+template <typename VarType>
+void MnaSolverDirect<VarType>::freezeVariableSystemMatrixPattern() {
+	// Insert explicit zeros at all entries declared as varying so that
+	// stamps of variable elements never change the structure of the matrix
+	Eigen::Index complexOffset = std::is_same<VarType, Complex>::value ? mVariableSystemMatrix.rows() / 2 : 0;
+	for (auto& entry : mListVariableSystemMatrixEntries) {
+		mVariableSystemMatrix.coeffRef(entry.first, entry.second) += 0.;
+		if (complexOffset > 0) {
+			mVariableSystemMatrix.coeffRef(entry.first + complexOffset, entry.second + complexOffset) += 0.;
+			mVariableSystemMatrix.coeffRef(entry.first, entry.second + complexOffset) += 0.;
+			mVariableSystemMatrix.coeffRef(entry.first + complexOffset, entry.second) += 0.;
+		}
+	}
+	mVariableSystemMatrix.makeCompressed();
+	mFrozenNonZeros = mVariableSystemMatrix.nonZeros();
+
+	// Lay out the static stamps in the frozen pattern, so that recomputation
+	// can start from a flat copy of the value array
+	SparseMatrix baseInPattern = mVariableSystemMatrix;
+	std::fill(baseInPattern.valuePtr(), baseInPattern.valuePtr() + mFrozenNonZeros, 0.);
+	for (Eigen::Index row = 0; row < mBaseSystemMatrix.outerSize(); ++row)
+		for (SparseMatrix::InnerIterator it(mBaseSystemMatrix, row); it; ++it)
+			baseInPattern.coeffRef(it.row(), it.col()) = it.value();
+	mBaseSystemMatrixValues.assign(baseInPattern.valuePtr(), baseInPattern.valuePtr() + mFrozenNonZeros);
+}
+
 template <typename VarType>
 void MnaSolverDirect<VarType>::recomputeSystemMatrix(Real time) {
 	// Start from base matrix
-	mVariableSystemMatrix = mBaseSystemMatrix;
+	if (mFreezeSystemMatrixPattern)
+		std::copy(mBaseSystemMatrixValues.begin(), mBaseSystemMatrixValues.end(), mVariableSystemMatrix.valuePtr());
+	else
+		mVariableSystemMatrix = mBaseSystemMatrix;
 
 	// Now stamp switches into matrix
 	for (auto sw : mMNAIntfSwitches)
@@ -137,14 +384,138 @@ void MnaSolverDirect<VarType>::recomputeSystemMatrix(Real time) {
 	for (auto comp : mMNAIntfVariableComps)
 		comp->mnaApplySystemMatrixStamp(mVariableSystemMatrix);
 
+	// A component stamped outside of the frozen pattern, so the pattern
+	// has to be extended and the factorization redone from scratch
+	if (mFreezeSystemMatrixPattern &&
+		(!mVariableSystemMatrix.isCompressed() || mVariableSystemMatrix.nonZeros() != mFrozenNonZeros)) {
+		SPDLOG_LOGGER_WARN(mSLog, "Stamp outside of frozen system matrix pattern at time {}, refreezing", time);
+		freezeVariableSystemMatrixPattern();
+		mDirectLinearSolverVariableSystemMatrix->preprocessing(mVariableSystemMatrix, mListVariableSystemMatrixEntries);
+		auto start = std::chrono::steady_clock::now();
+		mDirectLinearSolverVariableSystemMatrix->factorize(mVariableSystemMatrix);
+		auto end = std::chrono::steady_clock::now();
+		std::chrono::duration<Real> diff = end-start;
+		mFactorizeTimes.add(diff.count());
+		++mNumRecomputations;
+		if (mLowRankSystemMatrixUpdates)
+			resetLowRankCorrection();
+		return;
+	}
+
+	// Keep the existing factorization and correct the solution instead,
+	// until the configured number of accumulated updates is reached
+	if (mLowRankSystemMatrixUpdates && mNumLowRankUpdates < mMaxLowRankUpdates) {
+		auto start = std::chrono::steady_clock::now();
+		updateLowRankCorrection();
+		auto end = std::chrono::steady_clock::now();
+		std::chrono::duration<Real> diff = end-start;
+		mLowRankUpdateTimes.add(diff.count());
+		++mNumLowRankUpdates;
+		return;
+	}
+
 	// Refactorization of matrix assuming that structure remained
 	// constant by omitting analyzePattern
 	auto start = std::chrono::steady_clock::now();
 	mDirectLinearSolverVariableSystemMatrix->partialRefactorize(mVariableSystemMatrix, mListVariableSystemMatrixEntries);
 	auto end = std::chrono::steady_clock::now();
 	std::chrono::duration<Real> diff = end-start;
-	mRecomputationTimes.push_back(diff.count());
+	mRecomputationTimes.add(diff.count());
 	++mNumRecomputations;
+
+	if (mLowRankSystemMatrixUpdates)
+		resetLowRankCorrection();
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::initializeLowRankCorrection() {
+	// Rows stamped by switches and variable elements in their current state and
+	// the declared varying entries. Stamps keep their rows when the state changes.
+	SparseMatrix stamps(mVariableSystemMatrix.rows(), mVariableSystemMatrix.cols());
+	for (auto sw : mMNAIntfSwitches)
+		sw->mnaApplySystemMatrixStamp(stamps);
+	for (auto comp : mMNAIntfVariableComps)
+		comp->mnaApplySystemMatrixStamp(stamps);
+	stamps.makeCompressed();
+
+	std::vector<bool> candidate(mVariableSystemMatrix.rows(), false);
+	for (Eigen::Index row = 0; row < stamps.outerSize(); ++row)
+		if (stamps.outerIndexPtr()[row + 1] > stamps.outerIndexPtr()[row])
+			candidate[row] = true;
+	Eigen::Index complexOffset = std::is_same<VarType, Complex>::value ? mVariableSystemMatrix.rows() / 2 : 0;
+	for (auto& entry : mListVariableSystemMatrixEntries) {
+		candidate[entry.first] = true;
+		if (complexOffset > 0)
+			candidate[entry.first + complexOffset] = true;
+	}
+
+	mLowRankCandidateRows.clear();
+	for (Eigen::Index row = 0; row < static_cast<Eigen::Index>(candidate.size()); ++row)
+		if (candidate[row])
+			mLowRankCandidateRows.push_back(row);
+
+	const Eigen::Index n = mVariableSystemMatrix.rows();
+	const Eigen::Index maxRank = static_cast<Eigen::Index>(mLowRankCandidateRows.size());
+	const Eigen::Index numColumns = mNumScenarios + 1;
+	mLowRankRows.assign(maxRank, 0);
+	mLowRankUpdate = Matrix::Zero(maxRank, n);
+	mLowRankSolutions = Matrix::Zero(n, maxRank);
+	mLowRankCapacitanceMatrix = Matrix::Identity(maxRank, maxRank);
+	mLowRankCapacitance = Eigen::PartialPivLU<Matrix>(maxRank);
+	mLowRankUnitVector = Matrix::Zero(n, 1);
+	mLowRankUnitSolution = Matrix::Zero(n, 1);
+	mLowRankProjection = Matrix::Zero(maxRank, numColumns);
+	mLowRankCoefficients = Matrix::Zero(maxRank, numColumns);
+	SPDLOG_LOGGER_INFO(mSLog, "Low-rank updates of up to rank {}", maxRank);
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::updateLowRankCorrection() {
+	// A = A0 + E_R * dA_R with E_R selecting the changed rows R
+	mLowRankSize = 0;
+	for (Eigen::Index row : mLowRankCandidateRows) {
+		auto update = mLowRankUpdate.row(mLowRankSize);
+		update.setZero();
+		for (SparseMatrix::InnerIterator it(mVariableSystemMatrix, row); it; ++it)
+			update(it.col()) += it.value();
+		for (SparseMatrix::InnerIterator it(mFactorizedSystemMatrix, row); it; ++it)
+			update(it.col()) -= it.value();
+		if ((update.array() != 0.).any())
+			mLowRankRows[mLowRankSize++] = row;
+	}
+	if (mLowRankSize == 0)
+		return;
+
+	// Z = A0^-1 * E_R
+	for (Eigen::Index k = 0; k < mLowRankSize; ++k) {
+		mLowRankUnitVector(mLowRankRows[k], 0) = 1.;
+		mDirectLinearSolverVariableSystemMatrix->solveInPlace(mLowRankUnitVector, mLowRankUnitSolution);
+		mLowRankUnitVector(mLowRankRows[k], 0) = 0.;
+		mLowRankSolutions.col(k) = mLowRankUnitSolution.col(0);
+	}
+
+	// Capacitance matrix S = I + dA_R * Z. The rows and columns beyond the
+	// rank stay the identity, so that the factorization keeps its size.
+	mLowRankCapacitanceMatrix.setIdentity();
+	mLowRankCapacitanceMatrix.topLeftCorner(mLowRankSize, mLowRankSize).noalias() +=
+		mLowRankUpdate.topRows(mLowRankSize) * mLowRankSolutions.leftCols(mLowRankSize);
+	mLowRankCapacitance.compute(mLowRankCapacitanceMatrix);
+	mLowRankProjection.setZero();
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::resetLowRankCorrection() {
+	mFactorizedSystemMatrix = mVariableSystemMatrix;
+	mLowRankSize = 0;
+	mNumLowRankUpdates = 0;
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::applyLowRankCorrection(Matrix& solutions) {
+	// Woodbury correction: x = y - Z * S^-1 * (dA_R * y) with y solving the factorized system
+	mLowRankProjection.topRows(mLowRankSize).noalias() = mLowRankUpdate.topRows(mLowRankSize) * solutions;
+	mLowRankCoefficients = mLowRankCapacitance.solve(mLowRankProjection);
+	solutions.noalias() -= mLowRankSolutions.leftCols(mLowRankSize) * mLowRankCoefficients.topRows(mLowRankSize);
 }
 
 template<>
@@ -156,6 +527,9 @@ void MnaSolverDirect<Real>::createEmptySystemMatrix() {
 		mBaseSystemMatrix = SparseMatrix(mNumMatrixNodeIndices, mNumMatrixNodeIndices);
 		mVariableSystemMatrix = SparseMatrix(mNumMatrixNodeIndices, mNumMatrixNodeIndices);
 	} else {
+		mSwitchedMatrixSize = mNumMatrixNodeIndices;
+		if (mLazySwitchFactorization)
+			return;
 		for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++){
 			auto bit = std::bitset<SWITCH_NUM>(i);
 			mSwitchedMatrices[bit].push_back(SparseMatrix(mNumMatrixNodeIndices, mNumMatrixNodeIndices));
@@ -181,6 +555,9 @@ void MnaSolverDirect<Complex>::createEmptySystemMatrix() {
 		mBaseSystemMatrix = SparseMatrix(2*(mNumMatrixNodeIndices), 2*(mNumMatrixNodeIndices));
 		mVariableSystemMatrix = SparseMatrix(2*(mNumMatrixNodeIndices), 2*(mNumMatrixNodeIndices));
 	} else {
+		mSwitchedMatrixSize = 2*(mNumTotalMatrixNodeIndices);
+		if (mLazySwitchFactorization)
+			return;
 		for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++) {
 			auto bit = std::bitset<SWITCH_NUM>(i);
 			mSwitchedMatrices[bit].push_back(SparseMatrix(2*(mNumTotalMatrixNodeIndices), 2*(mNumTotalMatrixNodeIndices)));
@@ -215,22 +592,21 @@ std::shared_ptr<CPS::Task> MnaSolverDirect<VarType>::createLogTask()
 
 template <typename VarType>
 void MnaSolverDirect<VarType>::solve(Real time, Int timeStepCount) {
-	// Reset source vector
-	mRightSideVector.setZero();
-
 	// Add together the right side vector (computed by the components' pre-step tasks)
-	for (auto stamp : mRightVectorStamps)
-		mRightSideVector += *stamp;
+	MnaSolver<VarType>::sumRightVectorStamps();
 
 	if (!mIsInInitialization)
 		MnaSolver<VarType>::updateSwitchStatus();
 
-	if (mSwitchedMatrices.size() > 0){
+	if (mLazySwitchFactorization || mSwitchedMatrices.size() > 0){
 		auto start = std::chrono::steady_clock::now();
-		**mLeftSideVector = mDirectLinearSolvers[mCurrentSwitchStatus][0]->solve(mRightSideVector);
+		if (mNumScenarios > 0)
+			solveScenarioBatch(*switchedSolver(mCurrentSwitchStatus));
+		else
+			switchedSolver(mCurrentSwitchStatus)->solveInPlace(mRightSideVector, **mLeftSideVector);
 		auto end = std::chrono::steady_clock::now();
 		std::chrono::duration<Real> diff = end-start;
-		mSolveTimes.push_back(diff.count());
+		mSolveTimes.add(diff.count());
 	}
 
 	// CHECK: Is this really required? Or can operations actually become part of
@@ -255,9 +631,6 @@ void MnaSolverDirect<VarType>::solve(Real time, Int timeStepCount) {
 			if (numCompsRequireIter > 0){
 				mIter++;
 
-				// Reset source vector
-				mRightSideVector.setZero();
-
 				if (!mIsInInitialization)
 					MnaSolver<VarType>::updateSwitchStatus();
 
@@ -265,15 +638,17 @@ void MnaSolverDirect<VarType>::solve(Real time, Int timeStepCount) {
 					syncGen->correctorStep();
 
 				// Add together the right side vector (computed by the components' pre-step tasks)
-				for (auto stamp : mRightVectorStamps)
-					mRightSideVector += *stamp;
+				MnaSolver<VarType>::sumRightVectorStamps();
 
-				if (mSwitchedMatrices.size() > 0) {
+				if (mLazySwitchFactorization || mSwitchedMatrices.size() > 0) {
 					auto start = std::chrono::steady_clock::now();
-					**mLeftSideVector = mDirectLinearSolvers[mCurrentSwitchStatus][0]->solve(mRightSideVector);
+					if (mNumScenarios > 0)
+						solveScenarioBatch(*switchedSolver(mCurrentSwitchStatus));
+					else
+						switchedSolver(mCurrentSwitchStatus)->solveInPlace(mRightSideVector, **mLeftSideVector);
 					auto end = std::chrono::steady_clock::now();
 					std::chrono::duration<Real> diff = end-start;
-					mSolveTimes.push_back(diff.count());
+					mSolveTimes.add(diff.count());
 				}
 
 				// CHECK: Is this really required? Or can operations actually become part of
@@ -294,13 +669,21 @@ void MnaSolverDirect<VarType>::solve(Real time, Int timeStepCount) {
 
 template <typename VarType>
 void MnaSolverDirect<VarType>::solveWithHarmonics(Real time, Int timeStepCount, Int freqIdx) {
-	mRightSideVectorHarm[freqIdx].setZero();
-
 	// Sum of right side vectors (computed by the components' pre-step tasks)
-	for (auto stamp : mRightVectorStamps)
-		mRightSideVectorHarm[freqIdx] += stamp->col(freqIdx);
+	MnaSolver<VarType>::sumRightVectorStampsHarm(freqIdx);
 
-	**mLeftSideVectorHarm[freqIdx] = mDirectLinearSolvers[mCurrentSwitchStatus][freqIdx]->solve(mRightSideVectorHarm[freqIdx]);
+	// Each frequency has its own system matrix, so the source vector is solved in place
+	mDirectLinearSolvers[mCurrentSwitchStatus][freqIdx]->solveInPlace(mRightSideVectorHarm[freqIdx], **mLeftSideVectorHarm[freqIdx]);
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::solveScenarioBatch(DirectLinearSolver& solver) {
+	// Scenarios share the system matrix and only differ in their source vector
+	mScenarioBatch.col(0) = mRightSideVector.col(0);
+	mScenarioBatch.rightCols(mNumScenarios) = (**this->mScenarioRightSideOffsets).colwise() + mRightSideVector.col(0);
+	solver.solveBatch(mScenarioBatch);
+	**mLeftSideVector = mScenarioBatch.col(0);
+	**this->mScenarioLeftSideVectors = mScenarioBatch.rightCols(mNumScenarios);
 }
 
 template <typename VarType>
@@ -340,50 +723,50 @@ template<typename VarType>
 void MnaSolverDirect<VarType>::logLUTimes() {
 	logFactorizationTime();
 	logRecomputationTime();
+	logLowRankUpdateTime();
 	logSolveTime();
 }
 
 template<typename VarType>
 void MnaSolverDirect<VarType>::logSolveTime(){
-	Real solveSum = 0.0;
-	Real solveMax = 0.0;
-	for(auto meas : mSolveTimes)
-	{
-		solveSum += meas;
-		if(meas > solveMax)
-			solveMax = meas;
-	}
-  	SPDLOG_LOGGER_INFO(mSLog, "Cumulative solve times: {:.12f}", solveSum);
-	SPDLOG_LOGGER_INFO(mSLog, "Average solve time: {:.12f}", solveSum/static_cast<double>(mSolveTimes.size()));
-	SPDLOG_LOGGER_INFO(mSLog, "Maximum solve time: {:.12f}", solveMax);
-	SPDLOG_LOGGER_INFO(mSLog, "Number of solves: {:d}", mSolveTimes.size());
+  	SPDLOG_LOGGER_INFO(mSLog, "Cumulative solve times: {:.12f}", mSolveTimes.sum());
+	SPDLOG_LOGGER_INFO(mSLog, "Average solve time: {:.12f}", mSolveTimes.mean());
+	SPDLOG_LOGGER_INFO(mSLog, "Maximum solve time: {:.12f}", mSolveTimes.max());
+	SPDLOG_LOGGER_INFO(mSLog, "Solve time percentiles (p50/p99/p99.9): {:.12f} / {:.12f} / {:.12f}",
+		mSolveTimes.percentile(50), mSolveTimes.percentile(99), mSolveTimes.percentile(99.9));
+	SPDLOG_LOGGER_INFO(mSLog, "Number of solves: {:d}", mSolveTimes.count());
 }
 
 
 template <typename VarType>
 void MnaSolverDirect<VarType>::logFactorizationTime()
 {
-	for (auto meas : mFactorizeTimes) {
+	for (auto meas : mFactorizeTimes.samples()) {
 		SPDLOG_LOGGER_INFO(mSLog, "LU factorization time: {:.12f}", meas);
 	}
 }
 
 template <typename VarType>
 void MnaSolverDirect<VarType>::logRecomputationTime(){
-       Real recompSum = 0.0;
-	   Real recompMax = 0.0;
-       for (auto meas : mRecomputationTimes){
-               recompSum += meas;
-			   if(meas > recompMax)
-					recompMax = meas;
-       }
-	   // Sometimes, refactorization is not used
-	   if(mRecomputationTimes.size() != 0){
-		    SPDLOG_LOGGER_INFO(mSLog, "Cumulative refactorization times: {:.12f}",recompSum);
-       		SPDLOG_LOGGER_INFO(mSLog, "Average refactorization time: {:.12f}", recompSum/((double)mRecomputationTimes.size()));
-			SPDLOG_LOGGER_INFO(mSLog, "Maximum refactorization time: {:.12f}", recompMax);
-       		SPDLOG_LOGGER_INFO(mSLog, "Number of refactorizations: {:d}", mRecomputationTimes.size());
-	   }
+	// Sometimes, refactorization is not used
+	if (!mRecomputationTimes.empty()) {
+		SPDLOG_LOGGER_INFO(mSLog, "Cumulative refactorization times: {:.12f}", mRecomputationTimes.sum());
+		SPDLOG_LOGGER_INFO(mSLog, "Average refactorization time: {:.12f}", mRecomputationTimes.mean());
+		SPDLOG_LOGGER_INFO(mSLog, "Maximum refactorization time: {:.12f}", mRecomputationTimes.max());
+		SPDLOG_LOGGER_INFO(mSLog, "Refactorization time percentiles (p50/p99): {:.12f} / {:.12f}",
+			mRecomputationTimes.percentile(50), mRecomputationTimes.percentile(99));
+		SPDLOG_LOGGER_INFO(mSLog, "Number of refactorizations: {:d}", mRecomputationTimes.count());
+	}
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::logLowRankUpdateTime(){
+	if (!mLowRankUpdateTimes.empty()) {
+		SPDLOG_LOGGER_INFO(mSLog, "Cumulative low-rank update times: {:.12f}", mLowRankUpdateTimes.sum());
+		SPDLOG_LOGGER_INFO(mSLog, "Average low-rank update time: {:.12f}", mLowRankUpdateTimes.mean());
+		SPDLOG_LOGGER_INFO(mSLog, "Maximum low-rank update time: {:.12f}", mLowRankUpdateTimes.max());
+		SPDLOG_LOGGER_INFO(mSLog, "Number of low-rank updates: {:d}", mLowRankUpdateTimes.count());
+	}
 }
 
 template<typename VarType>
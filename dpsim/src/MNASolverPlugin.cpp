@@ -121,11 +121,8 @@ template <typename VarType>
 Task::List MnaSolverPlugin<VarType>::getTasks() {
     Task::List l;
 
-    for (auto comp : this->mMNAComponents) {
-		for (auto task : comp->mnaTasks()) {
-			l.push_back(task);
-		}
-	}
+	for (auto task : this->mnaComponentTasks())
+		l.push_back(task);
 	for (auto node : this->mNodes) {
 		for (auto task : node->mnaTasks())
 			l.push_back(task);
@@ -143,13 +140,9 @@ Task::List MnaSolverPlugin<VarType>::getTasks() {
 
 template <typename VarType>
 void MnaSolverPlugin<VarType>::solve(Real time, Int timeStepCount) {
-    // Reset source vector
-	this->mRightSideVector.setZero();
-
     // Add together the right side vector (computed by the components'
 	// pre-step tasks)
-	for (const auto &stamp : this->mRightVectorStamps)
-		this->mRightSideVector += *stamp;
+	this->sumRightVectorStamps();
 
 	if (!this->mIsInInitialization)
 		this->updateSwitchStatus();
@@ -29,6 +29,17 @@ void OpenMPLevelScheduler::createSchedule(const Task::List& tasks, const Edges&
 
 	if (!mOutMeasurementFile.empty())
 		Scheduler::initMeasurements(tasks);
+
+	mPlacedThreads.assign(mNumThreads, std::thread::id());
+}
+
+void OpenMPLevelScheduler::placeThread() {
+	// Every thread only writes the entry of its own thread number
+	Int thread = omp_get_thread_num();
+	if (mPlacedThreads[thread] != std::this_thread::get_id()) {
+		applyThreadPlacement(thread);
+		mPlacedThreads[thread] = std::this_thread::get_id();
+	}
 }
 
 void OpenMPLevelScheduler::step(Real time, Int timeStepCount) {
@@ -37,24 +48,30 @@ void OpenMPLevelScheduler::step(Real time, Int timeStepCount) {
 
 	if (!mOutMeasurementFile.empty()) {
 		#pragma omp parallel shared(time,timeStepCount) private(level, i, start, end) num_threads(mNumThreads)
-		for (level = 0; level < static_cast<long>(mLevels.size()); level++) {
-			{
-				#pragma omp for schedule(static)
-				for (i = 0; i < static_cast<long>(mLevels[level].size()); i++) {
-					start = std::chrono::steady_clock::now();
-					mLevels[level][i]->execute(time, timeStepCount);
-					end = std::chrono::steady_clock::now();
-					updateMeasurement(mLevels[level][i].get(), end-start);
+		{
+			placeThread();
+			for (level = 0; level < static_cast<long>(mLevels.size()); level++) {
+				{
+					#pragma omp for schedule(static)
+					for (i = 0; i < static_cast<long>(mLevels[level].size()); i++) {
+						start = std::chrono::steady_clock::now();
+						mLevels[level][i]->execute(time, timeStepCount);
+						end = std::chrono::steady_clock::now();
+						updateMeasurement(mLevels[level][i].get(), end-start);
+					}
 				}
 			}
 		}
 	} else {
 		#pragma omp parallel shared(time,timeStepCount) private(level, i) num_threads(mNumThreads)
-		for (level = 0; level < static_cast<long>(mLevels.size()); level++) {
-			{
-				#pragma omp for schedule(static)
-				for (i = 0; i < static_cast<long>(mLevels[level].size()); i++) {
-					mLevels[level][i]->execute(time, timeStepCount);
+		{
+			placeThread();
+			for (level = 0; level < static_cast<long>(mLevels.size()); level++) {
+				{
+					#pragma omp for schedule(static)
+					for (i = 0; i < static_cast<long>(mLevels[level].size()); i++) {
+						mLevels[level][i]->execute(time, timeStepCount);
+					}
 				}
 			}
 		}
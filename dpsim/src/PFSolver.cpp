@@ -8,11 +8,26 @@
 
 #include <dpsim/PFSolver.h>
 #include <dpsim/SequentialScheduler.h>
+#include <dpsim/SparseLUAdapter.h>
+#ifdef WITH_KLU
+#include <dpsim/KLUAdapter.h>
+#endif
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <limits>
+#include <mutex>
+#include <thread>
 
 using namespace DPsim;
 using namespace CPS;
 
+/// A reused Jacobian is updated if an iteration reduces the mismatch by less than this factor
+static const Real JACOBIAN_REUSE_CONTRACTION = 0.1;
+
 PFSolver::PFSolver(CPS::String name, CPS::SystemTopology system, CPS::Real timeStep, CPS::Logger::Level logLevel) :
 	Solver(name + "_PF", logLevel) {
 	mSystem = system;
@@ -48,9 +63,27 @@ void PFSolver::initialize(){
 	determineNodeBaseVoltages();
     composeAdmittanceMatrix();
 
-	mJ.setZero(mNumUnknowns,mNumUnknowns);
+	createJacobianPattern();
 	mX.setZero(mNumUnknowns);
 	mF.setZero(mNumUnknowns);
+	mJacobianRightSide.setZero(mNumUnknowns, 1);
+	mJacobianSolution.setZero(mNumUnknowns, 1);
+
+	createLinearSolvers();
+}
+
+std::shared_ptr<DirectLinearSolver> PFSolver::createLinearSolver() {
+#ifdef WITH_KLU
+	return std::make_shared<KLUAdapter>(mSLog);
+#else
+	return std::make_shared<SparseLUAdapter>(mSLog);
+#endif
+}
+
+void PFSolver::createLinearSolvers() {
+	mJacobianSolver = createLinearSolver();
+	mJacobianAnalyzed = false;
+	mJacobianFactorized = false;
 }
 
 void PFSolver::assignMatrixNodeIndices() {
@@ -205,20 +238,25 @@ void PFSolver::determinePFBusType() {
 		}
 	}
 
+	aggregateBusIndices();
+
+	SPDLOG_LOGGER_INFO(mSLog, "#### Create index vectors for power flow solver:");
+    SPDLOG_LOGGER_INFO(mSLog, "PQ Buses: {}", logVector(mPQBusIndices));
+    SPDLOG_LOGGER_INFO(mSLog, "PV Buses: {}", logVector(mPVBusIndices));
+    SPDLOG_LOGGER_INFO(mSLog, "VD Buses: {}", logVector(mVDBusIndices));
+}
+
+void PFSolver::aggregateBusIndices() {
     mNumPQBuses = mPQBusIndices.size();
 	mNumPVBuses = mPVBusIndices.size();
     mNumVDBuses = mVDBusIndices.size();
     mNumUnknowns = 2*mNumPQBuses + mNumPVBuses;
 
 	// Aggregate PQ bus and PV bus index vectors for easy handling in solver
+	mPQPVBusIndices.clear();
 	mPQPVBusIndices.reserve(mNumPQBuses + mNumPVBuses);
     mPQPVBusIndices.insert(mPQPVBusIndices.end(), mPQBusIndices.begin(), mPQBusIndices.end());
     mPQPVBusIndices.insert(mPQPVBusIndices.end(), mPVBusIndices.begin(), mPVBusIndices.end());
-
-	SPDLOG_LOGGER_INFO(mSLog, "#### Create index vectors for power flow solver:");
-    SPDLOG_LOGGER_INFO(mSLog, "PQ Buses: {}", logVector(mPQBusIndices));
-    SPDLOG_LOGGER_INFO(mSLog, "PV Buses: {}", logVector(mPVBusIndices));
-    SPDLOG_LOGGER_INFO(mSLog, "VD Buses: {}", logVector(mVDBusIndices));
 }
 
 void PFSolver::determineNodeBaseVoltages() {
@@ -353,6 +391,70 @@ CPS::Real PFSolver::B(int i, int j) {
 	return mY.coeff(i, j).imag();
 }
 
+CPS::Real PFSolver::branchSusceptance(UInt k, UInt j, Bool neglectResistance) {
+	Complex y = -mY.coeff(k, j);
+	if (!neglectResistance || y == Complex(0., 0.))
+		return -y.imag();
+	// Keep only the reactance of the branch impedance
+	return 1. / (1. / y).imag();
+}
+
+void PFSolver::composeSusceptanceMatrix(SparseMatrix& matrix, const std::vector<CPS::UInt>& busIndices,
+	Bool neglectResistance, Bool includeShunts) {
+	std::vector<Int> position(mSystem.mNodes.size(), -1);
+	for (UInt a = 0; a < busIndices.size(); ++a)
+		position[busIndices[a]] = a;
+
+	std::vector<Eigen::Triplet<Real>> entries;
+	for (UInt a = 0; a < busIndices.size(); ++a) {
+		UInt k = busIndices[a];
+		Real diagonal = 0.;
+		Real shunt = 0.;
+		for (CPS::SparseMatrixCompRow::InnerIterator it(mY, k); it; ++it) {
+			UInt j = it.col();
+			// The shunt susceptance is the sum of the row of Im(Y)
+			shunt += it.value().imag();
+			if (j == k)
+				continue;
+			Real b = branchSusceptance(k, j, neglectResistance);
+			diagonal += b;
+			if (position[j] >= 0)
+				entries.emplace_back(a, position[j], -b);
+		}
+		if (includeShunts)
+			diagonal -= shunt;
+		entries.emplace_back(a, a, diagonal);
+	}
+
+	matrix.resize(busIndices.size(), busIndices.size());
+	matrix.setFromTriplets(entries.begin(), entries.end());
+	matrix.makeCompressed();
+}
+
+void PFSolver::updateSusceptanceMatrix(SparseMatrix& matrix, const std::vector<CPS::UInt>& busIndices,
+	Bool neglectResistance, Bool includeShunts) {
+	// The pattern is symmetric, so column c holds the coupling of bus busIndices[c] to the other buses
+	for (Int c = 0; c < matrix.outerSize(); ++c) {
+		UInt j = busIndices[c];
+		Real diagonal = 0.;
+		Real shunt = 0.;
+		for (CPS::SparseMatrixCompRow::InnerIterator it(mY, j); it; ++it) {
+			shunt += it.value().imag();
+			if (it.col() != j)
+				diagonal += branchSusceptance(j, it.col(), neglectResistance);
+		}
+		if (includeShunts)
+			diagonal -= shunt;
+
+		for (SparseMatrix::InnerIterator it(matrix, c); it; ++it) {
+			if (it.row() == c)
+				it.valueRef() = diagonal;
+			else
+				it.valueRef() = -branchSusceptance(busIndices[it.row()], j, neglectResistance);
+		}
+	}
+}
+
 CPS::Bool PFSolver::checkConvergence() {
 	// Converged if all mismatches are below the tolerance
     for (CPS::UInt i = 0; i < mNumUnknowns; i++) {
@@ -369,16 +471,31 @@ Bool PFSolver::solvePowerflow() {
     // Check whether model already converged
     isConverged = checkConvergence();
 
+	Real mismatch = isConverged ? 0. : mF.lpNorm<Eigen::Infinity>();
+	Bool refreshJacobian = !mJacobianReuse || !mJacobianFactorized;
+
     mIterations = 0;
     for (unsigned i = 1; i < mMaxIterations && !isConverged; ++i) {
 
-        calculateJacobian();
-		auto sparseJ = mJ.sparseView();
+		if (refreshJacobian) {
+			calculateJacobian();
 
-		// Solve system mJ*mX = mF
-        Eigen::SparseLU<SparseMatrix>lu(sparseJ);
+			// The pattern of the Jacobian is fixed, so the ordering is only computed
+			// once and later iterations and time steps only factorize numerically
+			if (!mJacobianAnalyzed) {
+				std::vector<std::pair<UInt, UInt>> varyingEntries;
+				mJacobianSolver->preprocessing(mJ, varyingEntries);
+				mJacobianAnalyzed = true;
+			}
+			mJacobianSolver->factorize(mJ);
+			mJacobianFactorized = true;
+			++mNumJacobianFactorizations;
+		}
 
-		mX = lu.solve(mF);	/* code */
+		// Solve system mJ*mX = mF
+		mJacobianRightSide = mF;
+		mJacobianSolver->solveInPlace(mJacobianRightSide, mJacobianSolution);
+		mX = mJacobianSolution;
 
 		// Calculate new solution based on mX increments obtained from equation system
 		updateSolution();
@@ -387,7 +504,11 @@ Bool PFSolver::solvePowerflow() {
         calculateMismatch();
 
 		SPDLOG_LOGGER_DEBUG(mSLog, "Mismatch vector at iteration {}: \n {}", i, mF);
-		mSLog->flush();
+
+		// A reused Jacobian is kept as long as it reduces the mismatch fast enough
+		Real newMismatch = mF.lpNorm<Eigen::Infinity>();
+		refreshJacobian = !mJacobianReuse || newMismatch > JACOBIAN_REUSE_CONTRACTION * mismatch;
+		mismatch = newMismatch;
 
 		// Check convergence
         isConverged = checkConvergence();
@@ -398,7 +519,7 @@ Bool PFSolver::solvePowerflow() {
 
 void PFSolver::SolveTask::execute(Real time, Int timeStepCount) {
 	// apply keepLastSolution to save computation time
-    mSolver.generateInitialSolution(time);
+    mSolver.generateInitialSolution(time, mSolver.mWarmStart);
 	mSolver.solvePowerflow();
 	mSolver.setSolution();
 }
@@ -406,3 +527,417 @@ void PFSolver::SolveTask::execute(Real time, Int timeStepCount) {
 Task::List PFSolver::getTasks() {
 	return Task::List{std::make_shared<SolveTask>(*this)};
 }
+
+void PFSolver::solveTimeSeries(const std::vector<Real>& times, UInt numChunks, const String& outputFile) {
+	UInt numPoints = static_cast<UInt>(times.size());
+	UInt numNodes = static_cast<UInt>(mSystem.mNodes.size());
+	numChunks = std::max<UInt>(1, std::min(numChunks, numPoints));
+
+	std::ofstream output(outputFile, std::ios::binary | std::ios::trunc);
+	if (!output.is_open()) {
+		SPDLOG_LOGGER_ERROR(mSLog, "Cannot open output file {}", outputFile);
+		throw SolverException();
+	}
+
+	output.write("DPSQSTS1", 8);
+	std::uint32_t sizes[2] = { numNodes, numPoints };
+	output.write(reinterpret_cast<const char*>(sizes), sizeof(sizes));
+	std::vector<Real> baseVoltages(numNodes);
+	for (UInt i = 0; i < numNodes; ++i) {
+		String name = mSystem.mNodes[i]->name();
+		std::uint32_t length = static_cast<std::uint32_t>(name.size());
+		output.write(reinterpret_cast<const char*>(&length), sizeof(length));
+		output.write(name.data(), length);
+		baseVoltages[i] = mBaseVoltageAtNode[mSystem.mNodes[i]];
+	}
+	std::streamoff headerSize = output.tellp();
+	std::streamoff recordSize = sizeof(Real) + 2 * sizeof(std::uint32_t) + 2 * numNodes * sizeof(Real);
+
+	// The first chunk is solved by this solver, the others by independent copies.
+	// The initial solution of every time point is only logged for debugging.
+	Logger::Level stepLogLevel = mStepLogLevel;
+	mStepLogLevel = Logger::Level::debug;
+	std::vector<std::shared_ptr<PFSolver>> copies;
+	std::vector<PFSolver*> solvers { this };
+	for (UInt chunk = 1; chunk < numChunks; ++chunk) {
+		copies.push_back(clone());
+		copies.back()->createLinearSolvers();
+		copies.back()->mNumJacobianFactorizations = 0;
+		solvers.push_back(copies.back().get());
+	}
+	mNumJacobianFactorizations = 0;
+
+	std::mutex componentMutex, outputMutex;
+	std::vector<UInt> iterations(numChunks, 0), failures(numChunks, 0);
+
+	auto solveChunk = [&](UInt chunk) {
+		PFSolver& solver = *solvers[chunk];
+		UInt begin = static_cast<UInt>(static_cast<std::uint64_t>(numPoints) * chunk / numChunks);
+		UInt end = static_cast<UInt>(static_cast<std::uint64_t>(numPoints) * (chunk + 1) / numChunks);
+		VectorComp voltages(numNodes);
+		std::vector<Real> values(2 * numNodes);
+
+		for (UInt idx = begin; idx < end; ++idx) {
+			{
+				// The components are shared by all chunks and updated for the time point
+				std::lock_guard<std::mutex> lock(componentMutex);
+				solver.generateInitialSolution(times[idx], solver.mWarmStart && idx > begin);
+			}
+			solver.solvePowerflow();
+			iterations[chunk] += solver.mIterations;
+			if (!solver.isConverged)
+				++failures[chunk];
+
+			solver.getSolutionVoltages(voltages);
+			for (UInt i = 0; i < numNodes; ++i) {
+				values[2 * i] = voltages(i).real() * baseVoltages[i];
+				values[2 * i + 1] = voltages(i).imag() * baseVoltages[i];
+			}
+			std::uint32_t status[2] = { solver.mIterations, solver.isConverged };
+
+			std::lock_guard<std::mutex> lock(outputMutex);
+			output.seekp(headerSize + idx * recordSize);
+			output.write(reinterpret_cast<const char*>(&times[idx]), sizeof(Real));
+			output.write(reinterpret_cast<const char*>(status), sizeof(status));
+			output.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(Real));
+		}
+	};
+
+	auto start = std::chrono::steady_clock::now();
+	std::vector<std::thread> threads;
+	for (UInt chunk = 1; chunk < numChunks; ++chunk)
+		threads.emplace_back(solveChunk, chunk);
+	solveChunk(0);
+	for (auto& thread : threads)
+		thread.join();
+	auto end = std::chrono::steady_clock::now();
+	mStepLogLevel = stepLogLevel;
+
+	UInt totalIterations = 0, totalFailures = 0, totalFactorizations = 0;
+	for (UInt chunk = 0; chunk < numChunks; ++chunk) {
+		totalIterations += iterations[chunk];
+		totalFailures += failures[chunk];
+		totalFactorizations += solvers[chunk]->mNumJacobianFactorizations;
+	}
+	SPDLOG_LOGGER_INFO(mSLog, "Solved {} time points in {} chunks within {} s", numPoints, numChunks,
+		std::chrono::duration<Real>(end - start).count());
+	SPDLOG_LOGGER_INFO(mSLog, "{} iterations, {} Jacobian factorizations, {} time points not converged",
+		totalIterations, totalFactorizations, totalFailures);
+}
+
+std::vector<PFSolver::Contingency> PFSolver::listN1Contingencies() {
+	std::vector<Contingency> contingencies;
+	for (auto line : mLines)
+		contingencies.push_back({ Contingency::Type::Branch, line->name() });
+	for (auto trans : mTransformers) {
+		// Transformers without impedance are not part of the admittance matrix
+		if (**trans->mResistance == 0 && **trans->mInductance == 0)
+			continue;
+		contingencies.push_back({ Contingency::Type::Branch, trans->name() });
+	}
+	for (auto gen : mSynchronGenerators) {
+		UInt bus = gen->node(0)->matrixNodeIndex();
+		if (std::find(mPVBusIndices.begin(), mPVBusIndices.end(), bus) != mPVBusIndices.end())
+			contingencies.push_back({ Contingency::Type::Generator, gen->name() });
+	}
+	return contingencies;
+}
+
+/// Check whether every bus is connected to a VD bus by non-zero branch admittances
+static Bool isConnected(const SparseMatrixCompRow& Y, const std::vector<UInt>& vdBuses) {
+	std::vector<Bool> reached(Y.rows(), false);
+	std::vector<UInt> stack(vdBuses.begin(), vdBuses.end());
+	for (auto k : vdBuses)
+		reached[k] = true;
+	while (!stack.empty()) {
+		UInt k = stack.back();
+		stack.pop_back();
+		for (SparseMatrixCompRow::InnerIterator it(Y, k); it; ++it) {
+			// Removing the only branch between two buses gives exact zeros
+			if (reached[it.col()] || it.value() == Complex(0., 0.))
+				continue;
+			reached[it.col()] = true;
+			stack.push_back(it.col());
+		}
+	}
+	return std::find(reached.begin(), reached.end(), false) == reached.end();
+}
+
+std::vector<PFSolver::ContingencyResult> PFSolver::solveContingencies(Real time,
+	const std::vector<Contingency>& contingencies, UInt numThreads, const ContingencyLimits& limits) {
+	UInt numNodes = static_cast<UInt>(mSystem.mNodes.size());
+	UInt numContingencies = static_cast<UInt>(contingencies.size());
+	numThreads = std::max<UInt>(1, std::min(numThreads, numContingencies));
+
+	// Element admittance matrices of all branches, obtained by stamping each branch alone
+	struct Branch {
+		String name;
+		UInt bus[2];
+		MatrixComp element;
+		/// Rating in per unit, zero if unknown
+		Real rating;
+	};
+	std::vector<Branch> branches;
+	std::map<String, UInt> branchIndices;
+	auto addBranch = [&](const String& name, UInt bus0, UInt bus1, Real defaultRating, const std::function<void(SparseMatrixCompRow&)>& stamp) {
+		SparseMatrixCompRow Y(numNodes, numNodes);
+		stamp(Y);
+		Branch branch { name, { bus0, bus1 }, MatrixComp(2, 2), defaultRating / mBaseApparentPower };
+		for (UInt i = 0; i < 2; ++i)
+			for (UInt j = 0; j < 2; ++j)
+				branch.element(i, j) = Y.coeff(branch.bus[i], branch.bus[j]);
+		auto rating = limits.branchRatings.find(name);
+		if (rating != limits.branchRatings.end())
+			branch.rating = rating->second / mBaseApparentPower;
+		branchIndices[name] = static_cast<UInt>(branches.size());
+		branches.push_back(branch);
+	};
+	for (auto line : mLines)
+		addBranch(line->name(), line->matrixNodeIndex(0), line->matrixNodeIndex(1), 0.,
+			[&line](SparseMatrixCompRow& Y) { line->pfApplyAdmittanceMatrixStamp(Y); });
+	for (auto trans : mTransformers) {
+		if (**trans->mResistance == 0 && **trans->mInductance == 0)
+			continue;
+		addBranch(trans->name(), trans->matrixNodeIndex(0), trans->matrixNodeIndex(1), trans->attributeTyped<Real>("S")->get(),
+			[&trans](SparseMatrixCompRow& Y) { trans->pfApplyAdmittanceMatrixStamp(Y); });
+	}
+
+	// Generators at PV buses, the bus stays a PV bus if another source controls its voltage
+	struct Generator {
+		const IdentifiedObject* component;
+		UInt bus;
+		Bool keepsVoltage;
+	};
+	std::map<String, Generator> generators;
+	for (auto gen : mSynchronGenerators) {
+		UInt bus = gen->node(0)->matrixNodeIndex();
+		auto pv = std::find(mPVBusIndices.begin(), mPVBusIndices.end(), bus);
+		if (pv == mPVBusIndices.end())
+			continue;
+		Bool keepsVoltage = false;
+		for (auto comp : mSystem.mComponentsAtNode[mPVBuses[pv - mPVBusIndices.begin()]]) {
+			if (auto other = std::dynamic_pointer_cast<CPS::SP::Ph1::SynchronGenerator>(comp))
+				keepsVoltage |= other != gen && other->mPowerflowBusType == CPS::PowerflowBusType::PV;
+			else if (auto extnet = std::dynamic_pointer_cast<CPS::SP::Ph1::NetworkInjection>(comp))
+				keepsVoltage |= extnet->mPowerflowBusType == CPS::PowerflowBusType::PV;
+		}
+		generators[gen->name()] = { gen.get(), bus, keepsVoltage };
+	}
+
+	for (auto& contingency : contingencies) {
+		Bool known = contingency.type == Contingency::Type::Branch
+			? branchIndices.count(contingency.name) > 0 : generators.count(contingency.name) > 0;
+		if (!known) {
+			std::stringstream ss;
+			ss << "Contingency>>" << contingency.name << ": no branch or generator at a PV bus with this name";
+			throw std::invalid_argument(ss.str());
+		}
+	}
+
+	// Base case, which is the starting point of all contingencies
+	generateInitialSolution(time, false);
+	if (!solvePowerflow()) {
+		SPDLOG_LOGGER_ERROR(mSLog, "Base case of the contingency analysis did not converge");
+		throw SolverException();
+	}
+	setSolution();
+	VectorComp baseVoltages;
+	getSolutionVoltages(baseVoltages);
+
+	std::vector<std::shared_ptr<PFSolver>> workers;
+	for (UInt thread = 0; thread < numThreads; ++thread) {
+		workers.push_back(clone());
+		workers.back()->createLinearSolvers();
+		workers.back()->mNumJacobianFactorizations = 0;
+		workers.back()->mStepLogLevel = Logger::Level::debug;
+	}
+
+	std::vector<ContingencyResult> results(numContingencies);
+	std::atomic<UInt> nextContingency { 0 };
+
+	auto evaluate = [&](UInt thread) {
+		PFSolver& solver = *workers[thread];
+		VectorComp voltages;
+		// Set if the bus types of the previous contingency differed from the base case
+		Bool restructured = false;
+
+		for (UInt idx = nextContingency++; idx < numContingencies; idx = nextContingency++) {
+			const Contingency& contingency = contingencies[idx];
+			ContingencyResult& result = results[idx];
+			result.contingency = contingency;
+
+			// Apply the outage to the copy of the solver
+			const Branch* outage = nullptr;
+			const Generator* generator = nullptr;
+			std::vector<std::pair<Complex*, Complex>> changedEntries;
+			Bool busTypeChanged = false;
+			std::vector<UInt> pqBusIndices, pvBusIndices;
+			TopologicalNode::List pqBuses, pvBuses;
+
+			if (contingency.type == Contingency::Type::Branch) {
+				outage = &branches[branchIndices.at(contingency.name)];
+				for (UInt i = 0; i < 2; ++i) {
+					for (UInt j = 0; j < 2; ++j) {
+						Complex& entry = solver.mY.coeffRef(outage->bus[i], outage->bus[j]);
+						changedEntries.emplace_back(&entry, entry);
+						entry -= outage->element(i, j);
+					}
+				}
+			} else {
+				generator = &generators.at(contingency.name);
+				solver.mOutOfService.insert(generator->component);
+				if (!generator->keepsVoltage) {
+					pqBusIndices = solver.mPQBusIndices;
+					pvBusIndices = solver.mPVBusIndices;
+					pqBuses = solver.mPQBuses;
+					pvBuses = solver.mPVBuses;
+
+					auto pos = std::find(solver.mPVBusIndices.begin(), solver.mPVBusIndices.end(), generator->bus) - solver.mPVBusIndices.begin();
+					solver.mPQBusIndices.push_back(generator->bus);
+					solver.mPQBuses.push_back(solver.mPVBuses[pos]);
+					solver.mPVBusIndices.erase(solver.mPVBusIndices.begin() + pos);
+					solver.mPVBuses.erase(solver.mPVBuses.begin() + pos);
+					solver.aggregateBusIndices();
+					busTypeChanged = true;
+				}
+			}
+
+			if (!isConnected(solver.mY, solver.mVDBusIndices)) {
+				result.status = ContingencyResult::Status::Islanded;
+			} else {
+				// Branch outages keep the pattern, so the pattern and the symbolic
+				// analysis are only created again if the bus types change
+				if (busTypeChanged || restructured) {
+					solver.createJacobianPattern();
+					solver.mX.setZero(solver.mNumUnknowns);
+					solver.mF.setZero(solver.mNumUnknowns);
+					solver.mJacobianRightSide.setZero(solver.mNumUnknowns, 1);
+					solver.mJacobianSolution.setZero(solver.mNumUnknowns, 1);
+					solver.mJacobianAnalyzed = false;
+				} else {
+					solver.updateJacobianValues();
+				}
+				restructured = busTypeChanged;
+				solver.mJacobianFactorized = false;
+
+				// Branch outages keep the injections of the base case. The components
+				// already hold the values for its time and are only read, as they are
+				// shared by all threads.
+				if (generator)
+					solver.composeInitialSolution(false);
+				solver.applyStartingVoltages(baseVoltages);
+				Bool converged = solver.solvePowerflow();
+				result.iterations = solver.mIterations;
+				result.status = converged ? ContingencyResult::Status::Converged : ContingencyResult::Status::NotConverged;
+			}
+
+			if (result.status == ContingencyResult::Status::Converged) {
+				solver.getSolutionVoltages(voltages);
+
+				result.minVoltage = std::numeric_limits<Real>::max();
+				for (UInt i = 0; i < numNodes; ++i) {
+					Real voltage = std::abs(voltages(i));
+					if (voltage < result.minVoltage) {
+						result.minVoltage = voltage;
+						result.minVoltageNode = mSystem.mNodes[i]->name();
+					}
+					if (voltage > result.maxVoltage) {
+						result.maxVoltage = voltage;
+						result.maxVoltageNode = mSystem.mNodes[i]->name();
+					}
+					Real violation = std::max(limits.minVoltage - voltage, voltage - limits.maxVoltage);
+					if (violation > 0) {
+						result.severity += violation;
+						++result.numViolations;
+					}
+				}
+
+				for (auto& branch : branches) {
+					if (&branch == outage || branch.rating <= 0)
+						continue;
+					VectorComp v(2);
+					v << voltages(branch.bus[0]), voltages(branch.bus[1]);
+					VectorComp current = branch.element * v;
+					Real flow = std::max(std::abs(v(0) * std::conj(current(0))), std::abs(v(1) * std::conj(current(1))));
+					Real loading = flow / branch.rating;
+					if (loading > result.maxLoading) {
+						result.maxLoading = loading;
+						result.maxLoadingBranch = branch.name;
+					}
+					if (loading > 1) {
+						result.severity += loading - 1;
+						++result.numViolations;
+					}
+				}
+			}
+
+			// Restore the base case
+			for (auto& entry : changedEntries)
+				*entry.first = entry.second;
+			if (busTypeChanged) {
+				solver.mPQBusIndices = pqBusIndices;
+				solver.mPVBusIndices = pvBusIndices;
+				solver.mPQBuses = pqBuses;
+				solver.mPVBuses = pvBuses;
+				solver.aggregateBusIndices();
+			}
+			if (generator) {
+				solver.mOutOfService.erase(generator->component);
+				solver.composeInitialSolution(false);
+			}
+		}
+	};
+
+	auto start = std::chrono::steady_clock::now();
+	std::vector<std::thread> threads;
+	for (UInt thread = 1; thread < numThreads; ++thread)
+		threads.emplace_back(evaluate, thread);
+	evaluate(0);
+	for (auto& thread : threads)
+		thread.join();
+	auto end = std::chrono::steady_clock::now();
+
+	// Islanded and diverged cases are ranked first, the status enum is ordered by increasing severity
+	std::stable_sort(results.begin(), results.end(), [](const ContingencyResult& a, const ContingencyResult& b) {
+		if (a.status != b.status)
+			return a.status > b.status;
+		return a.severity > b.severity;
+	});
+
+	UInt factorizations = 0, critical = 0, violated = 0;
+	for (auto& worker : workers)
+		factorizations += worker->mNumJacobianFactorizations;
+	for (auto& result : results) {
+		if (result.status != ContingencyResult::Status::Converged)
+			++critical;
+		else if (result.numViolations > 0)
+			++violated;
+	}
+	SPDLOG_LOGGER_INFO(mSLog, "Solved {} contingencies on {} threads within {} s, {} factorizations",
+		numContingencies, numThreads, std::chrono::duration<Real>(end - start).count(), factorizations);
+	SPDLOG_LOGGER_INFO(mSLog, "{} contingencies islanded or not converged, {} with limit violations", critical, violated);
+
+	return results;
+}
+
+void PFSolver::writeContingencyReport(const std::vector<ContingencyResult>& results, const String& filename) {
+	std::ofstream report(filename, std::ios::trunc);
+	if (!report.is_open()) {
+		SPDLOG_LOGGER_ERROR(mSLog, "Cannot open report file {}", filename);
+		throw SolverException();
+	}
+
+	static const char* statusNames[] = { "converged", "not converged", "islanded" };
+	report << "rank,contingency,type,status,iterations,severity,violations,"
+		<< "min_voltage,min_voltage_node,max_voltage,max_voltage_node,max_loading,max_loading_branch\n";
+	for (UInt rank = 0; rank < results.size(); ++rank) {
+		const ContingencyResult& result = results[rank];
+		report << rank + 1 << ',' << result.contingency.name << ','
+			<< (result.contingency.type == Contingency::Type::Branch ? "branch" : "generator") << ','
+			<< statusNames[static_cast<int>(result.status)] << ',' << result.iterations << ','
+			<< result.severity << ',' << result.numViolations << ','
+			<< result.minVoltage << ',' << result.minVoltageNode << ','
+			<< result.maxVoltage << ',' << result.maxVoltageNode << ','
+			<< result.maxLoading << ',' << result.maxLoadingBranch << '\n';
+	}
+}
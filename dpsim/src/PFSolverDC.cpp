@@ -0,0 +1,71 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/PFSolverDC.h>
+
+using namespace DPsim;
+using namespace CPS;
+
+PFSolverDC::PFSolverDC(CPS::String name, const CPS::SystemTopology &system, CPS::Real timeStep, CPS::Logger::Level logLevel)
+    : PFSolverPowerPolar(name, system, timeStep, logLevel) { }
+
+void PFSolverDC::createJacobianPattern() {
+    composeSusceptanceMatrix(mB, mPQPVBusIndices, true, false);
+    SPDLOG_LOGGER_INFO(mSLog, "DC powerflow with {} non-zeros in B", mB.nonZeros());
+}
+
+void PFSolverDC::updateJacobianValues() {
+    updateSusceptanceMatrix(mB, mPQPVBusIndices, true, false);
+}
+
+void PFSolverDC::createLinearSolvers() {
+    mBSolver = createLinearSolver();
+    mJacobianAnalyzed = false;
+    mJacobianFactorized = false;
+}
+
+Bool PFSolverDC::solvePowerflow() {
+    UInt npqpv = mNumPQBuses + mNumPVBuses;
+
+    if (npqpv > 0) {
+        if (!mJacobianFactorized) {
+            if (!mJacobianAnalyzed) {
+                std::vector<std::pair<UInt, UInt>> varyingEntries;
+                mBSolver->preprocessing(mB, varyingEntries);
+                mJacobianAnalyzed = true;
+            }
+            mBSolver->factorize(mB);
+            mJacobianFactorized = true;
+            ++mNumJacobianFactorizations;
+        }
+
+        // B * D = P, the angles of the VD buses are moved to the right side
+        Matrix rightSideVector(npqpv, 1);
+        for (UInt a = 0; a < npqpv; ++a) {
+            UInt k = mPQPVBusIndices[a];
+            rightSideVector(a, 0) = Pesp.coeff(k);
+            for (auto vd : mVDBusIndices)
+                rightSideVector(a, 0) += branchSusceptance(k, vd, true) * sol_D.coeff(vd);
+        }
+        Matrix angles = mBSolver->solve(rightSideVector);
+        for (UInt a = 0; a < npqpv; ++a)
+            sol_D(mPQPVBusIndices[a]) = angles(a, 0);
+    }
+
+    // The branch flows are only consistent with the angles for flat magnitudes,
+    // so the set points of PV and VD buses are not applied either
+    sol_V.setOnes();
+
+    // Remaining mismatch of the nonlinear equations, only for information
+    calculateMismatch();
+    SPDLOG_LOGGER_DEBUG(mSLog, "Mismatch vector of the DC solution: \n {}", mF);
+
+    mIterations = 1;
+    isConverged = true;
+    return isConverged;
+}
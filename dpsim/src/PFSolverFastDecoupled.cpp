@@ -0,0 +1,95 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/PFSolverFastDecoupled.h>
+
+using namespace DPsim;
+using namespace CPS;
+
+PFSolverFastDecoupled::PFSolverFastDecoupled(CPS::String name, const CPS::SystemTopology &system, CPS::Real timeStep,
+    CPS::Logger::Level logLevel, Variant variant)
+    : PFSolverPowerPolar(name, system, timeStep, logLevel), mVariant(variant) {
+    // The convergence is linear, so more iterations than with Newton-Raphson are needed
+    mMaxIterations = 30;
+}
+
+void PFSolverFastDecoupled::createJacobianPattern() {
+    composeSusceptanceMatrix(mBp, mPQPVBusIndices, mVariant == Variant::XB, false);
+    std::vector<UInt> pqBusIndices(mPQPVBusIndices.begin(), mPQPVBusIndices.begin() + mNumPQBuses);
+    composeSusceptanceMatrix(mBpp, pqBusIndices, mVariant == Variant::BX, true);
+
+    SPDLOG_LOGGER_INFO(mSLog, "Fast decoupled {} with {} non-zeros in B' and {} non-zeros in B''",
+        mVariant == Variant::XB ? "XB" : "BX", mBp.nonZeros(), mBpp.nonZeros());
+}
+
+void PFSolverFastDecoupled::updateJacobianValues() {
+    // B'' only covers the PQ buses, which come first in mPQPVBusIndices
+    updateSusceptanceMatrix(mBp, mPQPVBusIndices, mVariant == Variant::XB, false);
+    updateSusceptanceMatrix(mBpp, mPQPVBusIndices, mVariant == Variant::BX, true);
+}
+
+void PFSolverFastDecoupled::createLinearSolvers() {
+    mBpSolver = createLinearSolver();
+    mBppSolver = createLinearSolver();
+    mJacobianAnalyzed = false;
+    mJacobianFactorized = false;
+}
+
+Bool PFSolverFastDecoupled::solvePowerflow() {
+    UInt npqpv = mNumPQBuses + mNumPVBuses;
+
+    // Calculate the mismatch according to the initial solution
+    calculateMismatch();
+    isConverged = checkConvergence();
+
+    Matrix angleMismatch(npqpv, 1);
+    Matrix magnitudeMismatch(mNumPQBuses, 1);
+
+    mIterations = 0;
+    for (unsigned i = 1; i < mMaxIterations && !isConverged; ++i) {
+        if (!mJacobianFactorized) {
+            if (!mJacobianAnalyzed) {
+                std::vector<std::pair<UInt, UInt>> varyingEntries;
+                mBpSolver->preprocessing(mBp, varyingEntries);
+                if (mNumPQBuses > 0)
+                    mBppSolver->preprocessing(mBpp, varyingEntries);
+                mJacobianAnalyzed = true;
+            }
+            mBpSolver->factorize(mBp);
+            if (mNumPQBuses > 0)
+                mBppSolver->factorize(mBpp);
+            mJacobianFactorized = true;
+            mNumJacobianFactorizations += 2;
+        }
+
+        // Angles from B' * dD = dP / V
+        for (UInt a = 0; a < npqpv; ++a)
+            angleMismatch(a, 0) = mF.coeff(a) / sol_V.coeff(mPQPVBusIndices[a]);
+        Matrix angleUpdate = mBpSolver->solve(angleMismatch);
+        for (UInt a = 0; a < npqpv; ++a)
+            sol_D(mPQPVBusIndices[a]) += angleUpdate(a, 0);
+
+        // Magnitudes from B'' * dV = dQ / V, using the mismatch of the updated angles
+        if (mNumPQBuses > 0) {
+            calculateMismatch();
+            for (UInt a = 0; a < mNumPQBuses; ++a)
+                magnitudeMismatch(a, 0) = mF.coeff(a + npqpv) / sol_V.coeff(mPQPVBusIndices[a]);
+            Matrix magnitudeUpdate = mBppSolver->solve(magnitudeMismatch);
+            for (UInt a = 0; a < mNumPQBuses; ++a)
+                sol_V(mPQPVBusIndices[a]) += magnitudeUpdate(a, 0);
+        }
+
+        calculateMismatch();
+
+        SPDLOG_LOGGER_DEBUG(mSLog, "Mismatch vector at iteration {}: \n {}", i, mF);
+
+        isConverged = checkConvergence();
+        mIterations = i;
+    }
+    return isConverged;
+}
@@ -15,9 +15,6 @@ PFSolverPowerPolar::PFSolverPowerPolar(CPS::String name, const CPS::SystemTopolo
     : PFSolver(name, system, timeStep, logLevel){ }
 
 void PFSolverPowerPolar::generateInitialSolution(Real time, bool keep_last_solution) {
-	resize_sol(mSystem.mNodes.size());
-	resize_complex_sol(mSystem.mNodes.size());
-
     // update all components for the new time
     for (auto comp : mSystem.mComponents) {
         if (std::shared_ptr<CPS::SP::Ph1::Load> load = std::dynamic_pointer_cast<CPS::SP::Ph1::Load>(comp)) {
@@ -28,6 +25,21 @@ void PFSolverPowerPolar::generateInitialSolution(Real time, bool keep_last_solut
         }
     }
 
+    composeInitialSolution(keep_last_solution);
+}
+
+void PFSolverPowerPolar::composeInitialSolution(bool keep_last_solution) {
+    // Only a converged solution is a sensible starting point
+    keep_last_solution = keep_last_solution && solutionInitialized && isConverged;
+    if (keep_last_solution) {
+        // The injections are accumulated below, the voltages are kept
+        sol_P.setZero();
+        sol_Q.setZero();
+    } else {
+        resize_sol(mSystem.mNodes.size());
+        resize_complex_sol(mSystem.mNodes.size());
+    }
+
     // set initial solution for the new time
 	for (auto pq : mPQBuses) {
 		if (!keep_last_solution) {
@@ -62,8 +74,10 @@ void PFSolverPowerPolar::generateInitialSolution(Real time, bool keep_last_solut
 		}
 		for (auto comp : mSystem.mComponentsAtNode[pv]) {
 			if (std::shared_ptr<CPS::SP::Ph1::SynchronGenerator> gen = std::dynamic_pointer_cast<CPS::SP::Ph1::SynchronGenerator>(comp)) {
-				sol_P(pv->matrixNodeIndex()) += gen->attributeTyped<CPS::Real>("P_set_pu")->get();
-				sol_V(pv->matrixNodeIndex()) = gen->attributeTyped<CPS::Real>("V_set_pu")->get();
+				if (!mOutOfService.count(gen.get())) {
+					sol_P(pv->matrixNodeIndex()) += gen->attributeTyped<CPS::Real>("P_set_pu")->get();
+					sol_V(pv->matrixNodeIndex()) = gen->attributeTyped<CPS::Real>("V_set_pu")->get();
+				}
 			}
             else if (std::shared_ptr<CPS::SP::Ph1::Load> load = std::dynamic_pointer_cast<CPS::SP::Ph1::Load>(comp)) {
 				sol_P(pv->matrixNodeIndex()) -= load->attributeTyped<CPS::Real>("P_pu")->get();
@@ -114,12 +128,14 @@ void PFSolverPowerPolar::generateInitialSolution(Real time, bool keep_last_solut
     Pesp = sol_P;
     Qesp = sol_Q;
 
-	SPDLOG_LOGGER_INFO(mSLog, "#### Initial solution: ");
-	SPDLOG_LOGGER_INFO(mSLog, "P\t\tQ\t\tV\t\tD");
-	for (UInt i = 0; i < mSystem.mNodes.size(); ++i) {
-		SPDLOG_LOGGER_INFO(mSLog, "{}\t{}\t{}\t{}", sol_P[i], sol_Q[i], sol_V[i], sol_D[i]);
+	if (mSLog->should_log(mStepLogLevel)) {
+		SPDLOG_LOGGER_CALL(mSLog, mStepLogLevel, "#### Initial solution: ");
+		SPDLOG_LOGGER_CALL(mSLog, mStepLogLevel, "P\t\tQ\t\tV\t\tD");
+		for (UInt i = 0; i < mSystem.mNodes.size(); ++i) {
+			SPDLOG_LOGGER_CALL(mSLog, mStepLogLevel, "{}\t{}\t{}\t{}", sol_P[i], sol_Q[i], sol_V[i], sol_D[i]);
+		}
+		mSLog->flush();
 	}
-    mSLog->flush();
 }
 
 void PFSolverPowerPolar::calculateMismatch() {
@@ -138,101 +154,86 @@ void PFSolverPowerPolar::calculateMismatch() {
     }
 }
 
-void PFSolverPowerPolar::calculateJacobian() {
+void PFSolverPowerPolar::createJacobianPattern() {
     UInt npqpv = mNumPQBuses + mNumPVBuses;
-    double val;
-    UInt k, j;
-    UInt da, db;
 
-    mJ.setZero();
+    // Position of each bus among the PQ and PV buses, -1 for VD buses
+    std::vector<Int> position(mSystem.mNodes.size(), -1);
+    for (UInt a = 0; a < npqpv; ++a)
+        position[mPQPVBusIndices[a]] = a;
 
-    //J1
-    for (UInt a = 0; a < npqpv; ++a) { //rows
-        k = mPQPVBusIndices[a];
-        //diagonal
-        mJ.coeffRef(a, a) = -Q(k) - B(k, k) * sol_V.coeff(k) * sol_V.coeff(k);
-
-        //non diagonal elements
-        for (UInt b = 0; b < npqpv; ++b) {
-            if (b != a) {
-                j = mPQPVBusIndices[b];
-                val = sol_V.coeff(k) * sol_V.coeff(j)
-                        *(G(k, j) * sin(sol_D.coeff(k) - sol_D.coeff(j))
-                        - B(k, j) * cos(sol_D.coeff(k) - sol_D.coeff(j)));
-                //if (val != 0.0)
-                mJ.coeffRef(a, b) = val;
-            }
+    // Off-diagonal elements are only non-zero if the buses are coupled by the admittance matrix
+    std::vector<Eigen::Triplet<Real>> entries;
+    for (UInt a = 0; a < npqpv; ++a) {
+        UInt k = mPQPVBusIndices[a];
+        entries.emplace_back(a, a, 0.);
+        if (a < mNumPQBuses) {
+            entries.emplace_back(a, a + npqpv, 0.);
+            entries.emplace_back(a + npqpv, a, 0.);
+            entries.emplace_back(a + npqpv, a + npqpv, 0.);
         }
-    }
 
-    //J2
-    da = 0;
-    db = npqpv;
-    for (UInt a = 0; a < npqpv; ++a) { //rows
-        k = mPQPVBusIndices[a];
-        //diagonal
-        //std::cout << "J2D:" << (a + da) << "," << (a + db) << std::endl;
-        if (a < mNumPQBuses)
-            mJ.coeffRef(a + da, a + db) = P(k) + G(k, k) * sol_V.coeff(k) * sol_V.coeff(k);
-
-        //non diagonal elements
-        for (UInt b = 0; b < mNumPQBuses; ++b) {
-            if (b != a) {
-                j = mPQPVBusIndices[b];
-                val = sol_V.coeff(k) * sol_V.coeff(j)
-                        *(G(k, j) * cos(sol_D.coeff(k) - sol_D.coeff(j))
-                        + B(k, j) * sin(sol_D.coeff(k) - sol_D.coeff(j)));
-                //if (val != 0.0)
-                //std::cout << "J2ij:" << (a + da) << "," << (b + db) << std::endl;
-                mJ.coeffRef(a + da, b + db) = val;
+        for (CPS::SparseMatrixCompRow::InnerIterator it(mY, k); it; ++it) {
+            Int b = position[it.col()];
+            if (b < 0 || static_cast<UInt>(b) == a)
+                continue;
+            //J1
+            entries.emplace_back(a, b, 0.);
+            //J2
+            if (static_cast<UInt>(b) < mNumPQBuses)
+                entries.emplace_back(a, b + npqpv, 0.);
+            if (a < mNumPQBuses) {
+                //J3
+                entries.emplace_back(a + npqpv, b, 0.);
+                //J4
+                if (static_cast<UInt>(b) < mNumPQBuses)
+                    entries.emplace_back(a + npqpv, b + npqpv, 0.);
             }
         }
     }
 
+    mJ.resize(mNumUnknowns, mNumUnknowns);
+    mJ.setFromTriplets(entries.begin(), entries.end());
+    mJ.makeCompressed();
+    SPDLOG_LOGGER_INFO(mSLog, "Jacobian with {} unknowns and {} non-zeros", mNumUnknowns, mJ.nonZeros());
+}
 
-    //J3
-    da = npqpv;
-    db = 0;
-    for (UInt a = 0; a < mNumPQBuses; ++a) { //rows
-        k = mPQPVBusIndices[a];
-        //diagonal
-        //std::cout << "J3:" << (a + da) << "," << (a + db) << std::endl;
-        mJ.coeffRef(a + da, a + db) = P(k) - G(k, k) * sol_V.coeff(k) * sol_V.coeff(k);
-
-        //non diagonal elements
-        for (UInt b = 0; b < npqpv; ++b) {
-            if (b != a) {
-                j = mPQPVBusIndices[b];
-                val = sol_V.coeff(k) * sol_V.coeff(j)
-                        *(G(k, j) * cos(sol_D.coeff(k) - sol_D.coeff(j))
-                        + B(k, j) * sin(sol_D.coeff(k) - sol_D.coeff(j)));
-                //if (val != 0.0)
-                //std::cout << "J3:" << (a + da) << "," << (b + db) << std::endl;
-                mJ.coeffRef(a + da, b + db) = -val;
+void PFSolverPowerPolar::calculateJacobian() {
+    UInt npqpv = mNumPQBuses + mNumPVBuses;
+
+    // Only the entries of the pattern are written, so the structure of mJ does not change
+    for (UInt row = 0; row < mNumUnknowns; ++row) {
+        // Rows of J1 and J2 belong to the active, rows of J3 and J4 to the reactive power mismatch
+        Bool reactive = row >= npqpv;
+        UInt a = reactive ? row - npqpv : row;
+        UInt k = mPQPVBusIndices[a];
+        Real Pk = P(k);
+        Real Qk = Q(k);
+        Real Vk2 = sol_V.coeff(k) * sol_V.coeff(k);
+
+        for (SparseMatrix::InnerIterator it(mJ, row); it; ++it) {
+            // Columns of J1 and J3 belong to the angle, columns of J2 and J4 to the voltage magnitude
+            Bool magnitude = static_cast<UInt>(it.col()) >= npqpv;
+            UInt b = magnitude ? it.col() - npqpv : it.col();
+
+            if (b == a) {
+                if (!reactive)
+                    it.valueRef() = magnitude ? Pk + G(k, k) * Vk2 : -Qk - B(k, k) * Vk2;
+                else
+                    it.valueRef() = magnitude ? Qk - B(k, k) * Vk2 : Pk - G(k, k) * Vk2;
+                continue;
             }
-        }
-    }
 
-    //J4
-    da = npqpv;
-    db = npqpv;
-    for (UInt a = 0; a < mNumPQBuses; ++a) { //rows
-        k = mPQPVBusIndices[a];
-        //diagonal
-        //std::cout << "J4:" << (a + da) << "," << (a + db) << std::endl;
-        mJ.coeffRef(a + da, a + db) = Q(k) - B(k, k) * sol_V.coeff(k) * sol_V.coeff(k);
-
-        //non diagonal elements
-        for (UInt b = 0; b < mNumPQBuses; ++b) {
-            if (b != a) {
-                j = mPQPVBusIndices[b];
-                val = sol_V.coeff(k) * sol_V.coeff(j)
-                        *(G(k, j) * sin(sol_D.coeff(k) - sol_D.coeff(j))
-                        - B(k, j) * cos(sol_D.coeff(k) - sol_D.coeff(j)));
-                if (val != 0.0) {
-                    //std::cout << "J4:" << (a + da) << "," << (b + db) << std::endl;
-                    mJ.coeffRef(a + da, b + db) = val;
-                }
+            UInt j = mPQPVBusIndices[b];
+            Real VkVj = sol_V.coeff(k) * sol_V.coeff(j);
+            Real Dkj = sol_D.coeff(k) - sol_D.coeff(j);
+            if (reactive == magnitude) {
+                //J1 and J4
+                it.valueRef() = VkVj * (G(k, j) * sin(Dkj) - B(k, j) * cos(Dkj));
+            } else {
+                //J2 and J3
+                Real val = VkVj * (G(k, j) * cos(Dkj) + B(k, j) * sin(Dkj));
+                it.valueRef() = reactive ? -val : val;
             }
         }
     }
@@ -288,6 +289,22 @@ void PFSolverPowerPolar::setSolution() {
     calculateNodalInjection();
 }
 
+void PFSolverPowerPolar::getSolutionVoltages(CPS::VectorComp& voltages) {
+    voltages.resize(mSystem.mNodes.size());
+    for (UInt i = 0; i < mSystem.mNodes.size(); ++i)
+        voltages(i) = sol_Vcx(i);
+}
+
+void PFSolverPowerPolar::applyStartingVoltages(const CPS::VectorComp& voltages) {
+    UInt npqpv = mNumPQBuses + mNumPVBuses;
+    for (UInt a = 0; a < npqpv; ++a) {
+        UInt k = mPQPVBusIndices[a];
+        if (a < mNumPQBuses)
+            sol_V(k) = std::abs(voltages(k));
+        sol_D(k) = std::arg(voltages(k));
+    }
+}
+
 void PFSolverPowerPolar::calculateBranchFlow() {
 	for (auto line : mLines) {
 		VectorComp v(2);
@@ -334,20 +351,22 @@ void PFSolverPowerPolar::calculateNodalInjection() {
 
 Real PFSolverPowerPolar::P(UInt k) {
     Real val = 0.0;
-    for (UInt j = 0; j < mSystem.mNodes.size(); ++j) {
+    for (CPS::SparseMatrixCompRow::InnerIterator it(mY, k); it; ++it) {
+        UInt j = it.col();
         val += sol_V.coeff(j)
-                *(G(k, j) * cos(sol_D.coeff(k) - sol_D.coeff(j))
-                + B(k, j) * sin(sol_D.coeff(k) - sol_D.coeff(j)));
+                *(it.value().real() * cos(sol_D.coeff(k) - sol_D.coeff(j))
+                + it.value().imag() * sin(sol_D.coeff(k) - sol_D.coeff(j)));
     }
     return sol_V.coeff(k) * val;
 }
 
 Real PFSolverPowerPolar::Q(UInt k) {
     Real val = 0.0;
-    for (UInt j = 0; j < mSystem.mNodes.size(); ++j) {
+    for (CPS::SparseMatrixCompRow::InnerIterator it(mY, k); it; ++it) {
+        UInt j = it.col();
         val += sol_V.coeff(j)
-                *(G(k, j) * sin(sol_D.coeff(k) - sol_D.coeff(j))
-                - B(k, j) * cos(sol_D.coeff(k) - sol_D.coeff(j)));
+                *(it.value().real() * sin(sol_D.coeff(k) - sol_D.coeff(j))
+                - it.value().imag() * cos(sol_D.coeff(k) - sol_D.coeff(j)));
     }
     return sol_V.coeff(k) * val;
 }
@@ -355,8 +374,8 @@ Real PFSolverPowerPolar::Q(UInt k) {
 void PFSolverPowerPolar::calculatePAndQAtSlackBus() {
     for (auto k: mVDBusIndices) {
         CPS::Complex I(0.0, 0.0);
-        for (UInt j = 0; j < mSystem.mNodes.size(); ++j) {
-            I += mY.coeff(k, j) * sol_Vcx(j);
+        for (CPS::SparseMatrixCompRow::InnerIterator it(mY, k); it; ++it) {
+            I += it.value() * sol_Vcx(it.col());
         }
         CPS::Complex S(0.0, 0.0);
         S = sol_Vcx(k) * conj(I);
@@ -380,8 +399,8 @@ void PFSolverPowerPolar::calculatePAndQAtSlackBus() {
 void PFSolverPowerPolar::calculateQAtPVBuses() {
         for (auto k: mPVBusIndices) {
         CPS::Complex I(0.0, 0.0);
-        for (UInt j = 0; j < mSystem.mNodes.size(); ++j) {
-            I += mY.coeff(k, j) * sol_Vcx(j);
+        for (CPS::SparseMatrixCompRow::InnerIterator it(mY, k); it; ++it) {
+            I += it.value() * sol_Vcx(it.col());
         }
         CPS::Complex S(0.0, 0.0);
         S = sol_Vcx(k) * conj(I);
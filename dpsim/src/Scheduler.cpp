@@ -8,11 +8,26 @@
 
 #include <dpsim/Scheduler.h>
 
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <sstream>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 
+#ifdef __linux__
+  #include <pthread.h>
+  #include <sched.h>
+  #include <sys/mman.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+  #include <linux/futex.h>
+#endif
+
 using namespace CPS;
 using namespace DPsim;
 
@@ -75,6 +90,101 @@ Scheduler::TaskTime Scheduler::getAveragedMeasurement(CPS::Task* task) {
 }
 
 
+void Scheduler::ThreadPlacement::checkCpu(Int cpu) {
+#ifdef __linux__
+	// CPU_SET does not check its argument
+	if (cpu < 0 || cpu >= CPU_SETSIZE)
+		throw std::invalid_argument("CPU " + std::to_string(cpu) + " is out of range, the ids go from 0 to "
+			+ std::to_string(CPU_SETSIZE - 1));
+#else
+	if (cpu < 0)
+		throw std::invalid_argument("CPU " + std::to_string(cpu) + " is out of range");
+#endif
+}
+
+std::vector<std::vector<Int>> Scheduler::ThreadPlacement::parseCpuSets(const String& list) {
+	std::vector<std::vector<Int>> cpuSets;
+	std::istringstream sets(list);
+	String set;
+	while (std::getline(sets, set, ',')) {
+		std::vector<Int> cpus;
+		std::istringstream ranges(set);
+		String range;
+		while (std::getline(ranges, range, '+')) {
+			auto dash = range.find('-');
+			Int first, last;
+			try {
+				first = std::stoi(range.substr(0, dash));
+				last = dash == String::npos ? first : std::stoi(range.substr(dash + 1));
+			} catch (std::logic_error&) {
+				throw std::invalid_argument("Invalid CPU set: " + set);
+			}
+			if (first < 0 || last < first)
+				throw std::invalid_argument("Invalid CPU set: " + set);
+			checkCpu(last);
+			for (Int cpu = first; cpu <= last; ++cpu)
+				cpus.push_back(cpu);
+		}
+		if (!cpus.empty())
+			cpuSets.push_back(cpus);
+	}
+	return cpuSets;
+}
+
+void Scheduler::setThreadPlacement(const ThreadPlacement& placement) {
+	for (auto& cpus : placement.cpuSets) {
+		for (Int cpu : cpus)
+			ThreadPlacement::checkCpu(cpu);
+	}
+	mPlacement = placement;
+}
+
+void Scheduler::applyThreadPlacement(Int thread) {
+#ifdef __linux__
+	if (thread == 0 && mPlacement.lockMemory) {
+		if (mlockall(MCL_CURRENT | MCL_FUTURE) == 0)
+			SPDLOG_LOGGER_INFO(mSLog, "Locked process memory");
+		else
+			SPDLOG_LOGGER_WARN(mSLog, "Failed to lock process memory: {}", std::strerror(errno));
+	}
+
+	if (!mPlacement.cpuSets.empty()) {
+		auto& cpus = mPlacement.cpuSets[thread % mPlacement.cpuSets.size()];
+		cpu_set_t cpuset;
+		CPU_ZERO(&cpuset);
+		String cpuList;
+		for (Int cpu : cpus) {
+			CPU_SET(cpu, &cpuset);
+			cpuList += (cpuList.empty() ? "" : ",") + std::to_string(cpu);
+		}
+		Int ret = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+		if (ret == 0)
+			SPDLOG_LOGGER_INFO(mSLog, "Thread {} pinned to CPUs {}", thread, cpuList);
+		else
+			SPDLOG_LOGGER_WARN(mSLog, "Failed to pin thread {} to CPUs {}: {}", thread, cpuList, std::strerror(ret));
+	}
+
+	if (mPlacement.priority > 0) {
+		sched_param param;
+		param.sched_priority = mPlacement.priority;
+		Int ret = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+		if (ret == 0)
+			SPDLOG_LOGGER_INFO(mSLog, "Thread {} runs with SCHED_FIFO priority {}", thread, mPlacement.priority);
+		else
+			SPDLOG_LOGGER_WARN(mSLog, "Failed to set SCHED_FIFO priority {} for thread {}: {}", mPlacement.priority, thread, std::strerror(ret));
+	}
+
+	if (mPlacement.numaLocal) {
+		unsigned cpu = 0, node = 0;
+		if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0)
+			SPDLOG_LOGGER_INFO(mSLog, "Thread {} allocates its schedule on NUMA node {} (CPU {})", thread, node, cpu);
+	}
+#else
+	if (!mPlacement.cpuSets.empty() || mPlacement.priority > 0 || mPlacement.numaLocal || mPlacement.lockMemory)
+		SPDLOG_LOGGER_WARN(mSLog, "Thread placement is only supported on Linux");
+#endif
+}
+
 void Scheduler::resolveDeps(Task::List& tasks, Edges& inEdges, Edges& outEdges) {
 	// Create graph (list of out/in edges for each node) from attribute dependencies
 	tasks.push_back(mRoot);
@@ -202,17 +312,120 @@ void Scheduler::levelSchedule(const Task::List& tasks, const Edges& inEdges, con
 	}
 }
 
+Barrier::Barrier(Int limit, BarrierType type) :
+	mLimit(limit), mType(type), mCount(0), mGeneration(0), mSleepers(0),
+	mTreeTickets(0), mTreeSense(false) {
+	// Leaves take up to TREE_FAN_IN threads, inner nodes up to TREE_FAN_IN children
+	std::vector<Int> expected, parents;
+	Int levelBegin = 0, levelSize = 0;
+	for (Int remaining = limit; remaining > 0; remaining -= TREE_FAN_IN) {
+		expected.push_back(std::min(remaining, TREE_FAN_IN));
+		levelSize++;
+	}
+	while (levelSize > 1) {
+		Int nextBegin = levelBegin + levelSize, nextSize = 0;
+		for (Int child = 0; child < levelSize; child += TREE_FAN_IN) {
+			expected.push_back(std::min(levelSize - child, TREE_FAN_IN));
+			nextSize++;
+		}
+		parents.resize(nextBegin + nextSize, -1);
+		for (Int child = 0; child < levelSize; child++)
+			parents[levelBegin + child] = nextBegin + child / TREE_FAN_IN;
+		levelBegin = nextBegin;
+		levelSize = nextSize;
+	}
+	parents.resize(expected.size(), -1);
+
+	mTreeNodes = std::make_unique<TreeNode[]>(expected.size());
+	for (size_t i = 0; i < expected.size(); i++) {
+		mTreeNodes[i].expected = expected[i];
+		mTreeNodes[i].parent = parents[i];
+	}
+	mTreeSenses = std::make_unique<TreeSense[]>(std::max(limit, 1));
+}
+
+void Barrier::waitCondition() {
+	std::unique_lock<std::mutex> lk(mMutex);
+	Int gen = mGeneration;
+	mCount++;
+	if (mCount == mLimit) {
+		mCount = 0;
+		mGeneration++;
+		lk.unlock();
+		mCondition.notify_all();
+	} else {
+		// necessary because of spurious wakeups
+		while (gen == mGeneration)
+			mCondition.wait(lk);
+	}
+}
+
+void Barrier::waitHybrid(Int gen) {
+	// Spinning is cheaper than a context switch for short steps, so only
+	// sleep if the barrier is not released within the spin time
+	auto deadline = std::chrono::steady_clock::now() + mSpinTime;
+	for (UInt i = 1; mGeneration.load(std::memory_order_acquire) == gen; i++) {
+		cpuRelax();
+		if (i % 256 == 0 && std::chrono::steady_clock::now() > deadline)
+			break;
+	}
+
+	mSleepers.fetch_add(1);
+	while (mGeneration.load() == gen) {
+#ifdef __linux__
+		// Returns immediately if the generation has changed in the meantime
+		syscall(SYS_futex, reinterpret_cast<int*>(&mGeneration), FUTEX_WAIT_PRIVATE, gen, nullptr, nullptr, 0);
+#else
+		std::this_thread::yield();
+#endif
+	}
+	mSleepers.fetch_sub(1);
+}
+
+void Barrier::wakeSleepers() {
+#ifdef __linux__
+	syscall(SYS_futex, reinterpret_cast<int*>(&mGeneration), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#endif
+}
+
+void Barrier::arriveTree(Int thread, Bool wait) {
+	if (thread < 0)
+		thread = static_cast<Int>(mTreeTickets.fetch_add(1, std::memory_order_relaxed) % static_cast<UInt>(mLimit));
+
+	Bool sense = !mTreeSenses[thread].sense;
+	mTreeSenses[thread].sense = sense;
+
+	Int node = thread / TREE_FAN_IN;
+	while (true) {
+		TreeNode& treeNode = mTreeNodes[node];
+		if (treeNode.count.fetch_add(1, std::memory_order_acq_rel) != treeNode.expected - 1)
+			break;
+		// Last thread at this node, no other thread arrives here before the release
+		treeNode.count.store(0, std::memory_order_relaxed);
+		if (treeNode.parent < 0) {
+			mTreeSense.store(sense, std::memory_order_release);
+			return;
+		}
+		node = treeNode.parent;
+	}
+
+	if (wait) {
+		while (mTreeSense.load(std::memory_order_acquire) != sense)
+			cpuRelax();
+	}
+}
+
 void BarrierTask::addBarrier(Barrier* b) {
 	mBarriers.push_back(b);
 }
 
 void BarrierTask::execute(Real time, Int timeStepCount) {
 	if (mBarriers.size() == 1) {
-		mBarriers[0]->wait();
+		mBarriers[0]->wait(mThread);
 	} else {
 		for (size_t i = 0; i < mBarriers.size()-1; i++) {
-			mBarriers[i]->signal();
+			mBarriers[i]->signal(mThread);
 		}
-		mBarriers[mBarriers.size()-1]->wait();
+		mBarriers[mBarriers.size()-1]->wait(mThread);
 	}
 }
@@ -23,6 +23,7 @@ void SequentialScheduler::createSchedule(const Task::List& tasks, const Edges& i
 	if (mOutMeasurementFile.size() != 0)
 		Scheduler::initMeasurements(tasks);
 	Scheduler::topologicalSort(tasks, inEdges, outEdges, mSchedule);
+	applyThreadPlacement(0);
 
 	for (auto task : mSchedule)
         SPDLOG_LOGGER_INFO(mSLog, "{}", task->toString());
@@ -4,13 +4,18 @@
 #include <iomanip>
 #include <algorithm>
 #include <typeindex>
+#include <thread>
 
+#include <dpsim/AllocationCounter.h>
 #include <dpsim/SequentialScheduler.h>
+#include <dpsim/TaskFusion.h>
 #include <dpsim/Simulation.h>
 #include <dpsim/Utils.h>
 #include <dpsim-models/Utils.h>
 #include <dpsim/MNASolverFactory.h>
 #include <dpsim/PFSolverPowerPolar.h>
+#include <dpsim/PFSolverFastDecoupled.h>
+#include <dpsim/PFSolverDC.h>
 #include <dpsim/DiakopticsSolver.h>
 
 #include <spdlog/sinks/stdout_color_sinks.h>
@@ -100,12 +105,27 @@ void Simulation::createSolvers() {
 			break;
 #endif /* WITH_SUNDIALS */
 		case Solver::Type::NRP:
-			solver = std::make_shared<PFSolverPowerPolar>(**mName, mSystem, **mTimeStep, mLogLevel);
-			solver->doInitFromNodesAndTerminals(mInitFromNodesAndTerminals);
-			solver->setSolverAndComponentBehaviour(mSolverBehaviour);
+		case Solver::Type::FDXB:
+		case Solver::Type::FDBX:
+		case Solver::Type::DCPF:
+		{
+			std::shared_ptr<PFSolver> pfSolver;
+			if (mSolverType == Solver::Type::NRP)
+				pfSolver = std::make_shared<PFSolverPowerPolar>(**mName, mSystem, **mTimeStep, mLogLevel);
+			else if (mSolverType == Solver::Type::DCPF)
+				pfSolver = std::make_shared<PFSolverDC>(**mName, mSystem, **mTimeStep, mLogLevel);
+			else
+				pfSolver = std::make_shared<PFSolverFastDecoupled>(**mName, mSystem, **mTimeStep, mLogLevel,
+					mSolverType == Solver::Type::FDXB ? PFSolverFastDecoupled::Variant::XB : PFSolverFastDecoupled::Variant::BX);
+			pfSolver->doInitFromNodesAndTerminals(mInitFromNodesAndTerminals);
+			pfSolver->setSolverAndComponentBehaviour(mSolverBehaviour);
+			pfSolver->doWarmStart(mPowerflowWarmStart);
+			pfSolver->doJacobianReuse(mPowerflowJacobianReuse);
+			solver = pfSolver;
 			solver->initialize();
 			mSolvers.push_back(solver);
 			break;
+		}
 		default:
 			throw UnsupportedSolverException();
 	}
@@ -156,13 +176,26 @@ void Simulation::createMNASolver() {
 			solver->doFrequencyParallelization(mFreqParallel);
 			solver->setSteadStIniTimeLimit(mSteadStIniTimeLimit);
 			solver->setSteadStIniAccLimit(mSteadStIniAccLimit);
+			solver->setSteadStIniTimeStep(mSteadStIniTimeStep);
+			solver->doSteadStIniAcceleration(mSteadStIniAcceleration);
+			solver->doSteadStIniLogging(mSteadStIniLogging);
 			solver->setSystem(subnets[net]);
 			solver->setSolverAndComponentBehaviour(mSolverBehaviour);
 			solver->doInitFromNodesAndTerminals(mInitFromNodesAndTerminals);
 			solver->doSystemMatrixRecomputation(mSystemMatrixRecomputation);
+			solver->doSparseRightVectorStamping(mSparseRightVectorStamping);
+			solver->doFreezeSystemMatrixPattern(mFreezeSystemMatrixPattern);
+			solver->doLazySwitchFactorization(mLazySwitchFactorization);
+			solver->setSwitchFactorizationCacheSize(mSwitchFactorizationCacheSize);
+			solver->doLowRankSystemMatrixUpdates(mLowRankSystemMatrixUpdates);
+			solver->setMaxLowRankUpdates(mMaxLowRankUpdates);
+			solver->setNumberOfScenarios(mNumScenarios);
+			solver->doVectorizeLinearElements(mVectorizeLinearElements);
 			solver->setDirectLinearSolverConfiguration(mDirectLinearSolverConfiguration);
 			solver->initialize();
 			solver->setMaxNumberOfIterations(mMaxIterations);
+			if (mSwitchPrefactorization)
+				solver->prefactorizeSwitchStates(mEvents.getSwitchStateChanges());
 		}
 		mSolvers.push_back(solver);
 	}
@@ -203,11 +236,23 @@ void Simulation::prepSchedule() {
 		mScheduler = std::make_shared<SequentialScheduler>();
 	}
 	mScheduler->resolveDeps(mTasks, mTaskInEdges, mTaskOutEdges);
+
+	if (mTaskFusion) {
+		UInt parallelism = mTaskFusionParallelism > 0
+			? mTaskFusionParallelism : std::max(std::thread::hardware_concurrency(), 1u);
+		TaskFusion fusion(std::chrono::duration_cast<Scheduler::TaskTime>(std::chrono::duration<Real>(mTaskFusionMinTaskTime)),
+			parallelism, mLogLevel);
+		if (!mTaskFusionMeasurementFile.empty())
+			fusion.readMeasurements(mTaskFusionMeasurementFile);
+		fusion.apply(mTasks, mTaskInEdges, mTaskOutEdges);
+	}
 }
 
 void Simulation::schedule() {
 	SPDLOG_LOGGER_INFO(mLog, "Scheduling tasks.");
 	prepSchedule();
+	if (mThreadPlacementSet)
+		mScheduler->setThreadPlacement(mThreadPlacement);
 	mScheduler->createSchedule(mTasks, mTaskInEdges, mTaskOutEdges);
 	SPDLOG_LOGGER_INFO(mLog, "Scheduling done.");
 }
@@ -355,6 +400,8 @@ void Simulation::stop() {
 	mSimulationEndTimePoint = std::chrono::steady_clock::now();
 	mSimulationCalculationTime = mSimulationEndTimePoint-mSimulationStartTimePoint;
 	SPDLOG_LOGGER_INFO(mLog, "Simulation calculation time: {:.6f}", mSimulationCalculationTime.count());
+	if (AllocationCounter::enabled())
+		SPDLOG_LOGGER_INFO(mLog, "Heap allocations during simulation steps: {}", mStepAllocations);
 
 	mScheduler->stop();
 
@@ -388,7 +435,45 @@ void Simulation::run() {
 	stop();
 }
 
+void Simulation::runPowerflowTimeSeries(String outputFile, UInt numChunks) {
+	if (mSolverType == Solver::Type::MNA || mSolverType == Solver::Type::DAE)
+		throw UnsupportedSolverException();
+
+	if (!mInitialized)
+		initialize();
+
+	// Time points are computed from their index so that the rounding errors
+	// do not add up and every chunk gets the same points as a sequential run
+	std::vector<Real> times;
+	for (UInt step = 0; mTime + step * **mTimeStep < **mFinalTime; ++step)
+		times.push_back(mTime + step * **mTimeStep);
+
+	SPDLOG_LOGGER_INFO(mLog, "Powerflow time series with {} time points", times.size());
+	std::dynamic_pointer_cast<PFSolver>(mSolvers.front())->solveTimeSeries(times, numChunks, outputFile);
+	mTime = **mFinalTime;
+}
+
+std::vector<PFSolver::ContingencyResult> Simulation::runPowerflowContingencies(String reportFile, UInt numThreads,
+	const PFSolver::ContingencyLimits& limits) {
+	if (mSolverType == Solver::Type::MNA || mSolverType == Solver::Type::DAE)
+		throw UnsupportedSolverException();
+
+	if (!mInitialized)
+		initialize();
+
+	auto pfSolver = std::dynamic_pointer_cast<PFSolver>(mSolvers.front());
+	auto contingencies = pfSolver->listN1Contingencies();
+	SPDLOG_LOGGER_INFO(mLog, "Powerflow contingency analysis with {} contingencies", contingencies.size());
+	auto results = pfSolver->solveContingencies(mTime, contingencies, numThreads, limits);
+	if (!reportFile.empty())
+		pfSolver->writeContingencyReport(results, reportFile);
+	return results;
+}
+
 Real Simulation::step() {
+#ifdef WITH_ALLOCATION_COUNTER
+	std::size_t allocations = AllocationCounter::count();
+#endif
 	auto start = std::chrono::steady_clock::now();
 	mEvents.handleEvents(mTime);
 
@@ -398,8 +483,11 @@ Real Simulation::step() {
 	++mTimeStepCount;
 
 	auto end = std::chrono::steady_clock::now();
+#ifdef WITH_ALLOCATION_COUNTER
+	mStepAllocations += AllocationCounter::count() - allocations;
+#endif
 	std::chrono::duration<double> diff = end-start;
-	mStepTimes.push_back(diff.count());
+	mStepTimes.add(diff.count());
 	return mTime;
 }
 
@@ -408,12 +496,15 @@ void Simulation::logStepTimes(String logName) {
 	Logger::setLogPattern(stepTimeLog, "%v");
 	stepTimeLog->info("step_time");
 
-	Real stepTimeSum = 0;
-	for (auto meas : mStepTimes) {
-		stepTimeSum += meas;
+	// Only the most recent measurements are kept, the statistics cover all steps
+	for (auto meas : mStepTimes.samples())
 		stepTimeLog->info("{:.9f}", meas);
-	}
-	SPDLOG_LOGGER_INFO(mLog, "Average step time: {:.9f}", stepTimeSum / mStepTimes.size());
+
+	SPDLOG_LOGGER_INFO(mLog, "Average step time: {:.9f}", mStepTimes.mean());
+	SPDLOG_LOGGER_INFO(mLog, "Minimum step time: {:.9f}", mStepTimes.min());
+	SPDLOG_LOGGER_INFO(mLog, "Maximum step time: {:.9f}", mStepTimes.max());
+	SPDLOG_LOGGER_INFO(mLog, "Step time percentiles (p50/p99/p99.9): {:.9f} / {:.9f} / {:.9f}",
+		mStepTimes.percentile(50), mStepTimes.percentile(99), mStepTimes.percentile(99.9));
 }
 
 void Simulation::logLUTimes() {
@@ -443,6 +534,28 @@ CPS::AttributeBase::Ptr Simulation::getIdObjAttribute(const String &comp, const
 	}
 }
 
+void Simulation::setScenarioRightSideOffsets(const Matrix& offsets, UInt solverIdx) {
+	auto attr = solverIdx < mSolvers.size() ? mSolvers[solverIdx]->scenarioRightSideOffsets() : nullptr;
+	if (!attr.getPtr() || mNumScenarios == 0) {
+		SPDLOG_LOGGER_ERROR(mLog, "Scenarios are not enabled or not supported by solver {}", solverIdx);
+		throw InvalidArgumentException();
+	}
+	if (offsets.rows() != (**attr).rows() || offsets.cols() != (**attr).cols()) {
+		SPDLOG_LOGGER_ERROR(mLog, "Scenario offsets have to be of size {}x{}", (**attr).rows(), (**attr).cols());
+		throw InvalidArgumentException();
+	}
+	**attr = offsets;
+}
+
+const Matrix& Simulation::scenarioLeftSideVectors(UInt solverIdx) const {
+	auto attr = solverIdx < mSolvers.size() ? mSolvers[solverIdx]->scenarioLeftSideVectors() : nullptr;
+	if (!attr.getPtr() || mNumScenarios == 0) {
+		SPDLOG_LOGGER_ERROR(mLog, "Scenarios are not enabled or not supported by solver {}", solverIdx);
+		throw InvalidArgumentException();
+	}
+	return **attr;
+}
+
 void Simulation::logIdObjAttribute(const String &comp, const String &attr) {
 	CPS::AttributeBase::Ptr attrPtr = getIdObjAttribute(comp, attr);
 	String name = comp + "." + attr;
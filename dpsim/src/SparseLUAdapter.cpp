@@ -40,4 +40,95 @@ namespace DPsim
     {
         return LUFactorizedSparse.solve(mRightHandSideVector);
     }
+
+    void SparseLUAdapter::solveInPlace(const Matrix& rightSideVector, Matrix& solution)
+    {
+		/* Eigen's solve allocates a work matrix for the lower factor and a mask for permuting
+		 * in place, so the substitution is done with buffers that keep their size between calls */
+        solution = LUFactorizedSparse.rowsPermutation() * rightSideVector;
+        substitute(solution);
+    }
+
+    void SparseLUAdapter::solveBatch(Matrix& rightSideVectors)
+    {
+        auto buffer = permutationBuffer(rightSideVectors.rows(), rightSideVectors.cols());
+        buffer = LUFactorizedSparse.rowsPermutation() * rightSideVectors;
+        rightSideVectors = buffer;
+        substitute(rightSideVectors);
+    }
+
+    void SparseLUAdapter::substitute(Matrix& solution)
+    {
+        solveLowerInPlace(solution);
+        LUFactorizedSparse.matrixU().solveInPlace(solution);
+        auto buffer = permutationBuffer(solution.rows(), solution.cols());
+        buffer = LUFactorizedSparse.colsPermutation().inverse() * solution;
+        solution = buffer;
+    }
+
+    Eigen::Block<Matrix, Eigen::Dynamic, Eigen::Dynamic, true> SparseLUAdapter::permutationBuffer(Eigen::Index rows, Eigen::Index cols)
+    {
+		/* Single solutions and blocks of scenarios alternate, so the buffer only grows */
+        if (mPermutationBuffer.rows() != rows || mPermutationBuffer.cols() < cols)
+            mPermutationBuffer.resize(rows, std::max(cols, mPermutationBuffer.cols()));
+        return mPermutationBuffer.leftCols(cols);
+    }
+
+    void SparseLUAdapter::solveLowerInPlace(Matrix& solution)
+    {
+#if EIGEN_VERSION_AT_LEAST(3,4,0) && !EIGEN_VERSION_AT_LEAST(3,4,90)
+		/* Same as MappedSuperNodalMatrix::solveInPlace of Eigen 3.4 apart from the work matrix.
+		 * It reads m_mapL, which is not part of the documented interface, so other Eigen
+		 * versions use Eigen's own solve, which allocates its work matrix in every call */
+        const auto& lower = LUFactorizedSparse.matrixL().m_mapL;
+        using SupernodalMatrix = std::decay_t<decltype(lower)>;
+        const Eigen::Index n = solution.rows();
+        const Eigen::Index nrhs = solution.cols();
+        if (mWork.rows() != n || mWork.cols() < nrhs)
+            mWork.resize(n, std::max(nrhs, mWork.cols()));
+
+        const Real* values = lower.valuePtr();
+        for (Eigen::Index k = 0; k <= lower.nsuper(); ++k)
+        {
+            Eigen::Index fsupc = lower.supToCol()[k];
+            Eigen::Index istart = lower.rowIndexPtr()[fsupc];
+            Eigen::Index nsupr = lower.rowIndexPtr()[fsupc + 1] - istart;
+            Eigen::Index nsupc = lower.supToCol()[k + 1] - fsupc;
+            Eigen::Index nrow = nsupr - nsupc;
+
+            if (nsupc == 1)
+            {
+                for (Eigen::Index j = 0; j < nrhs; ++j)
+                {
+                    typename SupernodalMatrix::InnerIterator it(lower, fsupc);
+                    /* skip the diagonal element */
+                    ++it;
+                    for (; it; ++it)
+                        solution(it.row(), j) -= solution(fsupc, j) * it.value();
+                }
+            }
+            else
+            {
+                /* triangular solve with the diagonal block of the supernode */
+                Eigen::Index luptr = lower.colIndexPtr()[fsupc];
+                Eigen::Index lda = lower.colIndexPtr()[fsupc + 1] - luptr;
+                Eigen::Map<const Matrix, 0, Eigen::OuterStride<>> diagonal(values + luptr, nsupc, nsupc, Eigen::OuterStride<>(lda));
+                Eigen::Map<Matrix, 0, Eigen::OuterStride<>> block(&solution(fsupc, 0), nsupc, nrhs, Eigen::OuterStride<>(n));
+                diagonal.triangularView<Eigen::UnitLower>().solveInPlace(block);
+
+                /* product with the rows below the diagonal block and scatter */
+                Eigen::Map<const Matrix, 0, Eigen::OuterStride<>> below(values + luptr + nsupc, nrow, nsupc, Eigen::OuterStride<>(lda));
+                mWork.topLeftCorner(nrow, nrhs).noalias() = below * block;
+                for (Eigen::Index j = 0; j < nrhs; ++j)
+                {
+                    Eigen::Index iptr = istart + nsupc;
+                    for (Eigen::Index i = 0; i < nrow; ++i, ++iptr)
+                        solution(lower.rowIndex()[iptr], j) -= mWork(i, j);
+                }
+            }
+        }
+#else
+        LUFactorizedSparse.matrixL().solveInPlace(solution);
+#endif
+    }
 }
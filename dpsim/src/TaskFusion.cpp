@@ -0,0 +1,251 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/TaskFusion.h>
+
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <unordered_set>
+
+using namespace CPS;
+using namespace DPsim;
+
+FusedTask::FusedTask(const Task::List& tasks) {
+	for (auto& task : tasks) {
+		// Keep the task list flat if fused tasks are fused again
+		auto fused = std::dynamic_pointer_cast<FusedTask>(task);
+		if (fused)
+			mTasks.insert(mTasks.end(), fused->tasks().begin(), fused->tasks().end());
+		else
+			mTasks.push_back(task);
+	}
+
+	mName = mTasks.front()->toString();
+	if (mTasks.size() > 1)
+		mName += " + " + std::to_string(mTasks.size() - 1) + " fused";
+
+	auto appendUnique = [](std::vector<AttributeBase::Ptr>& list, const std::vector<AttributeBase::Ptr>& attrs) {
+		for (auto& attr : attrs) {
+			auto it = std::find_if(list.begin(), list.end(),
+				[&attr](const AttributeBase::Ptr& other) { return other.getPtr() == attr.getPtr(); });
+			if (it == list.end())
+				list.push_back(attr);
+		}
+	};
+	for (auto& task : mTasks) {
+		appendUnique(mAttributeDependencies, task->getAttributeDependencies());
+		appendUnique(mModifiedAttributes, task->getModifiedAttributes());
+		appendUnique(mPrevStepDependencies, task->getPrevStepDependencies());
+	}
+}
+
+TaskFusion::TaskFusion(Scheduler::TaskTime minTaskTime, UInt parallelism, CPS::Logger::Level logLevel) :
+	mMinTaskTime(minTaskTime),
+	mParallelism(parallelism > 0 ? parallelism : 1),
+	mSLog(CPS::Logger::get("task_fusion", logLevel)) {
+}
+
+void TaskFusion::readMeasurements(String filename) {
+	mMeasurements.clear();
+	Scheduler::readMeasurements(filename, mMeasurements);
+}
+
+Scheduler::TaskTime::rep TaskFusion::cost(const Task::Ptr& task) {
+	auto fused = mFusedCosts.find(task.get());
+	if (fused != mFusedCosts.end())
+		return fused->second;
+
+	auto measured = mMeasurements.find(task->toString());
+	return measured != mMeasurements.end() ? measured->second : 0;
+}
+
+/// Predecessors or successors of a task without duplicates, sorted by address
+static std::vector<Task*> neighbours(const Scheduler::Edges& edges, const Task::Ptr& task) {
+	std::vector<Task*> result;
+	auto it = edges.find(task);
+	if (it != edges.end()) {
+		for (auto& other : it->second)
+			result.push_back(other.get());
+	}
+	std::sort(result.begin(), result.end());
+	result.erase(std::unique(result.begin(), result.end()), result.end());
+	return result;
+}
+
+Task::Ptr TaskFusion::fuse(const Task::List& group, Task::List& tasks, Scheduler::Edges& inEdges, Scheduler::Edges& outEdges) {
+	auto fused = std::make_shared<FusedTask>(group);
+
+	std::unordered_set<Task::Ptr> members(group.begin(), group.end());
+	Scheduler::TaskTime::rep fusedCost = 0;
+	for (auto& task : group)
+		fusedCost += cost(task);
+	mFusedCosts[fused.get()] = fusedCost;
+
+	// Collect the external neighbours of the group
+	Task::List before, after;
+	for (auto& task : group) {
+		for (auto& pred : inEdges[task]) {
+			if (!members.count(pred) && std::find(before.begin(), before.end(), pred) == before.end())
+				before.push_back(pred);
+		}
+		for (auto& succ : outEdges[task]) {
+			if (!members.count(succ) && std::find(after.begin(), after.end(), succ) == after.end())
+				after.push_back(succ);
+		}
+	}
+
+	// Redirect the edges of the neighbours to the fused task
+	auto redirect = [&members, &fused](std::deque<Task::Ptr>& list) {
+		list.erase(std::remove_if(list.begin(), list.end(),
+			[&members](const Task::Ptr& task) { return members.count(task) > 0; }), list.end());
+		list.push_back(fused);
+	};
+	for (auto& pred : before)
+		redirect(outEdges[pred]);
+	for (auto& succ : after)
+		redirect(inEdges[succ]);
+
+	for (auto& task : group) {
+		inEdges.erase(task);
+		outEdges.erase(task);
+	}
+	inEdges[fused] = std::deque<Task::Ptr>(before.begin(), before.end());
+	outEdges[fused] = std::deque<Task::Ptr>(after.begin(), after.end());
+
+	// The fused task takes the place of the first member in the task list
+	auto first = std::find_if(tasks.begin(), tasks.end(),
+		[&members](const Task::Ptr& task) { return members.count(task) > 0; });
+	*first = fused;
+	tasks.erase(std::remove_if(first + 1, tasks.end(),
+		[&members](const Task::Ptr& task) { return members.count(task) > 0; }), tasks.end());
+
+	return fused;
+}
+
+UInt TaskFusion::fuseChains(Task::List& tasks, Scheduler::Edges& inEdges, Scheduler::Edges& outEdges) {
+	std::unordered_map<Task*, Task::Ptr> byPtr;
+	for (auto& task : tasks)
+		byPtr[task.get()] = task;
+
+	std::deque<Task::Ptr> queue(tasks.begin(), tasks.end());
+	std::unordered_set<Task*> removed;
+	UInt count = 0;
+
+	while (!queue.empty()) {
+		Task::Ptr task = queue.front();
+		queue.pop_front();
+		if (removed.count(task.get()) || std::dynamic_pointer_cast<Scheduler::Root>(task))
+			continue;
+
+		auto successors = neighbours(outEdges, task);
+		if (successors.size() != 1)
+			continue;
+		Task::Ptr next = byPtr[successors[0]];
+		if (std::dynamic_pointer_cast<Scheduler::Root>(next))
+			continue;
+		auto predecessors = neighbours(inEdges, next);
+		if (predecessors.size() != 1)
+			continue;
+
+		auto fused = fuse({ task, next }, tasks, inEdges, outEdges);
+		removed.insert(task.get());
+		removed.insert(next.get());
+		byPtr[fused.get()] = fused;
+		queue.push_back(fused);
+		++count;
+	}
+	return count;
+}
+
+UInt TaskFusion::fuseSiblings(Task::List& tasks, Scheduler::Edges& inEdges, Scheduler::Edges& outEdges) {
+	// Tasks with the same predecessors and successors can be executed in any order
+	std::map<std::pair<std::vector<Task*>, std::vector<Task*>>, Task::List> siblings;
+	for (auto& task : tasks) {
+		if (std::dynamic_pointer_cast<Scheduler::Root>(task))
+			continue;
+		auto successors = neighbours(outEdges, task);
+		// Tasks without successors are dropped by the schedulers
+		if (successors.empty())
+			continue;
+		siblings[{ neighbours(inEdges, task), successors }].push_back(task);
+	}
+
+	UInt count = 0;
+	for (auto& entry : siblings) {
+		Task::List small;
+		for (auto& task : entry.second) {
+			if (cost(task) < mMinTaskTime.count())
+				small.push_back(task);
+		}
+		if (small.size() < 2)
+			continue;
+
+		Scheduler::TaskTime::rep total = 0;
+		for (auto& task : small)
+			total += cost(task);
+
+		// Each group should reach the minimum task time, but there have to be
+		// enough groups to keep all threads busy
+		std::size_t numGroups = std::max<std::size_t>(mParallelism,
+			mMinTaskTime.count() > 0 ? static_cast<std::size_t>(total / mMinTaskTime.count()) : 0);
+		numGroups = std::min(numGroups, small.size());
+		if (numGroups == small.size())
+			continue;
+
+		// Longest processing time first, ties are distributed by number of tasks
+		Task::List byCost = small;
+		std::stable_sort(byCost.begin(), byCost.end(),
+			[this](const Task::Ptr& a, const Task::Ptr& b) { return cost(a) > cost(b); });
+
+		std::vector<Task::List> groups(numGroups);
+		std::vector<Scheduler::TaskTime::rep> loads(numGroups, 0);
+		for (auto& task : byCost) {
+			std::size_t target = 0;
+			for (std::size_t g = 1; g < numGroups; ++g) {
+				if (loads[g] < loads[target] || (loads[g] == loads[target] && groups[g].size() < groups[target].size()))
+					target = g;
+			}
+			groups[target].push_back(task);
+			loads[target] += cost(task);
+		}
+
+		std::unordered_map<Task*, std::size_t> order;
+		for (std::size_t i = 0; i < small.size(); ++i)
+			order[small[i].get()] = i;
+
+		for (auto& group : groups) {
+			if (group.size() < 2)
+				continue;
+			// Keep the original order within a group
+			std::sort(group.begin(), group.end(),
+				[&order](const Task::Ptr& a, const Task::Ptr& b) { return order[a.get()] < order[b.get()]; });
+			fuse(group, tasks, inEdges, outEdges);
+			++count;
+		}
+	}
+	return count;
+}
+
+void TaskFusion::apply(Task::List& tasks, Scheduler::Edges& inEdges, Scheduler::Edges& outEdges) {
+	std::size_t numTasks = tasks.size();
+	UInt chains = 0, groups = 0;
+
+	// Fusing siblings can create new chains and vice versa
+	while (true) {
+		UInt fusedChains = fuseChains(tasks, inEdges, outEdges);
+		UInt fusedGroups = fuseSiblings(tasks, inEdges, outEdges);
+		chains += fusedChains;
+		groups += fusedGroups;
+		if (fusedChains == 0 && fusedGroups == 0)
+			break;
+	}
+
+	SPDLOG_LOGGER_INFO(mSLog, "Fused {:d} chains and {:d} sibling groups, {:d} of {:d} tasks left",
+		chains, groups, tasks.size(), numTasks);
+}
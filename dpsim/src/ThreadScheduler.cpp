@@ -14,7 +14,8 @@ using namespace CPS;
 using namespace DPsim;
 
 ThreadScheduler::ThreadScheduler(Int threads, String outMeasurementFile, Bool useConditionVariable) :
-	mNumThreads(threads), mOutMeasurementFile(outMeasurementFile), mStartBarrier(threads, useConditionVariable) {
+	mNumThreads(threads), mOutMeasurementFile(outMeasurementFile),
+	mStartBarrier(threads, useConditionVariable), mSetupBarrier(threads, useConditionVariable) {
 	if (threads < 1)
 		throw SchedulingException();
 	mTempSchedules.resize(threads);
@@ -30,22 +31,30 @@ void ThreadScheduler::scheduleTask(int thread, CPS::Task::Ptr task) {
 	mTempSchedules[thread].push_back(task);
 }
 
+void ThreadScheduler::allocateSchedule(Int thread) {
+	mSchedules[thread] = new ScheduleEntry[mTempSchedules[thread].size()];
+	for (size_t i = 0; i < mTempSchedules[thread].size(); i++)
+		mSchedules[thread][i].task = mTempSchedules[thread][i].get();
+}
+
 void ThreadScheduler::finishSchedule(const Edges& inEdges) {
+	// With NUMA-local placement, every thread allocates its own schedule entries
+	if (!mPlacement.numaLocal) {
+		for (int thread = 0; thread < mNumThreads; thread++)
+			allocateSchedule(thread);
+	}
+	for (int i = 1; i < mNumThreads; i++) {
+		mThreads.emplace_back(threadFunction, this, i);
+	}
+	applyThreadPlacement(0);
+	if (mPlacement.numaLocal)
+		allocateSchedule(0);
+	mSetupBarrier.wait(0);
+
 	std::map<CPS::Task::Ptr, Counter*> counters;
 	for (int thread = 0; thread < mNumThreads; thread++) {
-	//	std::cout << "Thread " << thread << std::endl;
-	//	for (auto& entry : mSchedules[thread]) {
-	//		Task* t = entry.task.get();
-	//		char *refpos = reinterpret_cast<char*>(reinterpret_cast<void*>(t)) + sizeof(Task);
-	//		void *ref = *(reinterpret_cast<void**>(refpos));
-	//		std::cout << entry.task->toString() << " " << ref << std::endl;
-	//	}
-		mSchedules[thread] = new ScheduleEntry[mTempSchedules[thread].size()];
-		for (size_t i = 0; i < mTempSchedules[thread].size(); i++) {
-			auto& task = mTempSchedules[thread][i];
-			mSchedules[thread][i].task = task.get();
-			counters[task] = &mSchedules[thread][i].endCounter;
-		}
+		for (size_t i = 0; i < mTempSchedules[thread].size(); i++)
+			counters[mTempSchedules[thread][i]] = &mSchedules[thread][i].endCounter;
 	}
 	for (int thread = 0; thread < mNumThreads; thread++) {
 		for (size_t i = 0; i < mTempSchedules[thread].size(); i++) {
@@ -57,15 +66,12 @@ void ThreadScheduler::finishSchedule(const Edges& inEdges) {
 			}
 		}
 	}
-	for (int i = 1; i < mNumThreads; i++) {
-		mThreads.emplace_back(threadFunction, this, i);
-	}
 }
 
 void ThreadScheduler::step(Real time, Int timeStepCount) {
 	mTime = time;
 	mTimeStepCount = timeStepCount;
-	mStartBarrier.wait();
+	mStartBarrier.wait(0);
 	doStep(0);
 	// since we don't have a final BarrierTask, wait for all threads to finish
 	// their last task explicitly
@@ -78,7 +84,7 @@ void ThreadScheduler::step(Real time, Int timeStepCount) {
 void ThreadScheduler::stop() {
 	if (!mThreads.empty()) {
 		mJoining = true;
-		mStartBarrier.wait();
+		mStartBarrier.wait(0);
 		for (size_t thread = 0; thread < mThreads.size(); thread++) {
 			mThreads[thread].join();
 		}
@@ -89,8 +95,13 @@ void ThreadScheduler::stop() {
 }
 
 void ThreadScheduler::threadFunction(ThreadScheduler* sched, Int idx) {
+	sched->applyThreadPlacement(idx);
+	if (sched->mPlacement.numaLocal)
+		sched->allocateSchedule(idx);
+	sched->mSetupBarrier.wait(idx);
+
 	while (true) {
-		sched->mStartBarrier.wait();
+		sched->mStartBarrier.wait(idx);
 		if (sched->mJoining)
 			return;
 
@@ -0,0 +1,105 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+
+#include <dpsim/TimingStatistics.h>
+
+using namespace DPsim;
+
+TimingStatistics::TimingStatistics(UInt capacity) :
+	mSamples(std::max<UInt>(capacity, 1)) {
+	reset();
+}
+
+void TimingStatistics::reset() {
+	mNext = 0;
+	mCount = 0;
+	mSum = 0;
+	mMin = 0;
+	mMax = 0;
+	mHistogram.fill(0);
+}
+
+void TimingStatistics::add(Real time) {
+	mSamples[mNext] = time;
+	mNext = (mNext + 1) % mSamples.size();
+
+	if (mCount == 0 || time < mMin)
+		mMin = time;
+	if (mCount == 0 || time > mMax)
+		mMax = time;
+	mSum += time;
+	++mCount;
+
+	Real nanoseconds = std::round(time * 1e9);
+	std::uint64_t value = nanoseconds > 0 ? static_cast<std::uint64_t>(nanoseconds) : 0;
+	value = std::min(value, (std::uint64_t(1) << MAX_EXPONENT) - 1);
+	++mHistogram[bucketIndex(value)];
+}
+
+UInt TimingStatistics::bucketIndex(std::uint64_t nanoseconds) {
+	// Values below 2 * SUB_BUCKETS get a bucket of their own. Above, every
+	// power of two is split into SUB_BUCKETS buckets of equal width.
+	UInt msb = 0;
+#if defined(__GNUC__) || defined(__clang__)
+	if (nanoseconds != 0)
+		msb = 63 - __builtin_clzll(nanoseconds);
+#else
+	for (std::uint64_t v = nanoseconds; v >>= 1;)
+		++msb;
+#endif
+	UInt shift = msb > SUB_BUCKET_BITS ? msb - SUB_BUCKET_BITS : 0;
+	return shift * SUB_BUCKETS + static_cast<UInt>(nanoseconds >> shift);
+}
+
+std::uint64_t TimingStatistics::bucketUpperBound(UInt index) {
+	if (index < 2 * SUB_BUCKETS)
+		return index;
+	UInt shift = index / SUB_BUCKETS - 1;
+	std::uint64_t subBucket = index - shift * SUB_BUCKETS;
+	return ((subBucket + 1) << shift) - 1;
+}
+
+Real TimingStatistics::percentile(Real p) const {
+	if (mCount == 0)
+		return 0;
+
+	p = std::min(std::max(p, 0.), 100.);
+	// Rank of the requested measurement, starting at one
+	std::uint64_t rank = std::max<std::uint64_t>(1,
+		static_cast<std::uint64_t>(std::ceil(p / 100. * mCount)));
+
+	std::uint64_t cumulative = 0;
+	for (UInt idx = 0; idx < NUM_BUCKETS; ++idx) {
+		cumulative += mHistogram[idx];
+		if (cumulative >= rank) {
+			// The bucket bound can lie outside of the observed range
+			Real value = bucketUpperBound(idx) * 1e-9;
+			return std::min(std::max(value, mMin), mMax);
+		}
+	}
+	return mMax;
+}
+
+Real TimingStatistics::last() const {
+	if (mCount == 0)
+		return 0;
+	return mSamples[(mNext + mSamples.size() - 1) % mSamples.size()];
+}
+
+std::vector<Real> TimingStatistics::samples() const {
+	UInt size = static_cast<UInt>(std::min<std::uint64_t>(mCount, mSamples.size()));
+	std::vector<Real> samples;
+	samples.reserve(size);
+	UInt start = (mNext + mSamples.size() - size) % mSamples.size();
+	for (UInt idx = 0; idx < size; ++idx)
+		samples.push_back(mSamples[(start + idx) % mSamples.size()]);
+	return samples;
+}
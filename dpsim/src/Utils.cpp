@@ -53,10 +53,14 @@ CommandLineArgs::CommandLineArgs(int argc, char *argv[],
 		{ "start-at",		required_argument,	0, 'a', "ISO8601", "Start time of real-time simulation" },
 		{ "start-in",		required_argument,	0, 'i', "SECS", "" },
 		{ "solver-domain",	required_argument,	0, 'D', "(SP|DP|EMT)", "Domain of solver" },
-		{ "solver-type",	required_argument,	0, 'T', "(NRP|MNA)", "Type of solver" },
+		{ "solver-type",	required_argument,	0, 'T', "(NRP|FDXB|FDBX|DCPF|MNA)", "Type of solver" },
 		{ "linear-solver-impl", required_argument, 0, 'U', "(DenseLU|SparseLU|KLU|CUDADense|CUDASparse)", "Type of direct linear solver implementation"},
 		{ "option",		required_argument,	0, 'o', "KEY=VALUE", "User-definable options" },
 		{ "name",		required_argument,	0, 'n', "NAME", "Name of log files" },
+		{ "cpus",		required_argument,	0, 'C', "LIST", "CPU sets of the scheduler threads, e.g. 0,1 or 0-3,4-7" },
+		{ "rt-priority",	required_argument,	0, 'R', "PRIO", "SCHED_FIFO priority of the scheduler threads" },
+		{ "numa-local",		no_argument,		0, 'N', NULL, "Allocate schedule data on the NUMA node of each thread" },
+		{ "mlock",		no_argument,		0, 'M', NULL, "Lock the memory of the process" },
 		{ "params",		required_argument,	0, 'p', "PATH", "Json file containing parametrization"},
 		{ 0 }
 	},
@@ -108,10 +112,14 @@ CommandLineArgs::CommandLineArgs(
 		{ "start-at",		required_argument,	0, 'a', "ISO8601", "Start time of real-time simulation" },
 		{ "start-in",		required_argument,	0, 'i', "SECS", "" },
 		{ "solver-domain",	required_argument,	0, 'D', "(SP|DP|EMT)", "Domain of solver" },
-		{ "solver-type",	required_argument,	0, 'T', "(NRP|MNA)", "Type of solver" },
+		{ "solver-type",	required_argument,	0, 'T', "(NRP|FDXB|FDBX|DCPF|MNA)", "Type of solver" },
 		{ "linear-solver-impl", required_argument, 0, 'U', "(DenseLU|SparseLU|KLU|CUDADense|CUDASparse)", "Type of direct linear solver implementation"},
 		{ "option",		required_argument,	0, 'o', "KEY=VALUE", "User-definable options" },
 		{ "name",		required_argument,	0, 'n', "NAME", "Name of log files" },
+		{ "cpus",		required_argument,	0, 'C', "LIST", "CPU sets of the scheduler threads, e.g. 0,1 or 0-3,4-7" },
+		{ "rt-priority",	required_argument,	0, 'R', "PRIO", "SCHED_FIFO priority of the scheduler threads" },
+		{ "numa-local",		no_argument,		0, 'N', NULL, "Allocate schedule data on the NUMA node of each thread" },
+		{ "mlock",		no_argument,		0, 'M', NULL, "Lock the memory of the process" },
 		{ 0 }
 	},
 	timeStep(dt),
@@ -142,7 +150,7 @@ void CommandLineArgs::parseArguments(int argc, char *argv[])
 		/* getopt_long stores the option index here. */
 		int option_index = 0;
 
-		c = getopt_long(argc, argv, "ht:d:s:l:a:i:f:D:P:T:U:o:Sbn:", long_options.data(), &option_index);
+		c = getopt_long(argc, argv, "ht:d:s:l:a:i:f:D:P:T:U:o:Sbn:C:R:NM", long_options.data(), &option_index);
 
 		/* Detect the end of the options. */
 		if (c == -1)
@@ -228,8 +236,14 @@ void CommandLineArgs::parseArguments(int argc, char *argv[])
 					solver.type = Solver::Type::MNA;
 				else if (arg == "NRP")
 					solver.type = Solver::Type::NRP;
+				else if (arg == "FDXB")
+					solver.type = Solver::Type::FDXB;
+				else if (arg == "FDBX")
+					solver.type = Solver::Type::FDBX;
+				else if (arg == "DCPF")
+					solver.type = Solver::Type::DCPF;
 				else
-					throw std::invalid_argument("Invalid value for --solver-type: must be a string of NRP or MNA");
+					throw std::invalid_argument("Invalid value for --solver-type: must be a string of NRP, FDXB, FDBX, DCPF or MNA");
 				break;
 			}
 			case 'U': {
@@ -290,6 +304,22 @@ void CommandLineArgs::parseArguments(int argc, char *argv[])
 				params = optarg;
 				break;
 
+			case 'C':
+				threadPlacement.cpuSets = Scheduler::ThreadPlacement::parseCpuSets(optarg);
+				break;
+
+			case 'R':
+				threadPlacement.priority = std::stoi(optarg);
+				break;
+
+			case 'N':
+				threadPlacement.numaLocal = true;
+				break;
+
+			case 'M':
+				threadPlacement.lockMemory = true;
+				break;
+
 			case 'h':
 				showUsage();
 				exit(0);
@@ -0,0 +1,192 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/WorkStealingScheduler.h>
+
+#include <algorithm>
+#include <unordered_map>
+
+using namespace CPS;
+using namespace DPsim;
+
+void WorkStealingScheduler::TaskQueue::push(UInt task) {
+	lock();
+	mTasks[mTail % mTasks.size()] = task;
+	++mTail;
+	unlock();
+}
+
+Bool WorkStealingScheduler::TaskQueue::pop(UInt& task) {
+	lock();
+	Bool found = mHead != mTail;
+	if (found) {
+		--mTail;
+		task = mTasks[mTail % mTasks.size()];
+	}
+	unlock();
+	return found;
+}
+
+Bool WorkStealingScheduler::TaskQueue::steal(UInt& task) {
+	lock();
+	Bool found = mHead != mTail;
+	if (found) {
+		task = mTasks[mHead % mTasks.size()];
+		++mHead;
+	}
+	unlock();
+	return found;
+}
+
+WorkStealingScheduler::WorkStealingScheduler(Int threads, String outMeasurementFile, Bool pinThreads, Bool useConditionVariable) :
+	mNumThreads(threads), mOutMeasurementFile(outMeasurementFile), mPinThreads(pinThreads),
+	mStartBarrier(threads, useConditionVariable), mEndBarrier(threads, useConditionVariable) {
+	if (threads < 1)
+		throw SchedulingException();
+}
+
+WorkStealingScheduler::~WorkStealingScheduler() {
+	// Threads are usually joined by stop(), but the simulation might not have been stopped
+	if (!mThreads.empty())
+		stop();
+}
+
+void WorkStealingScheduler::createSchedule(const Task::List& tasks, const Edges& inEdges, const Edges& outEdges) {
+	Task::List ordered;
+	Scheduler::topologicalSort(tasks, inEdges, outEdges, ordered);
+
+	std::unordered_map<Task::Ptr, UInt> indices;
+	for (UInt i = 0; i < ordered.size(); ++i)
+		indices[ordered[i]] = i;
+
+	mTasks.clear();
+	mSuccessors.assign(ordered.size(), {});
+	mNumPredecessors.assign(ordered.size(), 0);
+	mInitialTasks.clear();
+
+	for (UInt i = 0; i < ordered.size(); ++i) {
+		mTasks.push_back(ordered[i].get());
+		// Edges to dropped tasks and the root task are not relevant for the step
+		if (outEdges.find(ordered[i]) != outEdges.end()) {
+			for (auto& after : outEdges.at(ordered[i])) {
+				auto it = indices.find(after);
+				if (it == indices.end())
+					continue;
+				mSuccessors[i].push_back(it->second);
+				++mNumPredecessors[it->second];
+			}
+		}
+	}
+	for (UInt i = 0; i < ordered.size(); ++i) {
+		if (mNumPredecessors[i] == 0)
+			mInitialTasks.push_back(i);
+	}
+
+	mPendingPredecessors = std::make_unique<std::atomic<Int>[]>(ordered.size());
+	mQueues = std::make_unique<TaskQueue[]>(mNumThreads);
+	for (Int thread = 0; thread < mNumThreads; ++thread)
+		mQueues[thread].reserve(std::max<UInt>(static_cast<UInt>(ordered.size()), 1));
+
+	if (!mOutMeasurementFile.empty())
+		Scheduler::initMeasurements(ordered);
+
+	SPDLOG_LOGGER_INFO(mSLog, "Work stealing schedule with {} tasks, {} initially ready, on {} threads",
+		mTasks.size(), mInitialTasks.size(), mNumThreads);
+
+	// Pin every thread to its own core unless a placement has been set explicitly
+	if (mPinThreads && mPlacement.cpuSets.empty()) {
+		Int numCores = std::max<Int>(std::thread::hardware_concurrency(), 1);
+		for (Int i = 0; i < mNumThreads; i++)
+			mPlacement.cpuSets.push_back({ i % numCores });
+	}
+
+	for (Int i = 1; i < mNumThreads; i++)
+		mThreads.emplace_back(threadFunction, this, i);
+	// The simulation thread executes the tasks of the first queue
+	applyThreadPlacement(0);
+}
+
+void WorkStealingScheduler::step(Real time, Int timeStepCount) {
+	mTime = time;
+	mTimeStepCount = timeStepCount;
+
+	for (UInt i = 0; i < mTasks.size(); ++i)
+		mPendingPredecessors[i].store(mNumPredecessors[i], std::memory_order_relaxed);
+	mRemainingTasks.store(static_cast<UInt>(mTasks.size()), std::memory_order_relaxed);
+	// The other threads wait at the start barrier and all queues are empty after the last step
+	for (Int thread = 0; thread < mNumThreads; ++thread)
+		mQueues[thread].reset();
+	for (UInt i = 0; i < mInitialTasks.size(); ++i)
+		mQueues[i % mNumThreads].push(mInitialTasks[i]);
+
+	mStartBarrier.wait(0);
+	doStep(0);
+	mEndBarrier.wait(0);
+}
+
+void WorkStealingScheduler::stop() {
+	if (!mThreads.empty()) {
+		mJoining = true;
+		mStartBarrier.wait(0);
+		for (auto& thread : mThreads)
+			thread.join();
+		mThreads.clear();
+	}
+	if (!mOutMeasurementFile.empty()) {
+		writeMeasurements(mOutMeasurementFile);
+	}
+}
+
+void WorkStealingScheduler::threadFunction(WorkStealingScheduler* sched, Int idx) {
+	sched->applyThreadPlacement(idx);
+
+	while (true) {
+		sched->mStartBarrier.wait(idx);
+		if (sched->mJoining)
+			return;
+
+		sched->doStep(idx);
+		sched->mEndBarrier.wait(idx);
+	}
+}
+
+void WorkStealingScheduler::doStep(Int thread) {
+	UInt task;
+	while (mRemainingTasks.load(std::memory_order_acquire) > 0) {
+		if (mQueues[thread].pop(task)) {
+			runTask(thread, task);
+			continue;
+		}
+		// Steal from the other threads, starting with the next one
+		Bool stolen = false;
+		for (Int i = 1; i < mNumThreads && !stolen; ++i)
+			stolen = mQueues[(thread + i) % mNumThreads].steal(task);
+		if (stolen)
+			runTask(thread, task);
+		else
+			std::this_thread::yield();
+	}
+}
+
+void WorkStealingScheduler::runTask(Int thread, UInt task) {
+	if (mOutMeasurementFile.empty()) {
+		mTasks[task]->execute(mTime, mTimeStepCount);
+	} else {
+		auto start = std::chrono::steady_clock::now();
+		mTasks[task]->execute(mTime, mTimeStepCount);
+		auto end = std::chrono::steady_clock::now();
+		updateMeasurement(mTasks[task], end-start);
+	}
+
+	for (UInt after : mSuccessors[task]) {
+		// The last finished predecessor makes the task ready
+		if (mPendingPredecessors[after].fetch_sub(1, std::memory_order_acq_rel) == 1)
+			mQueues[thread].push(after);
+	}
+	mRemainingTasks.fetch_sub(1, std::memory_order_release);
+}
@@ -76,6 +76,52 @@ PYBIND11_MODULE(dpsimpy, m) {
 		.def("get_partial_refactorization_method", &DPsim::DirectLinearSolverConfiguration::getPartialRefactorizationMethod)
 		.def("get_btf", &DPsim::DirectLinearSolverConfiguration::getBTF);
 
+	py::class_<DPsim::TimingStatistics>(m, "TimingStatistics")
+		.def("count", &DPsim::TimingStatistics::count)
+		.def("sum", &DPsim::TimingStatistics::sum)
+		.def("min", &DPsim::TimingStatistics::min)
+		.def("max", &DPsim::TimingStatistics::max)
+		.def("mean", &DPsim::TimingStatistics::mean)
+		.def("last", &DPsim::TimingStatistics::last)
+		.def("percentile", &DPsim::TimingStatistics::percentile, "p"_a)
+		.def("samples", &DPsim::TimingStatistics::samples);
+
+	py::class_<DPsim::SwitchFactorizationStatistics>(m, "SwitchFactorizationStatistics")
+		.def_readonly("on_demand", &DPsim::SwitchFactorizationStatistics::onDemand)
+		.def_readonly("prefactorized", &DPsim::SwitchFactorizationStatistics::prefactorized)
+		.def_readonly("prefactorization_hits", &DPsim::SwitchFactorizationStatistics::prefactorizationHits)
+		.def_readonly("evictions", &DPsim::SwitchFactorizationStatistics::evictions);
+
+	py::class_<DPsim::Scheduler::ThreadPlacement>(m, "ThreadPlacement")
+		.def(py::init<>())
+		.def_readwrite("cpu_sets", &DPsim::Scheduler::ThreadPlacement::cpuSets)
+		.def_readwrite("priority", &DPsim::Scheduler::ThreadPlacement::priority)
+		.def_readwrite("numa_local", &DPsim::Scheduler::ThreadPlacement::numaLocal)
+		.def_readwrite("lock_memory", &DPsim::Scheduler::ThreadPlacement::lockMemory)
+		.def_static("parse_cpu_sets", &DPsim::Scheduler::ThreadPlacement::parseCpuSets, "list"_a);
+
+	py::class_<DPsim::PFSolver::ContingencyLimits>(m, "ContingencyLimits")
+		.def(py::init<>())
+		.def_readwrite("min_voltage", &DPsim::PFSolver::ContingencyLimits::minVoltage)
+		.def_readwrite("max_voltage", &DPsim::PFSolver::ContingencyLimits::maxVoltage)
+		.def_readwrite("branch_ratings", &DPsim::PFSolver::ContingencyLimits::branchRatings);
+
+	py::class_<DPsim::PFSolver::ContingencyResult>(m, "ContingencyResult")
+		.def_property_readonly("name", [](const DPsim::PFSolver::ContingencyResult& result) { return result.contingency.name; })
+		.def_property_readonly("status", [](const DPsim::PFSolver::ContingencyResult& result) {
+			static const char* names[] = { "converged", "not converged", "islanded" };
+			return std::string(names[static_cast<int>(result.status)]);
+		})
+		.def_readonly("iterations", &DPsim::PFSolver::ContingencyResult::iterations)
+		.def_readonly("severity", &DPsim::PFSolver::ContingencyResult::severity)
+		.def_readonly("num_violations", &DPsim::PFSolver::ContingencyResult::numViolations)
+		.def_readonly("min_voltage", &DPsim::PFSolver::ContingencyResult::minVoltage)
+		.def_readonly("min_voltage_node", &DPsim::PFSolver::ContingencyResult::minVoltageNode)
+		.def_readonly("max_voltage", &DPsim::PFSolver::ContingencyResult::maxVoltage)
+		.def_readonly("max_voltage_node", &DPsim::PFSolver::ContingencyResult::maxVoltageNode)
+		.def_readonly("max_loading", &DPsim::PFSolver::ContingencyResult::maxLoading)
+		.def_readonly("max_loading_branch", &DPsim::PFSolver::ContingencyResult::maxLoadingBranch);
+
     py::class_<DPsim::Simulation>(m, "Simulation")
 	    .def(py::init<std::string, CPS::Logger::Level>(), "name"_a, "loglevel"_a = CPS::Logger::Level::off)
 		.def("name", &DPsim::Simulation::name)
@@ -95,14 +141,47 @@ PYBIND11_MODULE(dpsimpy, m) {
 		.def("log_attribute", &DPsim::Simulation::logAttribute, "name"_a, "attr"_a)
 		.def("do_init_from_nodes_and_terminals", &DPsim::Simulation::doInitFromNodesAndTerminals)
 		.def("do_system_matrix_recomputation", &DPsim::Simulation::doSystemMatrixRecomputation)
+		.def("do_sparse_right_vector_stamping", &DPsim::Simulation::doSparseRightVectorStamping)
+		.def("do_freeze_system_matrix_pattern", &DPsim::Simulation::doFreezeSystemMatrixPattern)
+		.def("do_lazy_switch_factorization", &DPsim::Simulation::doLazySwitchFactorization)
+		.def("set_switch_factorization_cache_size", &DPsim::Simulation::setSwitchFactorizationCacheSize)
+		.def("do_switch_prefactorization", &DPsim::Simulation::doSwitchPrefactorization)
+		.def("do_low_rank_system_matrix_updates", &DPsim::Simulation::doLowRankSystemMatrixUpdates)
+		.def("set_max_low_rank_updates", &DPsim::Simulation::setMaxLowRankUpdates)
+		.def("set_number_of_scenarios", &DPsim::Simulation::setNumberOfScenarios)
+		.def("set_scenario_right_side_offsets", &DPsim::Simulation::setScenarioRightSideOffsets, "offsets"_a, "solver_idx"_a = 0)
+		.def("scenario_left_side_vectors", &DPsim::Simulation::scenarioLeftSideVectors, "solver_idx"_a = 0)
+		.def("do_vectorize_linear_elements", &DPsim::Simulation::doVectorizeLinearElements)
+		.def("do_task_fusion", &DPsim::Simulation::doTaskFusion)
+		.def("set_task_fusion_min_task_time", &DPsim::Simulation::setTaskFusionMinTaskTime)
+		.def("set_task_fusion_parallelism", &DPsim::Simulation::setTaskFusionParallelism)
+		.def("set_task_fusion_measurement_file", &DPsim::Simulation::setTaskFusionMeasurementFile)
+		.def("set_thread_placement", &DPsim::Simulation::setThreadPlacement, "placement"_a)
 		.def("do_steady_state_init", &DPsim::Simulation::doSteadyStateInit)
+		.def("set_steady_state_init_time_step", &DPsim::Simulation::setSteadStIniTimeStep)
+		.def("do_steady_state_init_acceleration", &DPsim::Simulation::doSteadStIniAcceleration)
+		.def("do_steady_state_init_logging", &DPsim::Simulation::doSteadStIniLogging)
+		.def("do_powerflow_warm_start", &DPsim::Simulation::doPowerflowWarmStart)
+		.def("do_powerflow_jacobian_reuse", &DPsim::Simulation::doPowerflowJacobianReuse)
+		.def("run_powerflow_time_series", &DPsim::Simulation::runPowerflowTimeSeries, "output_file"_a, "num_chunks"_a = 1)
+		.def("run_powerflow_contingencies", &DPsim::Simulation::runPowerflowContingencies, "report_file"_a,
+			"num_threads"_a = 1, "limits"_a = DPsim::PFSolver::ContingencyLimits())
 		.def("do_frequency_parallelization", &DPsim::Simulation::doFrequencyParallelization)
 		.def("set_tearing_components", &DPsim::Simulation::setTearingComponents)
 		.def("add_event", &DPsim::Simulation::addEvent)
 		.def("set_solver_component_behaviour", &DPsim::Simulation::setSolverAndComponentBehaviour)
 		.def("set_direct_solver_implementation", &DPsim::Simulation::setDirectLinearSolverImplementation)
 		.def("set_direct_linear_solver_configuration", &DPsim::Simulation::setDirectLinearSolverConfiguration)
-		.def("log_lu_times", &DPsim::Simulation::logLUTimes);
+		.def("log_lu_times", &DPsim::Simulation::logLUTimes)
+		.def("log_step_times", &DPsim::Simulation::logStepTimes)
+		.def("set_step_times_capacity", &DPsim::Simulation::setStepTimesCapacity)
+		.def("step_times", &DPsim::Simulation::stepTimes, "Deprecated, use step_time_statistics")
+		.def("step_time_statistics", &DPsim::Simulation::stepTimeStatistics, py::return_value_policy::reference_internal)
+		.def("solve_times", &DPsim::Simulation::solveTimes, "solver_idx"_a = 0, py::return_value_policy::reference_internal)
+		.def("recomputation_times", &DPsim::Simulation::recomputationTimes, "solver_idx"_a = 0, py::return_value_policy::reference_internal)
+		.def("low_rank_update_times", &DPsim::Simulation::lowRankUpdateTimes, "solver_idx"_a = 0, py::return_value_policy::reference_internal)
+		.def("num_vectorized_linear_elements", &DPsim::Simulation::numVectorizedLinearElements, "solver_idx"_a = 0)
+		.def("switch_factorization_statistics", &DPsim::Simulation::switchFactorizationStatistics, "solver_idx"_a = 0, py::return_value_policy::reference_internal);
 
 	py::class_<DPsim::RealTimeSimulation, DPsim::Simulation>(m, "RealTimeSimulation")
 		.def(py::init<std::string, CPS::Logger::Level>(), "name"_a, "loglevel"_a = CPS::Logger::Level::info)
@@ -137,10 +216,19 @@ PYBIND11_MODULE(dpsimpy, m) {
 		.def("list_idobjects", &DPsim::SystemTopology::listIdObjects)
 		.def("init_with_powerflow", &DPsim::SystemTopology::initWithPowerflow);
 
-	py::class_<DPsim::Interface, std::shared_ptr<DPsim::Interface>>(m, "Interface");
+	py::class_<DPsim::Interface, std::shared_ptr<DPsim::Interface>>(m, "Interface")
+		.def("set_export_pool_size", &DPsim::Interface::setExportPoolSize, "size"_a)
+		.def("export_queue_depth", &DPsim::Interface::exportQueueDepth)
+		.def("max_export_queue_depth", &DPsim::Interface::maxExportQueueDepth)
+		.def("export_pool_exhaustions", &DPsim::Interface::exportPoolExhaustions);
+
+	py::enum_<DPsim::DataLogger::Format>(m, "LogFormat")
+		.value("CSV", DPsim::DataLogger::Format::CSV)
+		.value("Binary", DPsim::DataLogger::Format::Binary);
 
 	py::class_<DPsim::DataLogger, std::shared_ptr<DPsim::DataLogger>>(m, "Logger")
         .def(py::init<std::string>())
+		.def(py::init<std::string, CPS::Bool, CPS::UInt, DPsim::DataLogger::Format>(), "name"_a, "enabled"_a = true, "downsampling"_a = 1, "format"_a = DPsim::DataLogger::Format::CSV)
 		.def_static("set_log_dir", &CPS::Logger::setLogDir)
 		.def_static("get_log_dir", &CPS::Logger::logDir)
 		.def("log_attribute", py::overload_cast<const CPS::String&, CPS::AttributeBase::Ptr, CPS::UInt, CPS::UInt>(&DPsim::DataLogger::logAttribute), "name"_a, "attr"_a, "max_cols"_a = 0, "max_rows"_a = 0)
@@ -153,7 +241,11 @@ PYBIND11_MODULE(dpsimpy, m) {
 		/// Compatibility method. Might be removed later when the python examples have been fully adapted.;
 		.def("log_attribute", [](DPsim::DataLogger &logger, const std::vector<CPS::String> &names, const CPS::String &attr, const CPS::IdentifiedObject &comp) {
 			logger.logAttribute(names, comp.attribute(attr));
-		});
+		})
+		.def("do_async_writing", &DPsim::DataLogger::doAsyncWriting, "enabled"_a, "capacity"_a = 4096)
+		.def("do_block_on_full_queue", &DPsim::DataLogger::doBlockOnFullQueue)
+		.def("dropped_rows", &DPsim::DataLogger::droppedRows)
+		.def("stalled_rows", &DPsim::DataLogger::stalledRows);
 
 	py::class_<CPS::IdentifiedObject, std::shared_ptr<CPS::IdentifiedObject>>(m, "IdentifiedObject")
 		.def("name", &CPS::IdentifiedObject::name)
@@ -205,7 +297,10 @@ PYBIND11_MODULE(dpsimpy, m) {
 	py::enum_<DPsim::Solver::Type>(m, "Solver")
 		.value("MNA", DPsim::Solver::Type::MNA)
 		.value("DAE", DPsim::Solver::Type::DAE)
-		.value("NRP", DPsim::Solver::Type::NRP);
+		.value("NRP", DPsim::Solver::Type::NRP)
+		.value("FDXB", DPsim::Solver::Type::FDXB)
+		.value("FDBX", DPsim::Solver::Type::FDBX)
+		.value("DCPF", DPsim::Solver::Type::DCPF);
 
 	py::enum_<DPsim::DirectLinearSolverImpl>(m, "DirectLinearSolverImpl")
 		.value("Undef", DPsim::DirectLinearSolverImpl::Undef)
@@ -249,7 +344,11 @@ PYBIND11_MODULE(dpsimpy, m) {
 #ifdef WITH_CIM
 	py::class_<CPS::CIM::Reader>(m, "CIMReader")
 		.def(py::init<std::string, CPS::Logger::Level, CPS::Logger::Level>(), "name"_a, "loglevel"_a = CPS::Logger::Level::info, "comploglevel"_a = CPS::Logger::Level::off)
-		.def("loadCIM", (CPS::SystemTopology (CPS::CIM::Reader::*)(CPS::Real, const std::list<CPS::String> &, CPS::Domain, CPS::PhaseType, CPS::GeneratorType)) &CPS::CIM::Reader::loadCIM);
+		.def("loadCIM", (CPS::SystemTopology (CPS::CIM::Reader::*)(CPS::Real, const std::list<CPS::String> &, CPS::Domain, CPS::PhaseType, CPS::GeneratorType)) &CPS::CIM::Reader::loadCIM)
+		.def("set_num_threads", &CPS::CIM::Reader::setNumThreads, "num_threads"_a)
+		.def("set_snapshot_directory", [](CPS::CIM::Reader &reader, const std::string &directory) {
+			reader.setSnapshotDirectory(directory);
+		}, "directory"_a);
 #endif
 
 	py::class_<CPS::CSVReader>(m, "CSVReader")
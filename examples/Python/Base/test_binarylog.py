@@ -0,0 +1,57 @@
+import numpy as np
+import pandas as pd
+
+import dpsimpy
+from dpsim import binarylog
+
+def simulate(name, log_format):
+    dpsimpy.Logger.set_log_dir('logs/' + name)
+
+    gnd = dpsimpy.dp.SimNode.gnd
+    n1 = dpsimpy.dp.SimNode('n1')
+    n2 = dpsimpy.dp.SimNode('n2')
+
+    vs = dpsimpy.dp.ph1.VoltageSource('vs')
+    vs.set_parameters(V_ref=complex(10, 0))
+    r = dpsimpy.dp.ph1.Resistor('r')
+    r.set_parameters(R=1)
+    l = dpsimpy.dp.ph1.Inductor('l')
+    l.set_parameters(L=0.02)
+
+    vs.connect([gnd, n1])
+    r.connect([n1, n2])
+    l.connect([n2, gnd])
+    system = dpsimpy.SystemTopology(50, [n1, n2], [vs, r, l])
+
+    logger = dpsimpy.Logger(name, format=log_format)
+    logger.log_attribute('v2', 'v', n2)
+    logger.log_attribute('il', 'i_intf', l)
+
+    sim = dpsimpy.Simulation(name, dpsimpy.LogLevel.off)
+    sim.set_system(system)
+    sim.set_time_step(1e-4)
+    sim.set_final_time(0.05)
+    sim.set_direct_solver_implementation(dpsimpy.DirectLinearSolverImpl.SparseLU)
+    sim.add_logger(logger)
+    sim.run()
+
+def test_binarylog():
+    simulate('BinaryLog_CSV', dpsimpy.LogFormat.CSV)
+    simulate('BinaryLog_Binary', dpsimpy.LogFormat.Binary)
+
+    csv = pd.read_csv('logs/BinaryLog_CSV/BinaryLog_CSV.csv', skipinitialspace=True, index_col=0)
+    binary = binarylog.read('logs/BinaryLog_Binary/BinaryLog_Binary.bin')
+
+    # Same columns and rows, the CSV values are rounded to six digits
+    assert list(binary.columns) == [c.strip() for c in csv.columns]
+    assert len(binary) == len(csv) > 0
+    assert np.allclose(binary.index, csv.index, rtol=1e-5, atol=0)
+    assert np.allclose(binary.values, csv.values, rtol=1e-5, atol=1e-9)
+
+    # The mapped rows are the same as the data frame
+    columns, data = binarylog.memmap('logs/BinaryLog_Binary/BinaryLog_Binary.bin')
+    assert columns[1:] == list(binary.columns)
+    assert np.array_equal(data[:, 1:], binary.values)
+
+if __name__ == '__main__':
+    test_binarylog()
@@ -1,4 +1,5 @@
 from . import matpower
+from . import binarylog
 from .matpower import Reader
 
 try:
@@ -6,4 +7,4 @@ try:
 except ImportError:  # pragma: no cover
     print('Error: Could not find dpsim C++ module.')
 
-__all__ = ['matpower']
+__all__ = ['matpower', 'binarylog']
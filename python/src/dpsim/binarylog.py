@@ -0,0 +1,46 @@
+import os
+import struct
+
+import numpy as np
+import pandas as pd
+
+MAGIC = b'DPSIMLOG'
+
+def read_header(filename):
+    """Read the column names and the data offset of a binary DPsim log"""
+    with open(filename, 'rb') as f:
+        if f.read(8) != MAGIC:
+            raise ValueError('%s is not a binary DPsim log' % filename)
+
+        version, num_columns, header_size = struct.unpack('<IIQ', f.read(16))
+        if version != 1:
+            raise ValueError('Unsupported log version %d' % version)
+
+        columns = []
+        for _ in range(num_columns):
+            length, = struct.unpack('<I', f.read(4))
+            columns.append(f.read(length).decode())
+
+    return columns, header_size
+
+def memmap(filename):
+    """Map the rows of a binary DPsim log without reading the whole file
+
+    Returns the column names and an array with one row per logged time step.
+    The first column contains the simulation time.
+    """
+    columns, header_size = read_header(filename)
+    if os.path.getsize(filename) <= header_size:
+        return columns, np.empty((0, len(columns)))
+
+    data = np.memmap(filename, dtype='<f8', mode='r', offset=header_size)
+    # Drop an incomplete last row, e.g. if the simulation has been aborted
+    rows = data.size // len(columns)
+    return columns, data[:rows * len(columns)].reshape(rows, len(columns))
+
+def read(filename):
+    """Read a binary DPsim log into a DataFrame indexed by time"""
+    columns, data = memmap(filename)
+    df = pd.DataFrame(np.array(data[:, 1:]), columns=columns[1:], index=data[:, 0])
+    df.index.name = columns[0]
+    return df